@@ -183,6 +183,20 @@ public:
   */
   void CalculateAndAppendFeatures(const Image* image, const Image* mask, const Image* maskNoNaN, FeatureListType &featureList, bool checkParameterActivation = true);
 
+  typedef std::vector<AbstractGlobalImageFeature::Pointer> FeatureClassListType;
+
+  /**
+  * \brief Calculates the features of several feature classes concurrently and appends them to featureList.
+  * The result is the same as calling CalculateAndAppendFeatures() for one feature class after the other, the features
+  * are appended in the order of featureClasses. The feature classes share one IntensityRangeCache, so the intensity
+  * range of the image (and mask) is only determined once. The instances must be different, as each instance keeps
+  * the state of its calculation. If the calculation of a feature class fails, the exception of the first failed
+  * feature class (in the order of featureClasses) is thrown after all calculations are finished.
+  * @param numberOfThreads Maximum number of feature classes that are calculated at the same time. 0: number of
+  * hardware threads.
+  */
+  static void CalculateAndAppendFeaturesConcurrently(const FeatureClassListType& featureClasses, const Image* image, const Image* mask, const Image* maskNoNaN, FeatureListType &featureList, bool checkParameterActivation = true, unsigned int numberOfThreads = 0);
+
   itkSetMacro(Prefix, std::string);
   itkSetMacro(ShortName, std::string);
   itkSetMacro(LongName, std::string);
@@ -225,6 +239,11 @@ public:
   itkSetMacro(MorphMask, mitk::Image::Pointer);
   itkGetConstMacro(MorphMask, mitk::Image::Pointer);
 
+  /** Optional cache for the intensity ranges that are needed to initialize the quantifier. It can be shared by
+  * several feature classes that are calculated for the same image and mask.*/
+  itkSetMacro(IntensityRangeCache, IntensityRangeCache::Pointer);
+  itkGetConstMacro(IntensityRangeCache, IntensityRangeCache::Pointer);
+
   itkSetMacro(Bins, int);
   itkSetMacro(UseBins, bool);
   itkGetConstMacro(UseBins, bool);
@@ -316,6 +335,7 @@ private:
   ParametersType m_Parameters; // Parameter setting
 
   mitk::Image::Pointer m_MorphMask = nullptr;
+  IntensityRangeCache::Pointer m_IntensityRangeCache;
 
 
   IntensityQuantifier::Pointer m_Quantifier;
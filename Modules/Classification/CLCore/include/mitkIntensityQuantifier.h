@@ -19,8 +19,43 @@ found in the LICENSE file.
 #include <mitkBaseData.h>
 #include <mitkImage.h>
 
+#include <future>
+#include <map>
+#include <mutex>
+#include <utility>
+
 namespace mitk
 {
+/** Caches the intensity range (minimum and maximum) of images and of masked image regions.
+* An instance can be shared by the quantifiers of several feature classes (see
+* AbstractGlobalImageFeature::SetIntensityRangeCache()), then each image / mask pair is only scanned once,
+* even if the feature classes are calculated concurrently. The cache keeps the images alive and assumes
+* that they are not modified as long as it is used.*/
+class MITKCLCORE_EXPORT IntensityRangeCache : public itk::LightObject
+{
+public:
+  mitkClassMacroItkParent(IntensityRangeCache, itk::LightObject);
+  itkFactorylessNewMacro(Self);
+
+  /** Minimum and maximum of all voxels of image.*/
+  void GetImageMinMax(const Image* image, double &minimum, double &maximum);
+  /** Minimum and maximum of the voxels of image inside of mask.*/
+  void GetImageRegionMinMax(const Image* image, const Image* mask, double &minimum, double &maximum);
+
+protected:
+  IntensityRangeCache() = default;
+
+private:
+  typedef std::pair<double, double> RangeType;
+  /** nullptr as mask for the range of the whole image.*/
+  typedef std::pair<Image::ConstPointer, Image::ConstPointer> KeyType;
+
+  RangeType GetRange(const Image* image, const Image* mask);
+
+  std::mutex m_Mutex;
+  std::map<KeyType, std::shared_future<RangeType>> m_Ranges;
+};
+
 class MITKCLCORE_EXPORT IntensityQuantifier : public BaseData
 {
 public:
@@ -46,6 +81,9 @@ public:
   void InitializeByImageRegionAndBinsizeAndMinimum(const Image* image, const Image* mask, double minimum, double binsize);
   void InitializeByImageRegionAndBinsizeAndMaximum(const Image* image, const Image* mask, double maximum, double binsize);
 
+  /** If a cache is set, the InitializeByImage... methods take the intensity ranges from it.*/
+  void SetRangeCache(IntensityRangeCache* cache) { m_RangeCache = cache; }
+
   unsigned int IntensityToIndex(double intensity);
   double IndexToMinimumIntensity(unsigned int index);
   double IndexToMeanIntensity(unsigned int index);
@@ -79,6 +117,10 @@ public:
 
 
 private:
+  void DetermineImageMinMax(const Image* image, double &minimum, double &maximum);
+  void DetermineImageRegionMinMax(const Image* image, const Image* mask, double &minimum, double &maximum);
+
+  IntensityRangeCache::Pointer m_RangeCache;
   bool m_Initialized;
   unsigned int m_Bins;
   double m_Binsize;
@@ -14,7 +14,12 @@ found in the LICENSE file.
 
 #include <mitkImageCast.h>
 #include <mitkITKImageImport.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iterator>
+#include <system_error>
+#include <thread>
 
 
 bool mitk::FeatureID::operator < (const FeatureID& rh) const
@@ -256,6 +261,7 @@ void mitk::AbstractGlobalImageFeature::ConfigureSettingsByParameters(const Param
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins)
 {
   m_Quantifier = IntensityQuantifier::New();
+  m_Quantifier->SetRangeCache(m_IntensityRangeCache);
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
     m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseBins() && GetUseBinsize())
@@ -493,6 +499,87 @@ void mitk::AbstractGlobalImageFeature::CalculateAndAppendFeatures(const Image* i
   }
 }
 
+void mitk::AbstractGlobalImageFeature::CalculateAndAppendFeaturesConcurrently(const FeatureClassListType& featureClasses, const Image* image, const Image* mask, const Image* maskNoNaN, FeatureListType& featureList, bool checkParameterActivation, unsigned int numberOfThreads)
+{
+  FeatureClassListType activeFeatureClasses;
+  for (const auto& featureClass : featureClasses)
+  {
+    if (!checkParameterActivation || featureClass->GetParameters().count(featureClass->GetLongName()))
+    {
+      activeFeatureClasses.push_back(featureClass);
+    }
+  }
+
+  auto rangeCache = IntensityRangeCache::New();
+  std::vector<IntensityRangeCache::Pointer> previousRangeCaches;
+  for (const auto& featureClass : activeFeatureClasses)
+  {
+    previousRangeCaches.push_back(featureClass->GetIntensityRangeCache());
+    featureClass->SetIntensityRangeCache(rangeCache);
+  }
+
+  // Each feature class writes only its own result, so the order of the results does not depend on the scheduling.
+  std::vector<FeatureListType> results(activeFeatureClasses.size());
+  std::vector<std::exception_ptr> errors(activeFeatureClasses.size());
+  std::atomic<std::size_t> nextFeatureClass(0);
+
+  auto calculate = [&]() {
+    for (auto i = nextFeatureClass++; i < activeFeatureClasses.size(); i = nextFeatureClass++)
+    {
+      try
+      {
+        results[i] = activeFeatureClasses[i]->CalculateFeatures(image, mask, maskNoNaN);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  if (0 == numberOfThreads)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, activeFeatureClasses.size()));
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    try
+    {
+      threads.emplace_back(calculate);
+    }
+    catch (const std::system_error&)
+    {
+      break; // the remaining feature classes are calculated by the threads that could be started
+    }
+  }
+  calculate();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t i = 0; i < activeFeatureClasses.size(); ++i)
+  {
+    activeFeatureClasses[i]->SetIntensityRangeCache(previousRangeCaches[i]);
+  }
+
+  for (const auto& error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  for (const auto& result : results)
+  {
+    featureList.insert(featureList.end(), result.begin(), result.end());
+  }
+}
+
 mitk::AbstractGlobalImageFeature::FeatureListType mitk::AbstractGlobalImageFeature::CalculateFeatures(const Image* image, const Image* mask)
 {
   auto result = this->DoCalculateFeatures(image, mask);
@@ -69,6 +69,61 @@ CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage,
   }
 }
 
+void mitk::IntensityRangeCache::GetImageMinMax(const Image* image, double &minimum, double &maximum)
+{
+  auto range = this->GetRange(image, nullptr);
+  minimum = range.first;
+  maximum = range.second;
+}
+
+void mitk::IntensityRangeCache::GetImageRegionMinMax(const Image* image, const Image* mask, double &minimum, double &maximum)
+{
+  auto range = this->GetRange(image, mask);
+  minimum = range.first;
+  maximum = range.second;
+}
+
+mitk::IntensityRangeCache::RangeType mitk::IntensityRangeCache::GetRange(const Image* image, const Image* mask)
+{
+  std::promise<RangeType> promise;
+  std::shared_future<RangeType> range;
+  bool calculate = false;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto& cachedRange = m_Ranges[std::make_pair(Image::ConstPointer(image), Image::ConstPointer(mask))];
+    if (!cachedRange.valid())
+    {
+      cachedRange = promise.get_future().share();
+      calculate = true;
+    }
+    range = cachedRange;
+  }
+
+  // Only the first caller scans the image, concurrent callers for the same image / mask wait for its result.
+  if (calculate)
+  {
+    try
+    {
+      RangeType result;
+      if (nullptr == mask)
+      {
+        AccessByItk_2(image, CalculateImageMinMax, result.first, result.second);
+      }
+      else
+      {
+        AccessByItk_3(image, CalculateImageRegionMinMax, mask, result.first, result.second);
+      }
+      promise.set_value(result);
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  }
+
+  return range.get();
+}
+
 mitk::IntensityQuantifier::IntensityQuantifier() :
       m_Initialized(false),
       m_Bins(0),
@@ -103,76 +158,100 @@ void mitk::IntensityQuantifier::InitializeByBinsizeAndMaximum(double minimum, do
 
 void mitk::IntensityQuantifier::InitializeByImage(const Image* image, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  this->DetermineImageMinMax(image, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMinimum(const Image* image, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  this->DetermineImageMinMax(image, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMaximum(const Image* image, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  this->DetermineImageMinMax(image, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegion(const Image* image, const Image* mask, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  this->DetermineImageRegionMinMax(image, mask, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMinimum(const Image* image, const Image* mask, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  this->DetermineImageRegionMinMax(image, mask, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMaximum(const Image* image, const Image* mask, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  this->DetermineImageRegionMinMax(image, mask, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsize(const Image* image, double binsize) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  this->DetermineImageMinMax(image, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMinimum(const Image* image, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  this->DetermineImageMinMax(image, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMaximum(const Image* image, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  this->DetermineImageMinMax(image, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsize(const Image* image, const Image* mask, double binsize) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  this->DetermineImageRegionMinMax(image, mask, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMinimum(const Image* image, const Image* mask, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  this->DetermineImageRegionMinMax(image, mask, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMaximum(const Image* image, const Image* mask, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  this->DetermineImageRegionMinMax(image, mask, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
+void mitk::IntensityQuantifier::DetermineImageMinMax(const Image* image, double &minimum, double &maximum)
+{
+  if (m_RangeCache.IsNotNull())
+  {
+    m_RangeCache->GetImageMinMax(image, minimum, maximum);
+  }
+  else
+  {
+    AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  }
+}
+
+void mitk::IntensityQuantifier::DetermineImageRegionMinMax(const Image* image, const Image* mask, double &minimum, double &maximum)
+{
+  if (m_RangeCache.IsNotNull())
+  {
+    m_RangeCache->GetImageRegionMinMax(image, mask, minimum, maximum);
+  }
+  else
+  {
+    AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  }
+}
+
 unsigned int mitk::IntensityQuantifier::IntensityToIndex(double intensity)
 {
   double index = std::floor((intensity - m_Minimum) / m_Binsize);
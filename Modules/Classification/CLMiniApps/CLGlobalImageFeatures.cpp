@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define mitkCLPolyToNrrd_cpp
 
 #include "time.h"
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 
@@ -47,8 +48,12 @@ found in the LICENSE file.
 #include <mitkCLResultXMLWriter.h>
 #include <mitkVersion.h>
 
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <locale>
+#include <system_error>
+#include <thread>
 
 #include <itkImageDuplicator.h>
 #include <itkImageRegionIterator.h>
@@ -359,7 +364,9 @@ void SaveSliceOrImageAsPNG(mitk::Image::Pointer image, mitk::Image::Pointer mask
   }
 }
 
-int main(int argc, char* argv[])
+/** Creates one instance of each feature class. Instances keep state while they calculate, so each image or slice
+    that is processed concurrently gets instances of its own.*/
+static mitk::AbstractGlobalImageFeature::FeatureClassListType CreateFeatureClasses()
 {
   // Commented : Updated to a common interface, include, if possible, mask is type unsigned short, uses Quantification, Comments
   //                                 Name follows standard scheme with Class Name::Feature Name
@@ -399,6 +406,40 @@ int main(int argc, char* argv[])
   features.push_back(ipCalculator.GetPointer());
   features.push_back(ngtdCalculator.GetPointer());
 
+  return features;
+}
+
+static void ConfigureFeatureClasses(const mitk::AbstractGlobalImageFeature::FeatureClassListType &features,
+                                    const mitk::cl::GlobalImageFeaturesParameter &param,
+                                    const std::map<std::string, us::Any> &parsedArgs,
+                                    int direction)
+{
+  for (auto cFeature : features)
+  {
+    if (param.defineGlobalMinimumIntensity)
+    {
+      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
+      cFeature->SetUseMinimumIntensity(true);
+    }
+    if (param.defineGlobalMaximumIntensity)
+    {
+      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
+      cFeature->SetUseMaximumIntensity(true);
+    }
+    if (param.defineGlobalNumberOfBins)
+    {
+      cFeature->SetBins(param.globalNumberOfBins);
+    }
+    cFeature->SetParameters(parsedArgs);
+    cFeature->SetDirection(direction);
+    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<mitk::AbstractGlobalImageFeature::Pointer> features = CreateFeatureClasses();
+
   mitkCommandLineParser parser;
   parser.setArgumentPrefix("--", "-");
   mitk::cl::GlobalImageFeaturesParameter param;
@@ -416,6 +457,7 @@ int main(int argc, char* argv[])
   parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
   parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
     " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
+  parser.addArgument("threads", "threads", mitkCommandLineParser::Int, "Int", "Maximum number of slices (slice-wise) or feature classes that are calculated concurrently. 0: (Default) number of hardware threads; 1: one after the other.", us::Any());
 
   // Miniapp Infos
   parser.setCategory("Classification Tools");
@@ -499,6 +541,12 @@ int main(int argc, char* argv[])
     writeDirection = us::any_cast<int>(parsedArgs["output-mode"]);
   }
 
+  unsigned int numberOfThreads = 0;
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = std::max(0, us::any_cast<int>(parsedArgs["threads"]));
+  }
+
   log << " Check for Resolution -";
   if (param.resampleToFixIsotropic)
   {
@@ -564,7 +612,6 @@ int main(int argc, char* argv[])
   bool sliceWise = false;
   int sliceDirection = 0;
   unsigned int currentSlice = 0;
-  bool imageToProcess = true;
 
   std::vector<mitk::Image::Pointer> floatVector;
   std::vector<mitk::Image::Pointer> maskVector;
@@ -580,29 +627,20 @@ int main(int argc, char* argv[])
     ExtractSlicesFromImages(image, mask, maskNoNaN, morphMask, sliceDirection, floatVector, maskVector, maskNoNaNVector, morphMaskVector);
     MITK_INFO << "Slice";
   }
+  else
+  {
+    floatVector.push_back(image);
+    maskVector.push_back(mask);
+    maskNoNaNVector.push_back(maskNoNaN);
+    morphMaskVector.push_back(morphMask);
+  }
 
   log << " Configure features -";
-  for (auto cFeature : features)
+  if (param.defineGlobalNumberOfBins)
   {
-    if (param.defineGlobalMinimumIntensity)
-    {
-      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
-      cFeature->SetUseMinimumIntensity(true);
-    }
-    if (param.defineGlobalMaximumIntensity)
-    {
-      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
-      cFeature->SetUseMaximumIntensity(true);
-    }
-    if (param.defineGlobalNumberOfBins)
-    {
-      cFeature->SetBins(param.globalNumberOfBins);
-      MITK_INFO << param.globalNumberOfBins;
-    }
-    cFeature->SetParameters(parsedArgs);
-    cFeature->SetDirection(direction);
-    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
+    MITK_INFO << param.globalNumberOfBins;
   }
+  ConfigureFeatureClasses(features, param, parsedArgs, direction);
 
   bool addDescription = parsedArgs.count("description");
   mitk::cl::FeatureResultWriter writer(param.outputPath, writeDirection);
@@ -618,11 +656,6 @@ int main(int argc, char* argv[])
     description = parsedArgs["description"].ToString();
   }
 
-  mitk::Image::Pointer cImage = image;
-  mitk::Image::Pointer cMask = mask;
-  mitk::Image::Pointer cMaskNoNaN = maskNoNaN;
-  mitk::Image::Pointer cMorphMask = morphMask;
-
   if (param.useHeader)
   {
     writer.AddColumn("SoftwareVersion");
@@ -637,44 +670,94 @@ int main(int argc, char* argv[])
   QApplication qtapplication(argc, argv);
   QmitkRegisterClasses();
 
-  std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats;
+  const std::size_t numberOfImages = floatVector.size();
 
-  log << " Begin Processing -";
-  while (imageToProcess)
+  // Rendering and saving of the images or slices stays in this thread
+  for (std::size_t i = 0; i < numberOfImages; ++i)
   {
-    if (sliceWise)
+    if (param.writePNGScreenshots)
     {
-      cImage = floatVector[currentSlice];
-      cMask = maskVector[currentSlice];
-      cMaskNoNaN = maskNoNaNVector[currentSlice];
-      cMorphMask = morphMaskVector[currentSlice];
-      imageToProcess = (floatVector.size()-1 > (currentSlice)) ? true : false ;
+      SaveSliceOrImageAsPNG(floatVector[i], maskVector[i], param.pngScreenshotsPath, static_cast<int>(i));
     }
-    else
+    if (param.writeAnalysisImage)
     {
-      imageToProcess = false;
+      mitk::IOUtil::Save(floatVector[i], param.anaylsisImagePath);
     }
+    if (param.writeAnalysisMask)
+    {
+      mitk::IOUtil::Save(maskVector[i], param.analysisMaskPath);
+    }
+  }
 
-    if (param.writePNGScreenshots)
+  log << " Begin Processing -";
+
+  // Slices are calculated concurrently, each with feature class instances of its own and with its feature classes
+  // one after the other. The feature classes of a single image are calculated concurrently instead.
+  std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats(numberOfImages);
+  std::vector<std::exception_ptr> errors(numberOfImages);
+  std::atomic<std::size_t> nextImage(0);
+  const unsigned int numberOfThreadsPerImage = numberOfImages > 1 ? 1 : numberOfThreads;
+
+  auto calculateImages = [&]() {
+    for (auto i = nextImage++; i < numberOfImages; i = nextImage++)
     {
-      SaveSliceOrImageAsPNG(cImage, cMask, param.pngScreenshotsPath, currentSlice);
+      try
+      {
+        auto imageFeatures = (1 == numberOfImages) ? features : CreateFeatureClasses();
+        ConfigureFeatureClasses(imageFeatures, param, parsedArgs, direction);
+        for (auto cFeature : imageFeatures)
+        {
+          cFeature->SetMorphMask(morphMaskVector[i]);
+        }
+        mitk::AbstractGlobalImageFeature::CalculateAndAppendFeaturesConcurrently(imageFeatures, floatVector[i], maskVector[i], maskNoNaNVector[i], allStats[i], !param.calculateAllFeatures, numberOfThreadsPerImage);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
     }
-    if (param.writeAnalysisImage)
+  };
+
+  unsigned int numberOfImageThreads = (numberOfImages > 1) ? numberOfThreads : 1;
+  if (0 == numberOfImageThreads)
+  {
+    numberOfImageThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numberOfImageThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfImageThreads, numberOfImages));
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfImageThreads; ++i)
+  {
+    try
     {
-      mitk::IOUtil::Save(cImage, param.anaylsisImagePath);
+      threads.emplace_back(calculateImages);
     }
-    if (param.writeAnalysisMask)
+    catch (const std::system_error&)
     {
-      mitk::IOUtil::Save(cMask, param.analysisMaskPath);
+      break; // the remaining slices are calculated by the threads that could be started
     }
+  }
+  calculateImages();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
 
-    mitk::AbstractGlobalImageFeature::FeatureListType stats;
+  // The results are written in the order of the slices
+  for (; currentSlice < numberOfImages; ++currentSlice)
+  {
+    if (errors[currentSlice])
+    {
+      std::rethrow_exception(errors[currentSlice]);
+    }
 
+    const auto &stats = allStats[currentSlice];
     for (auto cFeature : features)
     {
-      log << " Calculating " << cFeature->GetFeatureClassName() << " -";
-      cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateAndAppendFeatures(cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures);
+      if (param.calculateAllFeatures || cFeature->GetParameters().count(cFeature->GetLongName()))
+      {
+        log << " Calculated " << cFeature->GetFeatureClassName() << " -";
+      }
     }
 
     for (std::size_t i = 0; i < stats.size(); ++i)
@@ -691,9 +774,6 @@ int main(int argc, char* argv[])
       writer.AddSubjectInformation(param.maskName);
     }
     writer.AddResult(description, currentSlice, stats, param.useHeader, addDescription);
-
-    allStats.push_back(stats);
-    ++currentSlice;
   }
 
   log << " Process Slicewise -";
@@ -1,5 +1,6 @@
 set(MODULE_TESTS
   mitkGIFCooc2Test.cpp
+  mitkGIFConcurrentCalculationTest.cpp
   mitkGIFCurvatureStatisticTest.cpp
   mitkGIFFirstOrderHistogramStatisticsTest.cpp
   mitkGIFFirstOrderNumericStatisticsTest.cpp
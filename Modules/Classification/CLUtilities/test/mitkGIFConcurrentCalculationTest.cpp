@@ -0,0 +1,108 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+#include <algorithm>
+#include <cmath>
+
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFFirstOrderHistogramStatistics.h>
+#include <mitkGIFFirstOrderNumericStatistics.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+#include <mitkGIFVolumetricStatistics.h>
+
+class mitkGIFConcurrentCalculationTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGIFConcurrentCalculationTestSuite);
+
+  MITK_TEST(ConcurrentEqualsSequential_PhantomTest);
+  MITK_TEST(ParameterActivation_PhantomTest);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+  static mitk::AbstractGlobalImageFeature::FeatureClassListType CreateFeatureClasses()
+  {
+    mitk::AbstractGlobalImageFeature::FeatureClassListType featureClasses;
+    featureClasses.push_back(mitk::GIFVolumetricStatistics::New().GetPointer());
+    featureClasses.push_back(mitk::GIFFirstOrderNumericStatistics::New().GetPointer());
+    featureClasses.push_back(mitk::GIFFirstOrderHistogramStatistics::New().GetPointer());
+    featureClasses.push_back(mitk::GIFCooccurenceMatrix2::New().GetPointer());
+    featureClasses.push_back(mitk::GIFGreyLevelSizeZone::New().GetPointer());
+    return featureClasses;
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void ConcurrentEqualsSequential_PhantomTest()
+  {
+    mitk::AbstractGlobalImageFeature::FeatureListType sequentialFeatures;
+    for (const auto& featureClass : CreateFeatureClasses())
+    {
+      featureClass->CalculateAndAppendFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, sequentialFeatures, false);
+    }
+
+    mitk::AbstractGlobalImageFeature::FeatureListType concurrentFeatures;
+    mitk::AbstractGlobalImageFeature::CalculateAndAppendFeaturesConcurrently(CreateFeatureClasses(), m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, concurrentFeatures, false, 4);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Concurrent calculation should calculate the same number of features.", sequentialFeatures.size(), concurrentFeatures.size());
+
+    for (std::size_t i = 0; i < sequentialFeatures.size(); ++i)
+    {
+      const auto& expected = sequentialFeatures[i];
+      const auto& actual = concurrentFeatures[i];
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Features should be in the same order.", expected.first.legacyName, actual.first.legacyName);
+      if (std::isnan(expected.second))
+      {
+        CPPUNIT_ASSERT_MESSAGE(expected.first.legacyName + " should be NaN.", std::isnan(actual.second));
+      }
+      else
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(expected.first.legacyName, expected.second, actual.second, 1e-9 * std::max(1.0, std::abs(expected.second)));
+      }
+    }
+  }
+
+  void ParameterActivation_PhantomTest()
+  {
+    auto featureClasses = CreateFeatureClasses();
+    mitk::AbstractGlobalImageFeature::ParametersType parameters;
+    parameters[featureClasses[1]->GetLongName()] = us::Any(true);
+    for (const auto& featureClass : featureClasses)
+    {
+      featureClass->SetParameters(parameters);
+    }
+
+    mitk::AbstractGlobalImageFeature::FeatureListType expectedFeatures;
+    featureClasses[1]->CalculateAndAppendFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, expectedFeatures, false);
+
+    mitk::AbstractGlobalImageFeature::FeatureListType features;
+    mitk::AbstractGlobalImageFeature::CalculateAndAppendFeaturesConcurrently(featureClasses, m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, features);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Only the activated feature class should be calculated.", expectedFeatures.size(), features.size());
+    CPPUNIT_ASSERT_MESSAGE("The previous intensity range cache should be restored.", featureClasses[1]->GetIntensityRangeCache().IsNull());
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGIFConcurrentCalculation )
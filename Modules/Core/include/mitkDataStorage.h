@@ -19,8 +19,11 @@ found in the LICENSE file.
 #include "mitkGeometry3D.h"
 #include "mitkMessage.h"
 #include <MitkCoreExports.h>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace mitk
 {
@@ -98,7 +101,8 @@ namespace mitk
     //## (see definition of NodePredicateBase for details).
     //## The method returns a set of SmartPointers to the DataNodes that fulfill the
     //## conditions. A set of all objects can be retrieved with the GetAll() method;
-    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
+    //## Subclasses may answer some predicates from indices instead of checking every node.
+    virtual SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
 
     //##Documentation
     //## @brief returns a set of source objects for a given node that meet the given condition(s).
@@ -269,6 +273,8 @@ namespace mitk
     //## @brief Compute the axis-parallel bounding geometry of the input objects
     //##
     //## Throws std::invalid_argument exception if input is nullptr
+    //## The bounds of unchanged nodes of the DataStorage are taken from a cache, only the visibility
+    //## conditions are checked for each node on every call.
     //## @param input set of objects of the DataStorage to be included in the bounding geometry
     //## @param boolPropertyKey if a BoolProperty with this boolPropertyKey exists for a node (for @a renderer)
     //## and is set to @a false, the node is ignored for the bounding-box calculation.
@@ -392,6 +398,13 @@ namespace mitk
     //## If the cast succeeds the ChangedNodeEvent is emitted with this node.
     void OnNodeModifiedOrDeleted(const itk::Object *caller, const itk::EventObject &event);
 
+    //##Documentation
+    //## @brief  Called for each modified event of a node in the DataStorage.
+    //##
+    //## In contrast to the ChangedNodeEvent it is not suppressed by BlockNodeModifiedEvents(),
+    //## so subclasses can use it to keep internal data (e.g. indices) up to date.
+    virtual void OnNodeChanged(const DataNode *node);
+
     //##Documentation
     //## @brief  Adds a Modified-Listener to the given Node.
     void AddListeners(const DataNode *_Node);
@@ -418,6 +431,65 @@ namespace mitk
     DataStorage();
     ~DataStorage() override;
 
+    //##Documentation
+    //## @brief What a node contributes to the bounding geometry (ComputeBoundingGeometry3D(), ComputeBoundingBox())
+    struct BoundingGeometryContribution
+    {
+      BoundingGeometryContribution() : IsEmpty(true), MaximalTime(0)
+      {
+        MinSpacing.Fill(itk::NumericTraits<ScalarType>::max());
+      }
+
+      //## @brief true if the data is empty or has a zero bounding box
+      bool IsEmpty;
+      std::vector<Point3D> CornerPoints;
+      Vector3D MinSpacing;
+      std::vector<ScalarType> TimePoints;
+      ScalarType MaximalTime;
+    };
+
+    //##Documentation
+    //## @brief A cached BoundingGeometryContribution of a node
+    //##
+    //## The modified events of the data, its time geometry, the geometries of the time steps and their
+    //## transforms invalidate the entry, so checking an unchanged node does not depend on its number of time steps.
+    struct BoundingGeometryCacheEntry
+    {
+      BoundingGeometryCacheEntry() = default;
+      BoundingGeometryCacheEntry(const BoundingGeometryCacheEntry &) = delete;
+      BoundingGeometryCacheEntry &operator=(const BoundingGeometryCacheEntry &) = delete;
+      ~BoundingGeometryCacheEntry();
+
+      //## @brief Caches contribution, which was computed from data, and observes data and its geometries
+      void Set(const BaseData *data, std::shared_ptr<const BoundingGeometryContribution> contribution);
+
+      //## @brief true if the cached contribution was computed from data and nothing was modified since
+      bool IsValidFor(const BaseData *data) const;
+
+      //## @brief Removes the observers and the cached contribution
+      void Clear();
+
+      const BaseData *Data = nullptr;
+      const TimeGeometry *Geometry = nullptr;
+      TimeStepType TimeSteps = 0;
+      std::shared_ptr<const BoundingGeometryContribution> Contribution;
+      std::shared_ptr<std::atomic<bool>> Valid;
+      //## @brief the observed objects (kept alive, so the tags stay valid) and the observer tags
+      std::vector<std::pair<itk::Object::Pointer, unsigned long>> Observers;
+    };
+
+    //##Documentation
+    //## @brief Returns the contribution of node to the bounding geometry, independent of its visibility
+    //##
+    //## The contribution of nodes in the DataStorage is cached until the data of the node is replaced, or the data,
+    //## its time geometry, one of the geometries of the time steps or their transforms is modified. Replacing the
+    //## geometry of a time step (TimeGeometry::SetTimeStepGeometry()) sends no modified event, it must be followed
+    //## by Modified() of the data. Data with a source is not cached.
+    std::shared_ptr<const BoundingGeometryContribution> GetBoundingGeometryContribution(const DataNode *node) const;
+
+    mutable std::map<const DataNode *, BoundingGeometryCacheEntry> m_BoundingGeometryCache;
+    mutable std::mutex m_BoundingGeometryCacheMutex;
+
     //##Documentation
     //## @brief Filters a SetOfObjects by the condition. If no condition is provided, the original set is returned
     SetOfObjects::ConstPointer FilterSetOfObjects(const SetOfObjects *set, const NodePredicateBase *condition) const;
@@ -162,6 +162,30 @@ namespace mitk
       this->m_InterpolationMode = interpolation;
     }
 
+    enum SlabMode
+    {
+      SLAB_MIN = VTK_IMAGE_SLAB_MIN,
+      SLAB_MAX = VTK_IMAGE_SLAB_MAX,
+      SLAB_MEAN = VTK_IMAGE_SLAB_MEAN,
+      SLAB_SUM = VTK_IMAGE_SLAB_SUM
+    };
+
+    /** \brief Projects a slab around the plane onto each output slice while reslicing.
+    * The slab consists of numberOfSlices samples along the plane normal that are
+    * centered on the plane and spaced by the z spacing (see SetOutputSpacingZDirection()).
+    * The samples are combined by the slab mode directly, so no intermediate volume
+    * of the slab is created (in contrast to a 3D output and vtkMitkThickSlicesFilter).
+    * A number of 1 (default) disables the slab projection.
+    * Only applied if the filter created its reslicer, a reslicer passed to New() is
+    * used with its own slab settings.
+    * \note SLAB_MEAN rounds integral results, vtkMitkThickSlicesFilter truncates them.
+    */
+    void SetSlab(ExtractSliceFilter::SlabMode mode, int numberOfSlices)
+    {
+      this->m_SlabMode = mode;
+      this->m_SlabNumberOfSlices = numberOfSlices < 1 ? 1 : numberOfSlices;
+    }
+
   protected:
     ExtractSliceFilter(vtkImageReslice *reslicer = nullptr);
     ~ExtractSliceFilter() override;
@@ -185,6 +209,13 @@ namespace mitk
 
     ResliceInterpolation m_InterpolationMode;
 
+    SlabMode m_SlabMode;
+
+    int m_SlabNumberOfSlices;
+
+    /** False if the reslicer was passed to the constructor.*/
+    bool m_OwnsReslicer;
+
     bool m_InPlaneResampleExtentByGeometry; // Resampling grid corresponds to:  false->image    true->worldgeometry
 
     mitk::ScalarType *m_OutPutSpacing;
@@ -32,6 +32,11 @@ namespace mitk
    * faster by several orders of magnitude as long as the input image was
    * neither changed nor modified.
    *
+   * The output image is resampled multi-threaded. Its rows are split into
+   * regions that are processed by individual work units (see
+   * itk::ProcessObject::SetNumberOfWorkUnits). The result does not depend on
+   * the number of work units.
+   *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
    * an mitk::Image with valid geometry. Generally it is not as fast as
@@ -67,9 +72,8 @@ namespace mitk
     ~ExtractSliceFilter2() override;
 
     void AllocateOutputs() override;
-    // void BeforeThreadedGenerateData() override;
-    // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
-    void GenerateData() override;
+    void BeforeThreadedGenerateData() override;
+    void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
     void VerifyInputInformation() const override;
 
     struct Impl;
@@ -48,6 +48,8 @@ namespace mitk
     static std::string SIZE_Y();
     static std::string SIZE_Z();
     static std::string SIZE_T();
+
+    static std::string MEMORY_MAPPED();
   };
 }
 
@@ -28,6 +28,9 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <condition_variable>
+#include <memory>
+
 class vtkImageData;
 
 namespace itk
@@ -42,6 +45,7 @@ namespace mitk
   class ImageTimeSelector;
 
   class ImageStatisticsHolder;
+  class MemoryMappedFile;
 
   /**
     * @brief Image class for storing images
@@ -229,6 +233,20 @@ namespace mitk
                                   int n = 0,
                                   ImportMemoryManagementType importMemoryManagement = CopyMemory);
 
+    /**
+      * @brief Use the memory mapped @a file as data of channel @a n.
+      *
+      * The image references the mapping instead of copying it, so the pixel data is read from
+      * the file page by page when it is accessed (e.g. by an ImageReadAccessor of a single
+      * slice) and the memory of pages that were only read can be reclaimed by the operating
+      * system. Writing to the image modifies private copies of the touched pages, never the file.
+      * The mapping is kept alive as long as any part of the channel data is referenced.
+      * Volumes and slices of the channel that were set before are discarded.
+      * \throw mitk::Exception if the mapping is smaller than the channel.
+      * @sa MemoryMappedFile
+      */
+    virtual bool SetMappedChannel(std::shared_ptr<const MemoryMappedFile> file, int n = 0);
+
     /**
       * initialize new (or re-initialize) image information
       * @warning Initialize() by pic assumes a plane, evenly spaced geometry starting at (0,0,0).
@@ -518,6 +536,17 @@ namespace mitk
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
 
+    /**
+      \brief Returns how often image accessors of this image had to lock the image or wait for each other.
+
+      Concurrent read accessors do not lock the image as long as no write accessor is active (see
+      ImageAccessorSharedReadSlot). The counters tell how often this fast path could not be taken.
+      */
+    ImageAccessorContention GetAccessorContention() const;
+
+    /** \brief Sets all counters of GetAccessorContention() to zero. */
+    void ResetAccessorContention() const;
+
   protected:
     mitkCloneMacro(Self);
 
@@ -611,6 +640,18 @@ namespace mitk
 
     /** A mutex, which needs to be locked to manage m_Readers and m_Writers */
     mutable std::mutex m_ReadWriteLock;
+
+    static constexpr unsigned int NUMBER_OF_SHARED_READ_SLOTS = 16;
+    /** Read accessors that are registered without locking m_ReadWriteLock */
+    std::unique_ptr<ImageAccessorSharedReadSlot[]> m_SharedReadSlots;
+    /** Number of active and waiting ImageWriteAccessors. Read accessors only use m_SharedReadSlots if there are none. */
+    mutable std::atomic<unsigned int> m_PendingWriterCount{0};
+    /** Notified (with m_ReadWriteLock) if a shared read slot is released while a write accessor is pending */
+    mutable std::condition_variable m_SharedReadReleased;
+
+    mutable std::atomic<std::uint64_t> m_LockedReadCount{0};
+    mutable std::atomic<std::uint64_t> m_SharedReadSlotsExhaustedCount{0};
+    mutable std::atomic<std::uint64_t> m_AccessorWaitCount{0};
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
   };
@@ -19,7 +19,10 @@ found in the LICENSE file.
 
 #include "mitkImageDataItem.h"
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <thread>
 
 namespace mitk
 {
@@ -40,6 +43,44 @@ namespace mitk
     std::mutex m_Mutex;
   };
 
+  /** \brief Registers a read accessor at its image without locking the image.
+    *
+    * Each image holds a fixed number of these slots. While no write accessor is active or pending, read accessors
+    * claim a free slot with an atomic operation instead of locking the image and adding themselves to the list of
+    * readers. Write accessors check the occupied slots for overlaps in addition to the lists.
+    *
+    * m_State holds a generation count in the upper bits and the flags SlotClaimed and SlotOccupied. The generation
+    * changes with every claim, so a write accessor can tell whether the region it read belongs to the reader it saw.
+    */
+  struct alignas(64) ImageAccessorSharedReadSlot
+  {
+    enum StateFlags : std::uint64_t
+    {
+      /** A reader is writing its region to the slot. */
+      SlotClaimed = 1,
+      /** The region of the slot belongs to an active reader. */
+      SlotOccupied = 2,
+      GenerationIncrement = 4
+    };
+
+    std::atomic<std::uint64_t> m_State{0};
+    std::atomic<const void *> m_AddressBegin{nullptr};
+    std::atomic<const void *> m_AddressEnd{nullptr};
+    std::atomic<std::thread::id> m_Thread{std::thread::id()};
+  };
+
+  /** \brief Counters of the accessor synchronization of an image, for profiling (see Image::GetAccessorContention()).
+    */
+  struct ImageAccessorContention
+  {
+    /** Read accessors that locked the image, because a write accessor was active or pending or no slot was free. */
+    std::uint64_t LockedReads = 0;
+    /** Read accessors that locked the image, because all shared read slots were in use. */
+    std::uint64_t SharedReadSlotsExhausted = 0;
+    /** Accessors that had to wait for the release of an overlapping accessor. */
+    std::uint64_t Waits = 0;
+  };
+
 // Defs to assure dead lock prevention only in case of possible thread handling.
 #if defined(ITK_USE_SPROC) || defined(ITK_USE_PTHREADS) || defined(ITK_USE_WIN32_THREADS)
 #define MITK_USE_RECURSIVE_MUTEX_PREVENTION
@@ -133,6 +174,11 @@ namespace mitk
       */
     bool Overlap(const ImageAccessorBase *iAB);
 
+    /** \brief Computes if the image part of this instantiation overlaps the memory area [begin, end).
+      * \throws mitk::Exception if memory area is incoherent (not supported yet)
+      */
+    bool Overlap(const void *begin, const void *end);
+
     /** \brief Uses the WaitLock to wait for another ImageAccessor*/
     void WaitForReleaseOf(ImageAccessorWaitLock *wL);
 
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include "mitkImageDescriptor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
@@ -26,6 +28,7 @@ namespace mitk
   class ImageVtkWriteAccessor;
 
   class Image;
+  class MemoryMappedFile;
 
   //##Documentation
   //## @brief Internal class for managing references on sub-images
@@ -103,6 +106,9 @@ namespace mitk
     }
 
     ImageDataItem::ConstPointer GetParent() const { return m_Parent; }
+
+    /** Returns the file mapping that backs the data of this item (or of its parent), nullptr if the data lives in memory.*/
+    std::shared_ptr<const MemoryMappedFile> GetMappedFile() const;
     /**
      * @brief GetVtkImageAccessor Returns a vtkImageDataItem, if none is present, a new one is constructed by the
      * ConstructVtkImageData method.
@@ -150,6 +156,9 @@ namespace mitk
 
     ImageDataItem::ConstPointer m_Parent;
 
+    /** Keeps the mapping alive as long as the data is referenced by this item or a clone of it.*/
+    std::shared_ptr<const MemoryMappedFile> m_MappedFile;
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
@@ -63,10 +63,22 @@ namespace mitk
     /** \brief manages a consistent read access and locks the ordered image part */
     void OrganizeReadAccess();
 
+    /** \brief Registers the read access in a shared read slot of the image without locking the image.
+      * Fails if a write accessor is active or pending or if all slots are in use. */
+    bool TryOrganizeSharedReadAccess();
+
+    /** \brief Registers the read access in the list of readers of the image, waits for overlapping writers */
+    void OrganizeLockedReadAccess();
+
+    void ReleaseSharedReadSlot();
+
     ImageReadAccessor &operator=(const ImageReadAccessor &); // Not implemented on purpose.
     ImageReadAccessor(const ImageReadAccessor &);
 
     ImageConstPointer m_Image;
+
+    /** The slot this accessor is registered in, nullptr if it is registered in the list of readers */
+    ImageAccessorSharedReadSlot *m_SharedReadSlot;
   };
 }
 
@@ -0,0 +1,209 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageSliceCache_h
+#define mitkImageSliceCache_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkObject.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Bounded LRU cache of resliced 2D image slices.
+   *
+   * All ImageVtkMapper2D instances share the process-wide cache returned by GetInstance(),
+   * so the memory of the cached slices of all nodes and render windows is bounded by one
+   * capacity and one background thread prefetches for all of them.
+   * Slices are identified by a Key that contains everything the result of
+   * ExtractSliceFilter depends on: the image and its MTime, the time step and its
+   * geometry, the plane, the reference geometry the plane is clipped with and the
+   * reslice settings. Changing any of these (e.g. calling Image::Modified() after
+   * writing pixels) yields a new key, outdated slices of an image are dropped as soon
+   * as a slice of a newer state of the same image is inserted.
+   *
+   * Prefetch() reslices a list of planes on a background thread and inserts the
+   * results into the cache. The requests of different requesters (e.g. the local
+   * storages of the mappers) are processed one after the other. Only the most recent
+   * request of a requester is processed, its older requests that have not been
+   * started yet are discarded.
+   *
+   * All methods are thread-safe.
+   */
+  class MITKCORE_EXPORT ImageSliceCache : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImageSliceCache, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Identifies a resliced slice. */
+    struct MITKCORE_EXPORT Key
+    {
+      const Image *SourceImage = nullptr;
+      itk::ModifiedTimeType ImageMTime = 0;
+      itk::ModifiedTimeType TimeGeometryMTime = 0;
+      TimeStepType TimeStep = 0;
+      const BaseGeometry *ReferenceGeometry = nullptr;
+      itk::ModifiedTimeType ReferenceGeometryMTime = 0;
+      Point3D Origin;
+      Vector3D Axis0;
+      Vector3D Axis1;
+      ScalarType Extent0 = 0.0;
+      ScalarType Extent1 = 0.0;
+      int InterpolationMode = ExtractSliceFilter::RESLICE_NEAREST;
+      bool InPlaneResampleExtentByGeometry = false;
+
+      Key() = default;
+      Key(const Image *image,
+          TimeStepType timeStep,
+          const PlaneGeometry *plane,
+          int interpolationMode,
+          bool inPlaneResampleExtentByGeometry);
+
+      /** Equal in everything but the position of the plane origin.*/
+      bool MatchesExceptOrigin(const Key &other) const;
+      bool operator==(const Key &other) const;
+    };
+
+    /** \brief A resliced slice together with the information needed to place it in the scene. */
+    struct Slice
+    {
+      vtkSmartPointer<vtkImageData> ReslicedImage;
+      vtkSmartPointer<vtkMatrix4x4> ResliceAxes;
+      ScalarType Spacing[2] = { 1.0, 1.0 };
+    };
+
+    using SlicePointer = std::shared_ptr<const Slice>;
+
+    /** \brief The cache shared by all mappers. It is never destroyed, its background thread is
+     * stopped when the Core module is unloaded.*/
+    static ImageSliceCache *GetInstance();
+
+    /** \brief Copies the last 2D result of the passed reslicer.
+     * @pre SetVtkOutputRequest(true) was set and the reslicer was updated.*/
+    static SlicePointer CreateSlice(ExtractSliceFilter *reslicer);
+
+    /** Returns the cached slice or nullptr. A found slice becomes the most recently used one.*/
+    SlicePointer Find(const Key &key);
+
+    /** Adds a slice and evicts the least recently used slices that exceed the capacity.
+     * Slices of an image state older than the newest one inserted so far are ignored.*/
+    void Insert(const Key &key, const SlicePointer &slice);
+
+    /** Removes all slices, discards pending prefetch requests and releases the time step images.*/
+    void Clear();
+
+    /** Maximum memory used by the cached slices in bytes. Default is 128 MB.*/
+    void SetCapacity(std::size_t capacity);
+    std::size_t GetCapacity() const;
+    /** Memory currently used by the cached slices in bytes.*/
+    std::size_t GetSize() const;
+    std::size_t GetNumberOfSlices() const;
+
+    /** Reslices the passed planes of the time step of the image on a background thread.
+     * The image is accessed through a time step image that references the pixel data, so the
+     * background thread never touches the pipeline of the passed image. The time step image is
+     * kept for the requester until its next request or CancelPrefetch(). Planes whose keys are
+     * already cached are skipped. A pending request of the same requester is replaced.
+     * @pre Must be called from the thread that updates the image (usually the rendering thread).*/
+    void Prefetch(const void *requester,
+                  Image *image,
+                  TimeStepType timeStep,
+                  const std::vector<PlaneGeometry::Pointer> &planes,
+                  int interpolationMode,
+                  bool inPlaneResampleExtentByGeometry);
+
+    /** Discards the pending request of requester, stops its running request and releases its time step image.
+     * Must be called before the requester is destroyed.*/
+    void CancelPrefetch(const void *requester);
+
+    /** Blocks until the background thread has processed all prefetch requests.*/
+    void WaitForPrefetch();
+
+    /** Discards all pending requests, stops the background thread and waits for it to finish.
+     * Later prefetch requests are ignored. Called for the shared instance when the Core module is unloaded.*/
+    void StopPrefetch();
+
+  protected:
+    ImageSliceCache();
+    ~ImageSliceCache() override;
+
+    struct PrefetchRequest
+    {
+      const void *Requester = nullptr;
+      /** The image the request was created for, read-locked while reslicing.*/
+      Image::Pointer SourceImage;
+      Image::Pointer TimeStepImage;
+      ImageDataItem::Pointer Volume;
+      std::vector<std::pair<Key, PlaneGeometry::Pointer>> Planes;
+      int InterpolationMode = ExtractSliceFilter::RESLICE_NEAREST;
+      bool InPlaneResampleExtentByGeometry = false;
+    };
+
+    /** Time step image handed to the background thread, reused as long as image and time step do not change.*/
+    struct TimeStepImageEntry
+    {
+      Image::Pointer TimeStepImage;
+      ImageDataItem::Pointer Volume;
+      const Image *Source = nullptr;
+      itk::ModifiedTimeType ImageMTime = 0;
+      TimeStepType TimeStep = 0;
+    };
+
+    using EntryType = std::pair<Key, SlicePointer>;
+
+    void EvictToCapacity();
+    bool IsPrefetchCancelled(const void *requester) const;
+    void PrefetchThreadMain();
+    void ProcessPrefetchRequest(const PrefetchRequest &request);
+
+    mutable std::mutex m_Mutex;
+    std::list<EntryType> m_Entries;
+    std::size_t m_Capacity;
+    std::size_t m_Size;
+    /** Newest inserted state of each image with cached slices.*/
+    std::map<const Image *, itk::ModifiedTimeType> m_LatestImageMTimes;
+
+    std::mutex m_PrefetchMutex;
+    std::condition_variable m_PrefetchCondition;
+    std::map<const void *, TimeStepImageEntry> m_TimeStepImages;
+    std::list<std::unique_ptr<PrefetchRequest>> m_PendingRequests;
+    const void *m_BusyRequester;
+    bool m_BusyRequestCancelled;
+    bool m_PrefetchBusy;
+    bool m_StopPrefetch;
+    std::thread m_PrefetchThread;
+
+  private:
+    ImageSliceCache(const ImageSliceCache &) = delete;
+    ImageSliceCache &operator=(const ImageSliceCache &) = delete;
+  };
+}
+
+#endif
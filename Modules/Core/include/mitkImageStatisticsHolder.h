@@ -16,6 +16,10 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include <MitkCoreExports.h>
 
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #ifndef __itkHistogram_h
 #include <itkHistogram.h>
 #endif
@@ -32,6 +36,15 @@ namespace mitk
     GetStatistics() method in mitk::Image class.
 
     Minimum or maximum might by infinite values. 2nd minimum and maximum are guaranteed to be finite values.
+
+    The extrema of a time step are computed and kept per block (one block per slice of the highest image dimension)
+    and merged afterwards. Write access via mitk::ImageWriteAccessor registers the written memory range at the
+    holder. If the image was modified and all modifications since the last computation were done by write
+    accessors, only the blocks overlapping the written ranges are recomputed (e.g. a single slice after a paint
+    stroke). Any other modification of the image (without write accessor) results in a recomputation of all blocks.
+    @remark If image data is changed without write accessor (e.g. via the raw buffer returned by
+    mitk::Image::GetData()) while write accessors were used on other parts of the image since the last computation,
+    the former changes are not detected.
     */
   class MITKCORE_EXPORT ImageStatisticsHolder
   {
@@ -148,7 +161,56 @@ namespace mitk
                                                 int t,
                                                 unsigned int component);
 
+    friend class Image;
+    friend class ImageWriteAccessor;
+    friend class ImageVtkWriteAccessor;
+
   protected:
+    /** Extrema of a block (or of a whole time step) of the image.*/
+    struct Extrema
+    {
+      ScalarType Min = itk::NumericTraits<ScalarType>::max();
+      ScalarType Max = itk::NumericTraits<ScalarType>::NonpositiveMin();
+      ScalarType SecondMin = itk::NumericTraits<ScalarType>::max();
+      ScalarType SecondMax = itk::NumericTraits<ScalarType>::NonpositiveMin();
+      unsigned int CountOfMin = 0;
+      unsigned int CountOfMax = 0;
+
+      void Add(ScalarType value);
+      /** Merges the extrema of another (disjoint) block. The result is identical to computing the extrema of both
+       blocks in one pass.*/
+      void Merge(const Extrema &other);
+    };
+
+    /** Block wise extrema of one time step.*/
+    struct TimeStepBlocks
+    {
+      /** Buffer of the time step the blocks refer to.*/
+      const void *Buffer = nullptr;
+      std::size_t BlockSize = 0;
+      unsigned int Component = 0;
+      std::vector<Extrema> Blocks;
+      std::vector<bool> Dirty;
+    };
+
+    /** Returns the blocks of time step t. If the blocks were computed for another buffer, layout or component
+     they are reset and all marked dirty.*/
+    TimeStepBlocks &GetTimeStepBlocks(
+      int t, const void *buffer, unsigned int numberOfBlocks, std::size_t pixelsPerBlock, unsigned int component);
+
+    /** Merges the blocks of time step t into the statistics of the time step.*/
+    void MergeTimeStepBlocks(int t);
+
+    /** Called by ImageWriteAccessor after write access to the passed memory range.*/
+    void RegisterWrittenRange(const void *begin, const void *end);
+
+    /** Marks all blocks as dirty on the next recomputation (e.g. if the data was replaced by the image).*/
+    void InvalidateAllBlocks();
+
+    /** Marks all blocks dirty that overlap a registered written range (or all blocks if modifications
+     are not covered by written ranges).*/
+    void ApplyWrittenRanges();
+
     virtual void ResetImageStatistics();
 
     virtual void ComputeImageStatistics(int t = 0, unsigned int component = 0);
@@ -170,6 +232,12 @@ namespace mitk
     mutable std::vector<ScalarType> m_Scalar2ndMax;
 
     itk::TimeStamp m_LastRecomputeTimeStamp;
+
+    std::vector<TimeStepBlocks> m_TimeStepBlocks;
+
+    std::mutex m_WrittenRangesMutex;
+    std::vector<std::pair<const unsigned char *, const unsigned char *>> m_WrittenRanges;
+    bool m_AllBlocksWritten;
   };
 
 } // end namespace
@@ -19,6 +19,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkImageSliceCache.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -111,6 +112,12 @@ namespace mitk
    * If the modality-property is set for an image, the mapper uses modality-specific default properties,
    * e.g. color maps, if they are defined.
 
+   * Resliced slices (except thick slices and slices of curved geometries) are kept in the
+   * process-wide ImageSliceCache that is shared by all mappers and render windows. Scrolling
+   * back to a recently shown slice or showing the same plane in another render window reuses
+   * the cached slice. If a render window is scrolled along the plane normal, the next
+   * slices in scroll direction are resliced in the background (see SetNumberOfPrefetchedSlices()).
+
    * \ingroup Mapper
    */
   class MITKCORE_EXPORT ImageVtkMapper2D : public VtkMapper
@@ -134,6 +141,13 @@ namespace mitk
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
     //### end of methods of MITK-VTK rendering pipeline
 
+    /** \brief Cache of the resliced slices, shared by all mappers (see ImageSliceCache::GetInstance()). */
+    ImageSliceCache *GetSliceCache() const;
+
+    /** \brief Number of slices that are resliced in advance in scroll direction. 0 disables prefetching. Default is 4. */
+    itkSetMacro(NumberOfPrefetchedSlices, unsigned int);
+    itkGetConstMacro(NumberOfPrefetchedSlices, unsigned int);
+
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
     /**
        * To render axial, coronal, and sagittal, the mapper is called three times.
@@ -193,6 +207,14 @@ namespace mitk
 
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
+      /** \brief Spacing of the current slice, m_mmPerPixel points to it. */
+      mitk::ScalarType m_SliceSpacing[2];
+      /** \brief Reslice axes of the current slice, used to transform the actors. */
+      vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+
+      /** \brief Cache key of the last slice, used to detect the scroll direction. */
+      ImageSliceCache::Key m_LastSliceKey;
+      bool m_HasLastSliceKey;
 
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
@@ -314,6 +336,15 @@ namespace mitk
 
     /** Helper function to reset the local storage in order to indicate an invalid state.*/
     void SetToInvalidState(mitk::ImageVtkMapper2D::LocalStorage* localStorage);
+
+    /** \brief Starts prefetching the next slices if the renderer was scrolled along the plane normal
+      * since the last slice identified by key.*/
+    void PrefetchSlices(mitk::BaseRenderer *renderer,
+                        mitk::Image *image,
+                        const PlaneGeometry *worldGeometry,
+                        const ImageSliceCache::Key &key);
+
+    unsigned int m_NumberOfPrefetchedSlices;
   };
 
 } // namespace mitk
@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <itkImageIOBase.h>
 
+#include <array>
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -56,10 +59,41 @@ namespace mitk
     @param dictionary Reference to the meta data dictionary that contains the information that should be extracted.*/
     static PropertyList::Pointer ExtractMetaDataAsPropertyList(const itk::MetaDataDictionary& dictionary, const std::string& mimeTypeName, const std::vector<std::string>& defaultMetaDataKeys);
 
+    /** Part of an image that is read by LoadRawMitkImageFromImageIO() or LoadPartialImage() instead of the whole image.
+    The default request selects the whole image.*/
+    struct PartialReadRequest
+    {
+      /** First voxel of the requested sub-volume.*/
+      itk::Index<3> Index = {{0, 0, 0}};
+      /** Size of the requested sub-volume in voxels. A size of 0 selects everything from Index to the end of the dimension.*/
+      itk::Size<3> Size = {{0, 0, 0}};
+      /** Only every Stride[i]-th voxel of the sub-volume is read (e.g. 2 for a preview with half the resolution).*/
+      std::array<unsigned int, 3> Stride = {{1, 1, 1}};
+      /** Time steps to read in ascending order. All time steps are read if empty.*/
+      std::vector<TimeStepType> TimeSteps;
+    };
+
     /** Helper function that van be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
-    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
+    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...
+    Uncompressed data of detached NRRD headers (.nhdr) is memory mapped instead of read (see Image::SetMappedChannel()).*/
     static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path);
 
+    /** Like LoadRawMitkImageFromImageIO(), but only loads the requested part of the image. The geometry of the
+    result is that of the part: the origin is moved to its first voxel, the spacing is multiplied by the stride
+    and the time bounds of the requested time steps are kept.
+    Only the requested voxels are copied from uncompressed NRRD data. ImageIOs that support streaming
+    (e.g. NIfTI, MetaImage) read the requested rows slice by slice. For all other formats (e.g. compressed NRRD)
+    the whole image is read and the part is copied from it.
+    @throw mitk::Exception if the request exceeds the image.*/
+    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO,
+                                                      const std::string& path,
+                                                      const PartialReadRequest& request);
+
+    /** Loads the requested part of the image file at path with the ITK ImageIO that supports it
+    (see LoadRawMitkImageFromImageIO()). Meant for batch processing and previews of large images
+    that do not need all voxels or the meta data of the file.*/
+    static Image::Pointer LoadPartialImage(const std::string& path, const PartialReadRequest& request);
+
     /** Helper function that van be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
     Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
     static void PreparImageIOToWriteImage(itk::ImageIOBase* imageIO, const Image* image);
@@ -0,0 +1,72 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+
+#include <cstdint>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \brief Maps a region of a file into memory.
+   *
+   * The region is mapped copy-on-write: pages are read from the file on first access and
+   * writing to the mapped memory never changes the file. Pages that were not written can be
+   * dropped and re-read by the operating system at any time, so mapping a file that is larger
+   * than the available memory is fine as long as only parts of it are accessed.
+   *
+   * Used by mitk::Image::SetMappedChannel() to back the pixel data of an image by a file.
+   * The file must not be truncated while it is mapped.
+   *
+   * \ingroup IO
+   */
+  class MITKCORE_EXPORT MemoryMappedFile
+  {
+  public:
+    /**
+     * \brief Maps @a length bytes of the file starting at byte @a offset.
+     * If @a length is 0, everything from @a offset to the end of the file is mapped.
+     * \throw mitk::Exception if the file cannot be opened or the region exceeds the file.
+     */
+    MemoryMappedFile(const std::string &path, std::uint64_t offset = 0, std::uint64_t length = 0);
+    ~MemoryMappedFile();
+
+    /** Start of the mapped region, i.e. the byte at the offset passed to the constructor.*/
+    void *GetData() const { return m_Data; }
+    std::uint64_t GetLength() const { return m_Length; }
+    std::uint64_t GetOffset() const { return m_Offset; }
+    const std::string &GetPath() const { return m_Path; }
+
+    /** Size of the file in bytes.
+     * \throw mitk::Exception if the file cannot be accessed.*/
+    static std::uint64_t GetFileSize(const std::string &path);
+
+  private:
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    std::string m_Path;
+    std::uint64_t m_Offset;
+    std::uint64_t m_Length;
+    void *m_Data;
+
+    /** Start and size of the mapping, which begins at a page/allocation granularity boundary.*/
+    void *m_MappedAddress;
+    std::uint64_t m_MappedLength;
+  };
+}
+
+#endif
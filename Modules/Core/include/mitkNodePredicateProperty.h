@@ -44,6 +44,12 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    const std::string &GetValidPropertyName() const { return m_ValidPropertyName; }
+    //##Documentation
+    //## @brief Returns the property the node property is compared to or nullptr if only the name is checked
+    const mitk::BaseProperty *GetValidProperty() const { return m_ValidProperty; }
+    const mitk::BaseRenderer *GetRenderer() const { return m_Renderer; }
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include "mitkMessage.h"
 #include <map>
 #include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -33,6 +36,16 @@ namespace mitk
   //## Thus, nodes are stored in a noncyclical directed graph data structure.
   //## It is derived from mitk::DataStorage and implements its interface,
   //## including AddNodeEvent and RemoveNodeEvent.
+  //##
+  //## The data type, the data UID and the values of some properties (by default "name", see
+  //## AddIndexedPropertyKey()) of all nodes are kept in indices. GetSubset(), GetNode() and
+  //## GetNamedNode() answer NodePredicateDataType, NodePredicateDataUID and (not renderer specific)
+  //## NodePredicateProperty conditions for these keys, as well as conjunctions containing one of them,
+  //## from the indices instead of checking every node. The indices are updated when a node is added,
+  //## removed or sends a modified event (e.g. DataNode::SetProperty(), SetName() or SetData()), and when
+//## an indexed property of a node sends a modified event (e.g. BaseProperty::SetValue()).
+  //## Only the properties of the nodes themselves are indexed. Changes of the properties of the data
+  //## send no modified event of the node, so nodes with data but without the property are always checked.
   //## @ingroup StandaloneDataStorage
   class MITKCORE_EXPORT StandaloneDataStorage : public mitk::DataStorage
   {
@@ -89,6 +102,24 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief returns a set of data objects that meet the given condition(s)
+    //##
+    //## Like DataStorage::GetSubset(), but indexed conditions only check the nodes found in the indices.
+    //## The order of the result is the same as for a check of all nodes.
+    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const override;
+
+    //##Documentation
+    //## @brief Adds a property key to the keys whose values are indexed
+    //##
+    //## Only non-renderer specific properties are indexed. The values of all nodes already
+    //## in the StandaloneDataStorage are indexed immediately.
+    void AddIndexedPropertyKey(const std::string &propertyKey);
+
+    //##Documentation
+    //## @brief returns the property keys whose values are indexed
+    std::vector<std::string> GetIndexedPropertyKeys() const;
+
     mutable std::mutex m_Mutex;
 
   protected:
@@ -96,6 +127,34 @@ namespace mitk
     //## @brief noncyclical directed graph data structure to store the nodes with their relation
     typedef std::map<mitk::DataNode::ConstPointer, SetOfObjects::ConstPointer> AdjacencyList;
 
+    //##Documentation
+    //## @brief set of nodes in the same order as the keys of an AdjacencyList
+    typedef std::set<const mitk::DataNode *> NodeSet;
+
+    //##Documentation
+    //## @brief property key -> property
+    typedef std::map<std::string, mitk::BaseProperty::Pointer> PropertyMap;
+
+    //##Documentation
+    //## @brief the indexed keys of one node
+    struct NodeIndexEntry
+    {
+      bool HasData = false;
+      std::string DataType;
+      std::string DataUID;
+      std::map<std::string, std::string> PropertyValues;
+      PropertyMap Properties;
+    };
+
+    //##Documentation
+    //## @brief observer of the modified event of an indexed property and the nodes that have the property
+    struct PropertyObserver
+    {
+      mitk::BaseProperty::Pointer Property;
+      unsigned long Tag = 0;
+      std::multiset<const mitk::DataNode *> Nodes;
+    };
+
     StandaloneDataStorage();
     ~StandaloneDataStorage() override;
 
@@ -114,6 +173,40 @@ namespace mitk
     //## @brief deletes all references to a node in a given relation (used in Remove() and TreeListener)
     void RemoveFromRelation(const mitk::DataNode *node, AdjacencyList &relation);
 
+    //##Documentation
+    //## @brief Updates the indices after a modified event of node
+    void OnNodeChanged(const mitk::DataNode *node) override;
+
+    //##Documentation
+    //## @brief Updates the indices of the nodes that have the indexed property caller
+    void OnIndexedPropertyModified(const itk::Object *caller, const itk::EventObject &event);
+
+    //##Documentation
+    //## @brief Reads the indexed keys of node. The indexed property keys are passed, because they must
+    //## not be read without m_IndexMutex
+    static NodeIndexEntry CreateIndexEntry(const mitk::DataNode *node, const std::set<std::string> &propertyKeys);
+
+    //##Documentation
+    //## @brief Adds node to the indices (m_IndexMutex must be locked)
+    void InsertIntoIndices(const mitk::DataNode *node, const NodeIndexEntry &entry);
+
+    //##Documentation
+    //## @brief Removes node from the indices (m_IndexMutex must be locked)
+    void RemoveFromIndices(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Observes the properties of node that are in newProperties, but not in oldProperties, and
+    //## stops observing the ones only in oldProperties (m_IndexMutex must be locked)
+    void UpdatePropertyObservers(const mitk::DataNode *node,
+                                 const PropertyMap &oldProperties,
+                                 const PropertyMap &newProperties);
+
+    //##Documentation
+    //## @brief Adds the nodes that may fulfill condition to candidates (m_IndexMutex must be locked)
+    //##
+    //## Returns false if condition can not be answered from the indices.
+    bool GetIndexedCandidates(const NodePredicateBase *condition, NodeSet &candidates) const;
+
     //##Documentation
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
@@ -124,6 +217,27 @@ namespace mitk
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+    //##Documentation
+    //## @brief Guards the indices. It is never locked while a predicate is checked or an event is sent,
+    //## as both may cause modified events of nodes
+    mutable std::mutex m_IndexMutex;
+    std::set<std::string> m_IndexedPropertyKeys;
+    std::map<const mitk::DataNode *, NodeIndexEntry> m_IndexEntries;
+    std::map<std::string, NodeSet> m_DataTypeIndex;
+    std::map<std::string, NodeSet> m_DataUIDIndex;
+    //##Documentation
+    //## @brief property key -> nodes that have the property
+    std::map<std::string, NodeSet> m_PropertyKeyIndex;
+    //##Documentation
+    //## @brief property key -> value as string -> nodes
+    std::map<std::string, std::map<std::string, NodeSet>> m_PropertyValueIndex;
+    //##Documentation
+    //## @brief property key -> nodes with data but without the property, their data may have it
+    std::map<std::string, NodeSet> m_DataPropertyCandidates;
+    //##Documentation
+    //## @brief indexed property -> its observer, a property value may change without a modified event of the node
+    std::map<const mitk::BaseProperty *, PropertyObserver> m_PropertyObservers;
   };
 } // namespace mitk
 #endif
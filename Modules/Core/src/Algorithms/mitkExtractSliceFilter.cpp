@@ -26,15 +26,19 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   if (reslicer == nullptr)
   {
     m_Reslicer = vtkSmartPointer<vtkImageReslice>::New();
+    m_OwnsReslicer = true;
   }
   else
   {
     m_Reslicer = reslicer;
+    m_OwnsReslicer = false;
   }
 
   m_TimeStep = 0;
   m_Reslicer->ReleaseDataFlagOn();
   m_InterpolationMode = ExtractSliceFilter::RESLICE_NEAREST;
+  m_SlabMode = ExtractSliceFilter::SLAB_MAX;
+  m_SlabNumberOfSlices = 1;
   m_ResliceTransform = nullptr;
   m_InPlaneResampleExtentByGeometry = false;
   m_OutPutSpacing = new mitk::ScalarType[2];
@@ -404,6 +408,15 @@ void mitk::ExtractSliceFilter::GenerateData()
       m_Reslicer->SetInterpolationModeToNearestNeighbor();
   }
 
+  // a reslicer passed by the caller (e.g. an mitkVtkImageOverwrite) keeps its own slab settings
+  if (m_OwnsReslicer)
+  {
+    m_Reslicer->SetSlabMode(m_SlabMode);
+    m_Reslicer->SetSlabNumberOfSlices(m_SlabNumberOfSlices);
+    // the slab samples are spaced like the output slices
+    m_Reslicer->SetSlabSliceSpacingFraction(1.0);
+  }
+
   /*========== BEGIN setup extent of the slice ==========*/
   // Set the output extents! First included pixel index and last included pixel index
   // xMax and yMax are one after the last pixel. so they have to be decremented by 1.
@@ -29,10 +29,12 @@ struct mitk::ExtractSliceFilter2::Impl
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
   itk::Object::Pointer InterpolateImageFunction;
+  itk::ModifiedTimeType InterpolateImageFunctionInputMTime;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    InterpolateImageFunctionInputMTime(0)
 {
 }
 
@@ -196,34 +198,23 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
   }
 }
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
+void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
+  const auto* inputImage = this->GetInput();
+
+  // Reuse the interpolate image function (and its potentially expensive B-spline
+  // coefficients) as long as the input image was not modified.
+  if (nullptr != m_Impl->InterpolateImageFunction && inputImage->GetMTime() == m_Impl->InterpolateImageFunctionInputMTime)
     return;
 
-  const auto* inputImage = this->GetInput();
   AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  m_Impl->InterpolateImageFunctionInputMTime = inputImage->GetMTime();
 }
 
 void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
 {
   const auto* inputImage = this->GetInput();
   AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
-
-void mitk::ExtractSliceFilter2::GenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
-  const auto* inputImage = this->GetInput();
-
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-
-  this->AllocateOutputs();
-  auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
-
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -20,6 +20,9 @@ found in the LICENSE file.
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
+#include "mitkStdFunctionCommand.h"
+
+#include <algorithm>
 
 mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
 {
@@ -193,13 +196,26 @@ void mitk::DataStorage::OnNodeInteractorChanged(itk::Object *caller, const itk::
 
 void mitk::DataStorage::OnNodeModifiedOrDeleted(const itk::Object *caller, const itk::EventObject &event)
 {
-  if (m_BlockNodeModifiedEvents)
-    return;
-
   const auto *_Node = dynamic_cast<const DataNode *>(caller);
   if (_Node)
   {
     const auto *modEvent = dynamic_cast<const itk::ModifiedEvent *>(&event);
+    if (modEvent)
+    {
+      {
+        // the cached bounds of replaced data are not needed anymore, release the data
+        std::lock_guard<std::mutex> locked(m_BoundingGeometryCacheMutex);
+        auto cacheIter = m_BoundingGeometryCache.find(_Node);
+        if (cacheIter != m_BoundingGeometryCache.end() && cacheIter->second.Data != _Node->GetData())
+          m_BoundingGeometryCache.erase(cacheIter);
+      }
+
+      this->OnNodeChanged(_Node);
+    }
+
+    if (m_BlockNodeModifiedEvents)
+      return;
+
     if (modEvent)
       ChangedNodeEvent.Send(_Node);
     else
@@ -207,6 +223,10 @@ void mitk::DataStorage::OnNodeModifiedOrDeleted(const itk::Object *caller, const
   }
 }
 
+void mitk::DataStorage::OnNodeChanged(const DataNode *)
+{
+}
+
 void mitk::DataStorage::AddListeners(const DataNode *_Node)
 {
   std::lock_guard<std::mutex> locked(m_MutexOne);
@@ -234,6 +254,12 @@ void mitk::DataStorage::AddListeners(const DataNode *_Node)
 
 void mitk::DataStorage::RemoveListeners(const DataNode *_Node)
 {
+  {
+    // the node leaves the DataStorage, its cached bounds are not needed anymore
+    std::lock_guard<std::mutex> locked(m_BoundingGeometryCacheMutex);
+    m_BoundingGeometryCache.erase(_Node);
+  }
+
   std::lock_guard<std::mutex> locked(m_MutexOne);
   // node must not be 0 and must be registered
   auto *NonConstNode = const_cast<DataNode *>(_Node);
@@ -251,6 +277,166 @@ void mitk::DataStorage::RemoveListeners(const DataNode *_Node)
   }
 }
 
+std::shared_ptr<const mitk::DataStorage::BoundingGeometryContribution>
+  mitk::DataStorage::GetBoundingGeometryContribution(const DataNode *node) const
+{
+  BaseData *data = node->GetData();
+  if (data == nullptr)
+    return std::make_shared<BoundingGeometryContribution>();
+
+  // Data with a source may get a new geometry from its pipeline, its contribution can not be cached
+  const bool cacheable = data->GetSource().IsNull() && this->Exists(node);
+
+  if (cacheable)
+  {
+    std::lock_guard<std::mutex> locked(m_BoundingGeometryCacheMutex);
+    auto cacheIter = m_BoundingGeometryCache.find(node);
+    if (cacheIter != m_BoundingGeometryCache.end() && cacheIter->second.IsValidFor(data))
+      return cacheIter->second.Contribution;
+  }
+
+  auto contribution = std::make_shared<BoundingGeometryContribution>();
+
+  if (data->IsEmpty() == false)
+  {
+    const TimeGeometry *timeGeometry = data->GetUpdatedTimeGeometry();
+
+    // Needed for check of zero bounding boxes
+    ScalarType nullpoint[] = {0, 0, 0, 0, 0, 0};
+    BoundingBox::BoundsArrayType itkBoundsZero(nullpoint);
+
+    // bounding box (only if non-zero)
+    if (timeGeometry != nullptr && timeGeometry->GetBoundingBoxInWorld()->GetBounds() != itkBoundsZero)
+    {
+      contribution->IsEmpty = false;
+
+      for (unsigned char i = 0; i < 8; ++i)
+      {
+        Point3D point = timeGeometry->GetCornerPointInWorld(i);
+        if (point[0] * point[0] + point[1] * point[1] + point[2] * point[2] < large)
+          contribution->CornerPoints.push_back(point);
+        else
+        {
+          itkGenericOutputMacro(<< "Unrealistically distant corner point encountered. Ignored. Node: " << node);
+        }
+      }
+
+      ScalarType stmax = itk::NumericTraits<ScalarType>::max();
+      ScalarType stmin = itk::NumericTraits<ScalarType>::NonpositiveMin();
+
+      try
+      {
+        // time bounds
+        // iterate over all time steps
+        // Attention: Objects with zero bounding box are not respected in time bound calculation
+        for (TimeStepType i = 0; i < timeGeometry->CountTimeSteps(); i++)
+        {
+          // We must not use 'node->GetData()->GetGeometry(i)->GetSpacing()' here, as it returns the spacing
+          // in its original space, which, in case of an image geometry, can have the values in different
+          // order than in world space. For the further calculations, we need to have the spacing values
+          // in world coordinate order (sag-cor-ax).
+          Vector3D spacing;
+          spacing.Fill(1.0);
+          data->GetGeometry(i)->IndexToWorld(spacing, spacing);
+          for (int axis = 0; axis < 3; ++ axis)
+          {
+            ScalarType space = std::abs(spacing[axis]);
+            if (space < contribution->MinSpacing[axis])
+            {
+              contribution->MinSpacing[axis] = space;
+            }
+          }
+
+          const auto curTimeBounds = timeGeometry->GetTimeBounds(i);
+          if ((curTimeBounds[0] > stmin) && (curTimeBounds[0] < stmax))
+          {
+            contribution->TimePoints.push_back(curTimeBounds[0]);
+          }
+          if ((curTimeBounds[1] > contribution->MaximalTime) && (curTimeBounds[1] < stmax))
+          {
+            contribution->MaximalTime = curTimeBounds[1];
+          }
+        }
+      }
+      catch ( const itk::ExceptionObject &e )
+      {
+        MITK_ERROR << e.GetDescription() << std::endl;
+      }
+    }
+  }
+
+  if (cacheable)
+  {
+    // the geometries are observed after their update, it may have modified them
+    std::lock_guard<std::mutex> locked(m_BoundingGeometryCacheMutex);
+    m_BoundingGeometryCache[node].Set(data, contribution);
+  }
+
+  return contribution;
+}
+
+mitk::DataStorage::BoundingGeometryCacheEntry::~BoundingGeometryCacheEntry()
+{
+  this->Clear();
+}
+
+void mitk::DataStorage::BoundingGeometryCacheEntry::Set(const BaseData *data,
+                                                        std::shared_ptr<const BoundingGeometryContribution> contribution)
+{
+  this->Clear();
+
+  Data = data;
+  Geometry = data->GetTimeGeometry();
+  TimeSteps = Geometry != nullptr ? Geometry->CountTimeSteps() : 0;
+  Contribution = contribution;
+
+  // the observers only share the flag, so they do not depend on the lifetime of the DataStorage
+  auto valid = std::make_shared<std::atomic<bool>>(true);
+  Valid = valid;
+
+  auto command = StdFunctionCommand::New();
+  command->SetCommandFilter([](const itk::EventObject &) { return true; });
+  command->SetCommandAction([valid](const itk::EventObject &) { *valid = false; });
+
+  auto observe = [this, &command](const itk::Object *object) {
+    if (object != nullptr)
+      Observers.emplace_back(const_cast<itk::Object *>(object), object->AddObserver(itk::ModifiedEvent(), command));
+  };
+
+  observe(data);
+  observe(Geometry);
+
+  // the time geometry itself is only modified when its bounding box is updated, so observe the time steps
+  for (TimeStepType i = 0; i < TimeSteps; ++i)
+  {
+    const BaseGeometry *geometry = Geometry->GetGeometryForTimeStep(i);
+    if (geometry == nullptr)
+      continue;
+    observe(geometry);
+    observe(geometry->GetIndexToWorldTransform());
+  }
+}
+
+bool mitk::DataStorage::BoundingGeometryCacheEntry::IsValidFor(const BaseData *data) const
+{
+  // Geometry is observed and therefore still alive
+  return Valid != nullptr && *Valid && Data == data && Geometry == data->GetTimeGeometry() &&
+         (Geometry == nullptr || TimeSteps == Geometry->CountTimeSteps());
+}
+
+void mitk::DataStorage::BoundingGeometryCacheEntry::Clear()
+{
+  for (const auto &observer : Observers)
+    observer.first->RemoveObserver(observer.second);
+
+  Observers.clear();
+  Contribution.reset();
+  Valid.reset();
+  Data = nullptr;
+  Geometry = nullptr;
+  TimeSteps = 0;
+}
+
 mitk::TimeGeometry::ConstPointer mitk::DataStorage::ComputeBoundingGeometry3D(const SetOfObjects *input,
                                                                               const char *boolPropertyKey,
                                                                               const BaseRenderer *renderer,
@@ -262,88 +448,31 @@ mitk::TimeGeometry::ConstPointer mitk::DataStorage::ComputeBoundingGeometry3D(co
   BoundingBox::PointsContainer::Pointer pointscontainer = BoundingBox::PointsContainer::New();
 
   BoundingBox::PointIdentifier pointid = 0;
-  Point3D point;
 
   Vector3D minSpacing;
   minSpacing.Fill(itk::NumericTraits<ScalarType>::max());
 
-  ScalarType stmax = itk::NumericTraits<ScalarType>::max();
-  ScalarType stmin = itk::NumericTraits<ScalarType>::NonpositiveMin();
-
   std::set<ScalarType> existingTimePoints;
   ScalarType maximalTime = 0;
 
-  // Needed for check of zero bounding boxes
-  ScalarType nullpoint[] = {0, 0, 0, 0, 0, 0};
-  BoundingBox::BoundsArrayType itkBoundsZero(nullpoint);
-
   for (SetOfObjects::ConstIterator it = input->Begin(); it != input->End(); ++it)
   {
     DataNode::Pointer node = it->Value();
-    if ((node.IsNotNull()) && (node->GetData() != nullptr) && (node->GetData()->IsEmpty() == false) &&
-        node->IsOn(boolPropertyKey, renderer) && node->IsOn(boolPropertyKey2, renderer))
+    if ((node.IsNotNull()) && node->IsOn(boolPropertyKey, renderer) && node->IsOn(boolPropertyKey2, renderer))
     {
-      const TimeGeometry *timeGeometry = node->GetData()->GetUpdatedTimeGeometry();
+      // the geometry part is cached per node, only the visibility is checked on each call
+      const auto contribution = this->GetBoundingGeometryContribution(node);
+      if (contribution->IsEmpty)
+        continue;
 
-      if (timeGeometry != nullptr)
-      {
-        // bounding box (only if non-zero)
-        BoundingBox::BoundsArrayType itkBounds = timeGeometry->GetBoundingBoxInWorld()->GetBounds();
-        if (itkBounds == itkBoundsZero)
-        {
-          continue;
-        }
+      for (const auto &point : contribution->CornerPoints)
+        pointscontainer->InsertElement(pointid++, point);
 
-        unsigned char i;
-        for (i = 0; i < 8; ++i)
-        {
-          point = timeGeometry->GetCornerPointInWorld(i);
-          if (point[0] * point[0] + point[1] * point[1] + point[2] * point[2] < large)
-            pointscontainer->InsertElement(pointid++, point);
-          else
-          {
-            itkGenericOutputMacro(<< "Unrealistically distant corner point encountered. Ignored. Node: " << node);
-          }
-        }
-        try
-        {
-          // time bounds
-          // iterate over all time steps
-          // Attention: Objects with zero bounding box are not respected in time bound calculation
-          for (TimeStepType i = 0; i < timeGeometry->CountTimeSteps(); i++)
-          {
-            // We must not use 'node->GetData()->GetGeometry(i)->GetSpacing()' here, as it returns the spacing
-            // in its original space, which, in case of an image geometry, can have the values in different
-            // order than in world space. For the further calculations, we need to have the spacing values
-            // in world coordinate order (sag-cor-ax).
-            Vector3D spacing;
-            spacing.Fill(1.0);
-            node->GetData()->GetGeometry(i)->IndexToWorld(spacing, spacing);
-            for (int axis = 0; axis < 3; ++ axis)
-            {
-              ScalarType space = std::abs(spacing[axis]);
-              if (space < minSpacing[axis])
-              {
-                minSpacing[axis] = space;
-              }
-            }
+      for (int axis = 0; axis < 3; ++axis)
+        minSpacing[axis] = std::min(minSpacing[axis], contribution->MinSpacing[axis]);
 
-            const auto curTimeBounds = timeGeometry->GetTimeBounds(i);
-            if ((curTimeBounds[0] > stmin) && (curTimeBounds[0] < stmax))
-            {
-              existingTimePoints.insert(curTimeBounds[0]);
-            }
-            if ((curTimeBounds[1] > maximalTime) && (curTimeBounds[1] < stmax))
-            {
-               maximalTime = curTimeBounds[1];
-            }
-          }
-        }
-        catch ( const itk::ExceptionObject &e )
-        {
-          MITK_ERROR << e.GetDescription() << std::endl;
-        }
-      }
+      existingTimePoints.insert(contribution->TimePoints.cbegin(), contribution->TimePoints.cend());
+      maximalTime = std::max(maximalTime, contribution->MaximalTime);
     }
   }
 
@@ -414,41 +543,16 @@ mitk::BoundingBox::Pointer mitk::DataStorage::ComputeBoundingBox(const char *boo
   BoundingBox::PointsContainer::Pointer pointscontainer = BoundingBox::PointsContainer::New();
 
   BoundingBox::PointIdentifier pointid = 0;
-  Point3D point;
-
-  // Needed for check of zero bounding boxes
-  ScalarType nullpoint[] = {0, 0, 0, 0, 0, 0};
-  BoundingBox::BoundsArrayType itkBoundsZero(nullpoint);
 
   SetOfObjects::ConstPointer all = this->GetAll();
   for (SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
   {
     DataNode::Pointer node = it->Value();
-    if ((node.IsNotNull()) && (node->GetData() != nullptr) && (node->GetData()->IsEmpty() == false) &&
-        node->IsOn(boolPropertyKey, renderer) && node->IsOn(boolPropertyKey2, renderer))
+    if ((node.IsNotNull()) && node->IsOn(boolPropertyKey, renderer) && node->IsOn(boolPropertyKey2, renderer))
     {
-      const TimeGeometry *geometry = node->GetData()->GetUpdatedTimeGeometry();
-      if (geometry != nullptr)
-      {
-        // bounding box (only if non-zero)
-        BoundingBox::BoundsArrayType itkBounds = geometry->GetBoundingBoxInWorld()->GetBounds();
-        if (itkBounds == itkBoundsZero)
-        {
-          continue;
-        }
-
-        unsigned char i;
-        for (i = 0; i < 8; ++i)
-        {
-          point = geometry->GetCornerPointInWorld(i);
-          if (point[0] * point[0] + point[1] * point[1] + point[2] * point[2] < large)
-            pointscontainer->InsertElement(pointid++, point);
-          else
-          {
-            itkGenericOutputMacro(<< "Unrealistically distant corner point encountered. Ignored. Node: " << node);
-          }
-        }
-      }
+      const auto contribution = this->GetBoundingGeometryContribution(node);
+      for (const auto &point : contribution->CornerPoints)
+        pointscontainer->InsertElement(pointid++, point);
     }
   }
 
@@ -13,9 +13,11 @@ found in the LICENSE file.
 // MITK
 #include "mitkImage.h"
 #include "mitkCompareImageDataFilter.h"
+#include "mitkExceptionMacro.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
+#include "mitkMemoryMappedFile.h"
 #include "mitkPixelTypeMultiplex.h"
 #include <mitkProportionalTimeGeometry.h>
 
@@ -38,7 +40,8 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_SharedReadSlots(new ImageAccessorSharedReadSlot[NUMBER_OF_SHARED_READ_SLOTS])
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -53,7 +56,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_SharedReadSlots(new ImageAccessorSharedReadSlot[NUMBER_OF_SHARED_READ_SLOTS])
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -95,6 +99,22 @@ mitk::Image::~Image()
   delete m_ImageStatistics;
 }
 
+mitk::ImageAccessorContention mitk::Image::GetAccessorContention() const
+{
+  ImageAccessorContention contention;
+  contention.LockedReads = m_LockedReadCount.load(std::memory_order_relaxed);
+  contention.SharedReadSlotsExhausted = m_SharedReadSlotsExhaustedCount.load(std::memory_order_relaxed);
+  contention.Waits = m_AccessorWaitCount.load(std::memory_order_relaxed);
+  return contention;
+}
+
+void mitk::Image::ResetAccessorContention() const
+{
+  m_LockedReadCount.store(0, std::memory_order_relaxed);
+  m_SharedReadSlotsExhaustedCount.store(0, std::memory_order_relaxed);
+  m_AccessorWaitCount.store(0, std::memory_order_relaxed);
+}
+
 const mitk::PixelType mitk::Image::GetPixelType(int n) const
 {
   return this->m_ImageDescriptor->GetChannelTypeById(n);
@@ -591,6 +611,11 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
 {
   if (IsValidSlice(s, t, n) == false)
     return false;
+
+  // the data is replaced without write accessor, statistics cannot be updated incrementally
+  if (m_ImageStatistics != nullptr)
+    m_ImageStatistics->InvalidateAllBlocks();
+
   ImageDataItemPointer sl;
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
@@ -627,6 +652,9 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
   if (IsValidVolume(t, n) == false)
     return false;
 
+  if (m_ImageStatistics != nullptr)
+    m_ImageStatistics->InvalidateAllBlocks();
+
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
   ImageDataItemPointer vol;
   if (IsVolumeSet(t, n))
@@ -672,6 +700,9 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
   if (IsValidChannel(n) == false)
     return false;
 
+  if (m_ImageStatistics != nullptr)
+    m_ImageStatistics->InvalidateAllBlocks();
+
   // channel descriptor
 
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
@@ -709,6 +740,48 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
   return true;
 }
 
+bool mitk::Image::SetMappedChannel(std::shared_ptr<const MemoryMappedFile> file, int n)
+{
+  if (IsValidChannel(n) == false || file == nullptr)
+    return false;
+
+  const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+  const size_t size = m_OffsetTable[4] * ptypeSize;
+  if (file->GetLength() < size)
+  {
+    mitkThrow() << "Mapped file \"" << file->GetPath() << "\" contains " << file->GetLength()
+                << " bytes, but channel " << n << " requires " << size << " bytes.";
+  }
+
+  if (m_ImageStatistics != nullptr)
+    m_ImageStatistics->InvalidateAllBlocks();
+
+  bool replaced = false;
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    replaced = IsChannelSet_unlocked(n);
+
+    ImageDataItemPointer ch = new ImageDataItem(this->m_ImageDescriptor, -1, file->GetData(), false);
+    ch->m_MappedFile = file;
+    ch->SetComplete(true);
+    m_Channels[n] = ch;
+
+    // volumes and slices of the channel may still reference the previous data
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      m_Volumes[GetVolumeIndex(t, n)] = nullptr;
+      for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+        m_Slices[GetSliceIndex(s, t, n)] = nullptr;
+    }
+    m_CompleteData = nullptr;
+  }
+
+  // replacing existing data is a modification, adding a missing channel is not (see SetImportChannel)
+  if (replaced)
+    Modified();
+  return true;
+}
+
 void mitk::Image::Initialize()
 {
   ImageDataItemPointerArray::iterator it, end;
@@ -730,6 +803,10 @@ void mitk::Image::Initialize()
   {
     m_ImageStatistics = new mitk::ImageStatisticsHolder(this);
   }
+  else
+  {
+    m_ImageStatistics->InvalidateAllBlocks();
+  }
 
   SetRequestedRegionToLargestPossibleRegion();
 }
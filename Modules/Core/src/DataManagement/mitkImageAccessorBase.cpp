@@ -125,16 +125,19 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
  * \throws mitk::Exception if memory area is incoherent (not supported yet)
  */
 bool mitk::ImageAccessorBase::Overlap(const ImageAccessorBase *iAB)
+{
+  return Overlap(iAB->m_AddressBegin, iAB->m_AddressEnd);
+}
+
+bool mitk::ImageAccessorBase::Overlap(const void *begin, const void *end)
 {
   if (m_CoherentMemory)
   {
-    if ((iAB->m_AddressBegin >= m_AddressBegin && iAB->m_AddressBegin < m_AddressEnd) ||
-        (iAB->m_AddressEnd > m_AddressBegin && iAB->m_AddressEnd <= m_AddressEnd))
+    if ((begin >= m_AddressBegin && begin < m_AddressEnd) || (end > m_AddressBegin && end <= m_AddressEnd))
     {
       return true;
     }
-    if ((m_AddressBegin >= iAB->m_AddressBegin && m_AddressBegin < iAB->m_AddressEnd) ||
-        (m_AddressEnd > iAB->m_AddressBegin && m_AddressEnd <= iAB->m_AddressEnd))
+    if ((m_AddressBegin >= begin && m_AddressBegin < end) || (m_AddressEnd > begin && m_AddressEnd <= end))
     {
       return true;
     }
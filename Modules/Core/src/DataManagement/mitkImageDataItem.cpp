@@ -29,6 +29,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageVtkReadAccessor.h>
 #include <mitkImageVtkWriteAccessor.h>
+#include <mitkMemoryMappedFile.h>
 
 mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
                                    const mitk::ImageDescriptor::Pointer desc,
@@ -175,6 +176,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_MappedFile(other.m_MappedFile),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
 {
@@ -183,6 +185,14 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Dimensions[i] = other.m_Dimensions[i];
 }
 
+std::shared_ptr<const mitk::MemoryMappedFile> mitk::ImageDataItem::GetMappedFile() const
+{
+  if (m_Parent.IsNotNull())
+    return m_Parent->GetMappedFile();
+
+  return m_MappedFile;
+}
+
 itk::LightObject::Pointer mitk::ImageDataItem::InternalClone() const
 {
   Self::Pointer newGeometry = new Self(*this);
@@ -14,8 +14,10 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <functional>
+
 mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image)
+  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image), m_SharedReadSlot(nullptr)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -32,7 +34,7 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer())
+  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer()), m_SharedReadSlot(nullptr)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -49,14 +51,19 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::Image
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const ImageDataItem *iDI)
-  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image)
+  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image), m_SharedReadSlot(nullptr)
 {
   OrganizeReadAccess();
 }
 
 mitk::ImageReadAccessor::~ImageReadAccessor()
 {
-  if (!(m_Options & ImageAccessorBase::IgnoreLock))
+  if (m_SharedReadSlot != nullptr)
+  {
+    ReleaseSharedReadSlot();
+    delete m_WaitLock;
+  }
+  else if (!(m_Options & ImageAccessorBase::IgnoreLock))
   {
     // Future work: In case of non-coherent memory, copied area needs to be deleted
 
@@ -91,6 +98,69 @@ const mitk::Image *mitk::ImageReadAccessor::GetImage() const
 }
 
 void mitk::ImageReadAccessor::OrganizeReadAccess()
+{
+  if (TryOrganizeSharedReadAccess())
+    return;
+
+  m_Image->m_LockedReadCount.fetch_add(1, std::memory_order_relaxed);
+  OrganizeLockedReadAccess();
+}
+
+bool mitk::ImageReadAccessor::TryOrganizeSharedReadAccess()
+{
+  if (m_Image->m_PendingWriterCount.load() != 0)
+    return false;
+
+  const auto threadId = std::this_thread::get_id();
+  const unsigned int numberOfSlots = Image::NUMBER_OF_SHARED_READ_SLOTS;
+
+  // start at a thread specific slot, so concurrent readers rarely compete for the same slot
+  const auto firstSlot = std::hash<std::thread::id>()(threadId) % numberOfSlots;
+
+  for (unsigned int i = 0; i < numberOfSlots; ++i)
+  {
+    auto &slot = m_Image->m_SharedReadSlots[(firstSlot + i) % numberOfSlots];
+
+    auto state = slot.m_State.load(std::memory_order_relaxed);
+    const auto busy = ImageAccessorSharedReadSlot::SlotClaimed | ImageAccessorSharedReadSlot::SlotOccupied;
+    if ((state & busy) != 0 || !slot.m_State.compare_exchange_strong(state, state | ImageAccessorSharedReadSlot::SlotClaimed))
+      continue;
+
+    slot.m_AddressBegin.store(m_AddressBegin, std::memory_order_relaxed);
+    slot.m_AddressEnd.store(m_AddressEnd, std::memory_order_relaxed);
+    slot.m_Thread.store(threadId, std::memory_order_relaxed);
+    slot.m_State.store((state + ImageAccessorSharedReadSlot::GenerationIncrement) | ImageAccessorSharedReadSlot::SlotOccupied);
+    m_SharedReadSlot = &slot;
+
+    // A write accessor increments the pending count before it checks the slots. So either it sees this
+    // slot or this reader sees the write accessor and takes the locked path instead.
+    if (m_Image->m_PendingWriterCount.load() == 0)
+      return true;
+
+    ReleaseSharedReadSlot();
+    return false;
+  }
+
+  m_Image->m_SharedReadSlotsExhaustedCount.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void mitk::ImageReadAccessor::ReleaseSharedReadSlot()
+{
+  const auto state = m_SharedReadSlot->m_State.load(std::memory_order_relaxed);
+  m_SharedReadSlot->m_State.store(
+    state & ~static_cast<std::uint64_t>(ImageAccessorSharedReadSlot::SlotClaimed | ImageAccessorSharedReadSlot::SlotOccupied));
+  m_SharedReadSlot = nullptr;
+
+  // a write accessor might wait for this slot
+  if (m_Image->m_PendingWriterCount.load() != 0)
+  {
+    std::lock_guard<std::mutex> lock(m_Image->m_ReadWriteLock);
+    m_Image->m_SharedReadReleased.notify_all();
+  }
+}
+
+void mitk::ImageReadAccessor::OrganizeLockedReadAccess()
 {
   m_Image->m_ReadWriteLock.lock();
 
@@ -115,11 +185,12 @@ void mitk::ImageReadAccessor::OrganizeReadAccess()
 
           // WAIT
           w->Increment();
+          m_Image->m_AccessorWaitCount.fetch_add(1, std::memory_order_relaxed);
           m_Image->m_ReadWriteLock.unlock();
           ImageAccessorBase::WaitForReleaseOf(w->m_WaitLock);
 
           // after waiting for the WriteAccessor w, start this method again
-          OrganizeReadAccess();
+          OrganizeLockedReadAccess();
           return;
         }
         else
@@ -14,10 +14,12 @@ found in the LICENSE file.
 #include "mitkHistogramGenerator.h"
 #include <mitkProperties.h>
 #include "mitkImageAccessByItk.h"
+
+#include <algorithm>
 //#define BOUNDINGOBJECT_IGNORE
 
 mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
-  : m_Image(image)
+  : m_Image(image), m_AllBlocksWritten(false)
 {
   m_CountOfMinValuedVoxels.resize(1, 0);
   m_CountOfMaxValuedVoxels.resize(1, 0);
@@ -96,6 +98,183 @@ void mitk::ImageStatisticsHolder::ResetImageStatistics()
   m_CountOfMaxValuedVoxels.assign(1, 0);
 }
 
+void mitk::ImageStatisticsHolder::Extrema::Add(ScalarType value)
+{
+  // update min
+  if (value < Min)
+  {
+    SecondMin = Min;
+    Min = value;
+    CountOfMin = 1;
+  }
+  else if (value == Min)
+  {
+    ++CountOfMin;
+  }
+  else if (value < SecondMin)
+  {
+    SecondMin = value;
+  }
+
+  // update max
+  if (value > Max)
+  {
+    SecondMax = Max;
+    Max = value;
+    CountOfMax = 1;
+  }
+  else if (value == Max)
+  {
+    ++CountOfMax;
+  }
+  else if (value > SecondMax)
+  {
+    SecondMax = value;
+  }
+}
+
+void mitk::ImageStatisticsHolder::Extrema::Merge(const Extrema &other)
+{
+  if (other.Min < Min)
+  {
+    SecondMin = std::min(Min, other.SecondMin);
+    Min = other.Min;
+    CountOfMin = other.CountOfMin;
+  }
+  else if (other.Min == Min)
+  {
+    SecondMin = std::min(SecondMin, other.SecondMin);
+    CountOfMin += other.CountOfMin;
+  }
+  else
+  {
+    SecondMin = std::min(SecondMin, other.Min);
+  }
+
+  if (other.Max > Max)
+  {
+    SecondMax = std::max(Max, other.SecondMax);
+    Max = other.Max;
+    CountOfMax = other.CountOfMax;
+  }
+  else if (other.Max == Max)
+  {
+    SecondMax = std::max(SecondMax, other.SecondMax);
+    CountOfMax += other.CountOfMax;
+  }
+  else
+  {
+    SecondMax = std::max(SecondMax, other.Max);
+  }
+}
+
+mitk::ImageStatisticsHolder::TimeStepBlocks &mitk::ImageStatisticsHolder::GetTimeStepBlocks(
+  int t, const void *buffer, unsigned int numberOfBlocks, std::size_t pixelsPerBlock, unsigned int component)
+{
+  if (static_cast<std::size_t>(t) >= m_TimeStepBlocks.size())
+    m_TimeStepBlocks.resize(t + 1);
+
+  const std::size_t blockSize = pixelsPerBlock * m_Image->GetPixelType(0).GetSize();
+
+  auto &blocks = m_TimeStepBlocks[t];
+  if (blocks.Buffer != buffer || blocks.BlockSize != blockSize || blocks.Blocks.size() != numberOfBlocks ||
+      blocks.Component != component)
+  {
+    blocks.Buffer = buffer;
+    blocks.BlockSize = blockSize;
+    blocks.Component = component;
+    blocks.Blocks.assign(numberOfBlocks, Extrema());
+    blocks.Dirty.assign(numberOfBlocks, true);
+  }
+  return blocks;
+}
+
+void mitk::ImageStatisticsHolder::MergeTimeStepBlocks(int t)
+{
+  Extrema extrema;
+  for (const auto &block : m_TimeStepBlocks[t].Blocks)
+  {
+    extrema.Merge(block);
+  }
+
+  //// guard for wrong 2dMin/Max on single constant value images
+  if (extrema.Max == extrema.Min)
+  {
+    extrema.SecondMax = extrema.SecondMin = extrema.Max;
+  }
+
+  m_ScalarMin[t] = extrema.Min;
+  m_ScalarMax[t] = extrema.Max;
+  m_Scalar2ndMin[t] = extrema.SecondMin;
+  m_Scalar2ndMax[t] = extrema.SecondMax;
+  m_CountOfMinValuedVoxels[t] = extrema.CountOfMin;
+  m_CountOfMaxValuedVoxels[t] = extrema.CountOfMax;
+}
+
+void mitk::ImageStatisticsHolder::RegisterWrittenRange(const void *begin, const void *end)
+{
+  // a handful of ranges is typical (e.g. one slice per stroke); beyond that tracking does not pay off anymore
+  constexpr std::size_t MAXIMUM_NUMBER_OF_WRITTEN_RANGES = 64;
+
+  std::lock_guard<std::mutex> lock(m_WrittenRangesMutex);
+  if (m_AllBlocksWritten)
+    return;
+
+  if (m_WrittenRanges.size() >= MAXIMUM_NUMBER_OF_WRITTEN_RANGES)
+  {
+    m_WrittenRanges.clear();
+    m_AllBlocksWritten = true;
+    return;
+  }
+
+  m_WrittenRanges.emplace_back(static_cast<const unsigned char *>(begin), static_cast<const unsigned char *>(end));
+}
+
+void mitk::ImageStatisticsHolder::InvalidateAllBlocks()
+{
+  std::lock_guard<std::mutex> lock(m_WrittenRangesMutex);
+  m_WrittenRanges.clear();
+  m_AllBlocksWritten = true;
+}
+
+void mitk::ImageStatisticsHolder::ApplyWrittenRanges()
+{
+  std::vector<std::pair<const unsigned char *, const unsigned char *>> writtenRanges;
+  bool allBlocksWritten = false;
+  {
+    std::lock_guard<std::mutex> lock(m_WrittenRangesMutex);
+    writtenRanges.swap(m_WrittenRanges);
+    // the image was modified without any write accessor, so we cannot know what changed
+    allBlocksWritten = m_AllBlocksWritten || writtenRanges.empty();
+    m_AllBlocksWritten = false;
+  }
+
+  for (auto &blocks : m_TimeStepBlocks)
+  {
+    if (allBlocksWritten || blocks.BlockSize == 0)
+    {
+      blocks.Dirty.assign(blocks.Blocks.size(), true);
+      continue;
+    }
+
+    const auto *blocksBegin = static_cast<const unsigned char *>(blocks.Buffer);
+    const auto *blocksEnd = blocksBegin + blocks.BlockSize * blocks.Blocks.size();
+
+    for (const auto &range : writtenRanges)
+    {
+      if (range.first < blocksEnd && range.second > blocksBegin)
+      {
+        const std::size_t firstBlock = (std::max(range.first, blocksBegin) - blocksBegin) / blocks.BlockSize;
+        const std::size_t lastBlock = (std::min(range.second, blocksEnd) - blocksBegin - 1) / blocks.BlockSize;
+        for (std::size_t block = firstBlock; block <= lastBlock; ++block)
+        {
+          blocks.Dirty[block] = true;
+        }
+      }
+    }
+  }
+}
+
 /// \cond SKIP_DOXYGEN
 template <typename ItkImageType>
 void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageStatisticsHolder *statisticsHolder, int t)
@@ -107,70 +286,42 @@ void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageSt
   if (region != itkImage->GetRequestedRegion())
     return;
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
-  typedef typename ItkImageType::PixelType TPixel;
-  TPixel value = 0;
-
   if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
     return;
   statisticsHolder->Expand(t + 1); // make sure we have initialized all arrays
-  statisticsHolder->m_CountOfMinValuedVoxels[t] = 0;
-  statisticsHolder->m_CountOfMaxValuedVoxels[t] = 0;
 
-  statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t] = itk::NumericTraits<ScalarType>::max();
-  statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
-    itk::NumericTraits<ScalarType>::NonpositiveMin();
+  if (region.GetNumberOfPixels() == 0)
+    return;
+
+  // one block per slice of the highest dimension
+  constexpr unsigned int blockDimension = ItkImageType::ImageDimension - 1;
+  const auto numberOfBlocks = static_cast<unsigned int>(region.GetSize(blockDimension));
+  auto &blocks = statisticsHolder->GetTimeStepBlocks(
+    t, itkImage->GetBufferPointer(), numberOfBlocks, region.GetNumberOfPixels() / numberOfBlocks, 0);
 
-  while (!it.IsAtEnd())
+  for (unsigned int block = 0; block < numberOfBlocks; ++block)
   {
-    value = it.Get();
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
-    {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
+    if (!blocks.Dirty[block])
+      continue;
 
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
+    auto blockRegion = region;
+    blockRegion.SetIndex(blockDimension, region.GetIndex(blockDimension) + block);
+    blockRegion.SetSize(blockDimension, 1);
+
+    mitk::ImageStatisticsHolder::Extrema extrema;
+    for (itk::ImageRegionConstIterator<ItkImageType> it(itkImage, blockRegion); !it.IsAtEnd(); ++it)
+    {
 #ifdef BOUNDINGOBJECT_IGNORE
-    }
+      if (it.Get() > -32765)
 #endif
+        extrema.Add(it.Get());
+    }
 
-    ++it;
+    blocks.Blocks[block] = extrema;
+    blocks.Dirty[block] = false;
   }
 
-  //// guard for wrong 2dMin/Max on single constant value images
-  if (statisticsHolder->m_ScalarMax[t] == statisticsHolder->m_ScalarMin[t])
-  {
-    statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMax[t];
-  }
+  statisticsHolder->MergeTimeStepBlocks(t);
   statisticsHolder->m_LastRecomputeTimeStamp.Modified();
 }
 /// \endcond SKIP_DOXYGEN
@@ -189,68 +340,43 @@ void mitk::_ComputeExtremaInItkVectorImage(const ItkImageType *itkImage,
   if (region != itkImage->GetRequestedRegion())
     return;
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
-
   if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
     return;
   statisticsHolder->Expand(t + 1); // make sure we have initialized all arrays
-  statisticsHolder->m_CountOfMinValuedVoxels[t] = 0;
-  statisticsHolder->m_CountOfMaxValuedVoxels[t] = 0;
 
-  statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t] = itk::NumericTraits<ScalarType>::max();
-  statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
-    itk::NumericTraits<ScalarType>::NonpositiveMin();
+  if (region.GetNumberOfPixels() == 0)
+    return;
+
+  // one block per slice of the highest dimension
+  constexpr unsigned int blockDimension = ItkImageType::ImageDimension - 1;
+  const auto numberOfBlocks = static_cast<unsigned int>(region.GetSize(blockDimension));
+  auto &blocks = statisticsHolder->GetTimeStepBlocks(
+    t, itkImage->GetBufferPointer(), numberOfBlocks, region.GetNumberOfPixels() / numberOfBlocks, component);
 
-  while (!it.IsAtEnd())
+  for (unsigned int block = 0; block < numberOfBlocks; ++block)
   {
-    double value = it.Get()[component];
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
-    {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
+    if (!blocks.Dirty[block])
+      continue;
 
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
+    auto blockRegion = region;
+    blockRegion.SetIndex(blockDimension, region.GetIndex(blockDimension) + block);
+    blockRegion.SetSize(blockDimension, 1);
+
+    mitk::ImageStatisticsHolder::Extrema extrema;
+    for (itk::ImageRegionConstIterator<ItkImageType> it(itkImage, blockRegion); !it.IsAtEnd(); ++it)
+    {
+      double value = it.Get()[component];
 #ifdef BOUNDINGOBJECT_IGNORE
-    }
+      if (value > -32765)
 #endif
+        extrema.Add(value);
+    }
 
-    ++it;
+    blocks.Blocks[block] = extrema;
+    blocks.Dirty[block] = false;
   }
 
-  //// guard for wrong 2dMin/Max on single constant value images
-  if (statisticsHolder->m_ScalarMax[t] == statisticsHolder->m_ScalarMin[t])
-  {
-    statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMax[t];
-  }
+  statisticsHolder->MergeTimeStepBlocks(t);
   statisticsHolder->m_LastRecomputeTimeStamp.Modified();
 }
 /// \endcond SKIP_DOXYGEN
@@ -262,7 +388,10 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
 
   // image modified?
   if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+  {
     this->ResetImageStatistics();
+    this->ApplyWrittenRanges();
+  }
 
   Expand(t + 1);
 
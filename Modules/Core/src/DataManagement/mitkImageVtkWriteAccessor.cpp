@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkImageVtkWriteAccessor.h"
 
 #include "mitkImage.h"
+#include "mitkImageStatisticsHolder.h"
 
 #include <vtkImageData.h>
 
@@ -46,6 +47,12 @@ mitk::ImageVtkWriteAccessor::~ImageVtkWriteAccessor()
   // printf("m_VtkReaders.size(): %d\n", (int) m_Image->m_VtkReaders.size());
 
   m_Image->m_VtkReadersLock.unlock();
+
+  // the written part of the vtkImageData is unknown
+  if (m_Image->GetStatistics() != nullptr)
+  {
+    m_Image->GetStatistics()->InvalidateAllBlocks();
+  }
 }
 
 vtkImageData *mitk::ImageVtkWriteAccessor::GetVtkImageData() const
@@ -11,12 +11,24 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageWriteAccessor.h"
+#include "mitkImageStatisticsHolder.h"
 
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
 
 {
-  OrganizeWriteAccess();
+  // from now on, read accessors do not use the shared read slots of the image anymore
+  m_Image->m_PendingWriterCount.fetch_add(1);
+
+  try
+  {
+    OrganizeWriteAccess();
+  }
+  catch (...)
+  {
+    m_Image->m_PendingWriterCount.fetch_sub(1);
+    throw;
+  }
 }
 
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
@@ -24,6 +36,12 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
   // In case of non-coherent memory, copied area needs to be written back
   // TODO
 
+  // let the statistics only recompute the part of the image that was written
+  if (m_Image->GetStatistics() != nullptr)
+  {
+    m_Image->GetStatistics()->RegisterWrittenRange(m_AddressBegin, m_AddressEnd);
+  }
+
   m_Image->m_ReadWriteLock.lock();
 
   // delete self from list of ImageReadAccessors in Image
@@ -41,6 +59,8 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
     m_WaitLock->m_Mutex.unlock();
   }
 
+  m_Image->m_PendingWriterCount.fetch_sub(1);
+
   m_Image->m_ReadWriteLock.unlock();
 }
 
@@ -108,6 +128,76 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
     }   // for
   }     // if
 
+  // Check the read accessors that registered in a shared read slot instead of the list of readers
+  const ImageAccessorSharedReadSlot *overlapSlot = nullptr;
+  std::uint64_t overlapSlotState = 0;
+
+  unsigned int slotIndex = 0;
+  while (!readOverlap && !writeOverlap && overlapSlot == nullptr && slotIndex < Image::NUMBER_OF_SHARED_READ_SLOTS)
+  {
+    const auto &slot = m_Image->m_SharedReadSlots[slotIndex];
+
+    // a reader that claimed the slot publishes its region within a few instructions
+    auto state = slot.m_State.load();
+    while ((state & ImageAccessorSharedReadSlot::SlotClaimed) != 0)
+    {
+      std::this_thread::yield();
+      state = slot.m_State.load();
+    }
+
+    if ((state & ImageAccessorSharedReadSlot::SlotOccupied) == 0)
+    {
+      ++slotIndex;
+      continue;
+    }
+
+    const void *begin = slot.m_AddressBegin.load();
+    const void *end = slot.m_AddressEnd.load();
+    const auto thread = slot.m_Thread.load();
+
+    // the slot was released or reused while its region was read, check it again
+    if (slot.m_State.load() != state)
+      continue;
+
+    if (Overlap(begin, end))
+    {
+      if (thread == std::this_thread::get_id())
+      {
+        m_Image->m_ReadWriteLock.unlock();
+        mitkThrow()
+          << "Prohibited image access: the requested image part is already in use and cannot be requested recursively!";
+      }
+
+      overlapSlot = &slot;
+      overlapSlotState = state;
+    }
+
+    ++slotIndex;
+  }
+
+  if (overlapSlot != nullptr)
+  {
+    if (!(m_Options & ExceptionIfLocked))
+    {
+      // WAIT until the reader releases the slot
+      m_Image->m_AccessorWaitCount.fetch_add(1, std::memory_order_relaxed);
+      std::unique_lock<std::mutex> lock(m_Image->m_ReadWriteLock, std::adopt_lock);
+      m_Image->m_SharedReadReleased.wait(lock, [&] { return overlapSlot->m_State.load() != overlapSlotState; });
+      lock.unlock();
+
+      // after waiting for the ImageAccessor, start this method again
+      OrganizeWriteAccess();
+      return;
+    }
+    else
+    {
+      // THROW EXCEPTION
+      m_Image->m_ReadWriteLock.unlock();
+      mitkThrowException(mitk::MemoryIsLockedException)
+        << "The image part being ordered by the ImageAccessor is already in use and locked";
+    }
+  }
+
   if (readOverlap || writeOverlap)
   {
     // Throw an exception or wait for the WriteAccessor w until it is released and start again with the request
@@ -116,6 +206,7 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
     {
       // WAIT
       overlapLock->m_WaiterCount += 1;
+      m_Image->m_AccessorWaitCount.fetch_add(1, std::memory_order_relaxed);
       m_Image->m_ReadWriteLock.unlock();
       ImageAccessorBase::WaitForReleaseOf(overlapLock);
 
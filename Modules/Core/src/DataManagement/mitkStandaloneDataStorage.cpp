@@ -12,14 +12,21 @@ found in the LICENSE file.
 
 #include "mitkStandaloneDataStorage.h"
 
+#include "mitkBaseData.h"
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateDataUID.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 
+#include <itkCommand.h>
+
 mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
 {
+  m_IndexedPropertyKeys.insert("name");
 }
 
 mitk::StandaloneDataStorage::~StandaloneDataStorage()
@@ -28,6 +35,12 @@ mitk::StandaloneDataStorage::~StandaloneDataStorage()
   {
     this->RemoveListeners(it->first);
   }
+
+  // the observed properties may live longer than this StandaloneDataStorage
+  std::lock_guard<std::mutex> indexLocked(m_IndexMutex);
+  for (auto &observer : m_PropertyObservers)
+    observer.second.Property->RemoveObserver(observer.second.Tag);
+  m_PropertyObservers.clear();
 }
 
 bool mitk::StandaloneDataStorage::IsInitialized() const
@@ -79,6 +92,11 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    std::lock_guard<std::mutex> indexLocked(m_IndexMutex);
+    const auto entry = CreateIndexEntry(node, m_IndexedPropertyKeys);
+    this->InsertIntoIndices(node, entry);
+    this->UpdatePropertyObservers(node, PropertyMap(), entry.Properties);
   }
 
   /* Notify observers */
@@ -110,6 +128,12 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
     /* remove node from both relation adjacency lists */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
+
+    std::lock_guard<std::mutex> indexLocked(m_IndexMutex);
+    auto entryIter = m_IndexEntries.find(node);
+    if (entryIter != m_IndexEntries.end())
+      this->UpdatePropertyObservers(node, entryIter->second.Properties, PropertyMap());
+    this->RemoveFromIndices(node);
   }
 }
 
@@ -249,6 +273,320 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetDe
   return this->GetRelations(node, m_DerivedNodes, condition, onlyDirectDerivations);
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubset(
+  const NodePredicateBase *condition) const
+{
+  if (condition == nullptr)
+    return Superclass::GetSubset(condition);
+
+  std::vector<mitk::DataNode::Pointer> candidates;
+  bool indexed = false;
+  {
+    std::lock_guard<std::mutex> locked(m_IndexMutex);
+    NodeSet indexedCandidates;
+    indexed = this->GetIndexedCandidates(condition, indexedCandidates);
+
+    candidates.reserve(indexedCandidates.size());
+    for (const auto *node : indexedCandidates)
+      candidates.emplace_back(const_cast<mitk::DataNode *>(node));
+  }
+
+  /* GetAll() locks m_Mutex and the condition may cause modified events, so neither happens under m_IndexMutex */
+  if (!indexed)
+    return Superclass::GetSubset(condition);
+
+  /* the indices only preselect the nodes, the condition decides (e.g. the other parts of a conjunction) */
+  mitk::DataStorage::SetOfObjects::Pointer result = mitk::DataStorage::SetOfObjects::New();
+  for (const auto &node : candidates)
+    if (condition->CheckNode(node))
+      result->InsertElement(result->Size(), node);
+
+  return SetOfObjects::ConstPointer(result);
+}
+
+void mitk::StandaloneDataStorage::AddIndexedPropertyKey(const std::string &propertyKey)
+{
+  if (propertyKey.empty())
+    throw std::invalid_argument("invalid property key");
+
+  std::lock_guard<std::mutex> locked(m_IndexMutex);
+  if (!m_IndexedPropertyKeys.insert(propertyKey).second)
+    return;
+
+  auto &valueIndex = m_PropertyValueIndex[propertyKey];
+  auto &keyIndex = m_PropertyKeyIndex[propertyKey];
+  auto &dataPropertyIndex = m_DataPropertyCandidates[propertyKey];
+  for (auto &indexEntry : m_IndexEntries)
+  {
+    auto *property = indexEntry.first->GetProperty(propertyKey.c_str(), nullptr, false);
+    if (property == nullptr)
+    {
+      if (indexEntry.second.HasData)
+        dataPropertyIndex.insert(indexEntry.first);
+      continue;
+    }
+
+    const auto value = property->GetValueAsString();
+    indexEntry.second.PropertyValues[propertyKey] = value;
+    valueIndex[value].insert(indexEntry.first);
+    keyIndex.insert(indexEntry.first);
+
+    PropertyMap newProperties;
+    newProperties[propertyKey] = property;
+    this->UpdatePropertyObservers(indexEntry.first, PropertyMap(), newProperties);
+    indexEntry.second.Properties[propertyKey] = property;
+  }
+}
+
+std::vector<std::string> mitk::StandaloneDataStorage::GetIndexedPropertyKeys() const
+{
+  std::lock_guard<std::mutex> locked(m_IndexMutex);
+  return std::vector<std::string>(m_IndexedPropertyKeys.cbegin(), m_IndexedPropertyKeys.cend());
+}
+
+void mitk::StandaloneDataStorage::OnNodeChanged(const mitk::DataNode *node)
+{
+  std::set<std::string> propertyKeys;
+  {
+    std::lock_guard<std::mutex> locked(m_IndexMutex);
+    if (m_IndexEntries.find(node) == m_IndexEntries.end())
+      return;
+    propertyKeys = m_IndexedPropertyKeys;
+  }
+
+  /* reading the node may cause further modified events, so do it without the lock */
+  const auto entry = CreateIndexEntry(node, propertyKeys);
+
+  std::lock_guard<std::mutex> locked(m_IndexMutex);
+  // the node may have been removed meanwhile or a property key added (then it has already been indexed)
+  if (m_IndexEntries.find(node) == m_IndexEntries.end() || propertyKeys != m_IndexedPropertyKeys)
+    return;
+
+  const auto oldProperties = m_IndexEntries[node].Properties;
+  this->RemoveFromIndices(node);
+  this->InsertIntoIndices(node, entry);
+  this->UpdatePropertyObservers(node, oldProperties, entry.Properties);
+}
+
+void mitk::StandaloneDataStorage::OnIndexedPropertyModified(const itk::Object *caller, const itk::EventObject &)
+{
+  std::vector<mitk::DataNode::ConstPointer> nodes;
+  {
+    std::lock_guard<std::mutex> locked(m_IndexMutex);
+    auto observerIter = m_PropertyObservers.find(dynamic_cast<const mitk::BaseProperty *>(caller));
+    if (observerIter == m_PropertyObservers.end())
+      return;
+
+    const auto &observedNodes = observerIter->second.Nodes;
+    for (auto nodeIter = observedNodes.cbegin(); nodeIter != observedNodes.cend();
+         nodeIter = observedNodes.upper_bound(*nodeIter))
+      nodes.emplace_back(*nodeIter);
+  }
+
+  /* OnNodeChanged() reads the node, which may cause further modified events, so do it without the lock */
+  for (const auto &node : nodes)
+    this->OnNodeChanged(node);
+}
+
+mitk::StandaloneDataStorage::NodeIndexEntry mitk::StandaloneDataStorage::CreateIndexEntry(
+  const mitk::DataNode *node, const std::set<std::string> &propertyKeys)
+{
+  NodeIndexEntry entry;
+
+  const auto *data = node->GetData();
+  if (data != nullptr)
+  {
+    entry.HasData = true;
+    entry.DataType = data->GetNameOfClass();
+    entry.DataUID = data->GetUID();
+  }
+
+  for (const auto &key : propertyKeys)
+  {
+    // only the node's own properties, changes of the properties of the data send no modified event of the node
+    auto *property = node->GetProperty(key.c_str(), nullptr, false);
+    if (property != nullptr)
+    {
+      entry.PropertyValues[key] = property->GetValueAsString();
+      entry.Properties[key] = property;
+    }
+  }
+
+  return entry;
+}
+
+void mitk::StandaloneDataStorage::InsertIntoIndices(const mitk::DataNode *node, const NodeIndexEntry &entry)
+{
+  if (entry.HasData)
+  {
+    m_DataTypeIndex[entry.DataType].insert(node);
+    m_DataUIDIndex[entry.DataUID].insert(node);
+  }
+
+  for (const auto &propertyValue : entry.PropertyValues)
+  {
+    m_PropertyKeyIndex[propertyValue.first].insert(node);
+    m_PropertyValueIndex[propertyValue.first][propertyValue.second].insert(node);
+  }
+
+  if (entry.HasData)
+  {
+    for (const auto &key : m_IndexedPropertyKeys)
+      if (entry.PropertyValues.count(key) == 0)
+        m_DataPropertyCandidates[key].insert(node);
+  }
+
+  m_IndexEntries[node] = entry;
+}
+
+void mitk::StandaloneDataStorage::RemoveFromIndices(const mitk::DataNode *node)
+{
+  auto entryIter = m_IndexEntries.find(node);
+  if (entryIter == m_IndexEntries.end())
+    return;
+
+  /* remove node from a set of an index and the set from the index if it got empty */
+  auto removeFrom = [node](std::map<std::string, NodeSet> &index, const std::string &key) {
+    auto indexIter = index.find(key);
+    if (indexIter == index.end())
+      return;
+    indexIter->second.erase(node);
+    if (indexIter->second.empty())
+      index.erase(indexIter);
+  };
+
+  const auto &entry = entryIter->second;
+  if (entry.HasData)
+  {
+    removeFrom(m_DataTypeIndex, entry.DataType);
+    removeFrom(m_DataUIDIndex, entry.DataUID);
+  }
+
+  for (const auto &propertyValue : entry.PropertyValues)
+  {
+    m_PropertyKeyIndex[propertyValue.first].erase(node);
+    removeFrom(m_PropertyValueIndex[propertyValue.first], propertyValue.second);
+  }
+
+  for (auto &dataPropertyIndex : m_DataPropertyCandidates)
+    dataPropertyIndex.second.erase(node);
+
+  m_IndexEntries.erase(entryIter);
+}
+
+void mitk::StandaloneDataStorage::UpdatePropertyObservers(const mitk::DataNode *node,
+                                                          const PropertyMap &oldProperties,
+                                                          const PropertyMap &newProperties)
+{
+  /* unchanged properties keep their observer, it may be the one that is executed right now */
+  auto isUnchanged = [](const PropertyMap &properties, const PropertyMap::value_type &property) {
+    auto iter = properties.find(property.first);
+    return iter != properties.end() && iter->second == property.second;
+  };
+
+  for (const auto &oldProperty : oldProperties)
+  {
+    if (isUnchanged(newProperties, oldProperty))
+      continue;
+
+    auto observerIter = m_PropertyObservers.find(oldProperty.second);
+    if (observerIter == m_PropertyObservers.end())
+      continue;
+
+    auto &observer = observerIter->second;
+    auto nodeIter = observer.Nodes.find(node);
+    if (nodeIter != observer.Nodes.end())
+      observer.Nodes.erase(nodeIter);
+
+    if (observer.Nodes.empty())
+    {
+      observer.Property->RemoveObserver(observer.Tag);
+      m_PropertyObservers.erase(observerIter);
+    }
+  }
+
+  for (const auto &newProperty : newProperties)
+  {
+    if (isUnchanged(oldProperties, newProperty))
+      continue;
+
+    auto &observer = m_PropertyObservers[newProperty.second];
+    if (observer.Nodes.empty())
+    {
+      itk::MemberCommand<StandaloneDataStorage>::Pointer propertyModifiedCommand =
+        itk::MemberCommand<StandaloneDataStorage>::New();
+      propertyModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedPropertyModified);
+      observer.Property = newProperty.second;
+      observer.Tag = newProperty.second->AddObserver(itk::ModifiedEvent(), propertyModifiedCommand);
+    }
+    observer.Nodes.insert(node);
+  }
+}
+
+bool mitk::StandaloneDataStorage::GetIndexedCandidates(const NodePredicateBase *condition,
+                                                       NodeSet &candidates) const
+{
+  auto lookUp = [&candidates](const std::map<std::string, NodeSet> &index, const std::string &key) {
+    auto indexIter = index.find(key);
+    if (indexIter != index.end())
+      candidates.insert(indexIter->second.cbegin(), indexIter->second.cend());
+  };
+
+  if (const auto *dataTypePredicate = dynamic_cast<const NodePredicateDataType *>(condition))
+  {
+    lookUp(m_DataTypeIndex, dataTypePredicate->GetValidDataType());
+    return true;
+  }
+
+  if (const auto *dataUIDPredicate = dynamic_cast<const NodePredicateDataUID *>(condition))
+  {
+    lookUp(m_DataUIDIndex, dataUIDPredicate->GetUID());
+    return true;
+  }
+
+  if (const auto *propertyPredicate = dynamic_cast<const NodePredicateProperty *>(condition))
+  {
+    const auto &key = propertyPredicate->GetValidPropertyName();
+    if (propertyPredicate->GetRenderer() != nullptr || m_IndexedPropertyKeys.count(key) == 0)
+      return false;
+
+    if (propertyPredicate->GetValidProperty() == nullptr)
+    {
+      lookUp(m_PropertyKeyIndex, key);
+    }
+    else
+    {
+      // equal properties have the same value string, so the nodes with that string are a superset of the result
+      auto valueIndexIter = m_PropertyValueIndex.find(key);
+      if (valueIndexIter != m_PropertyValueIndex.end())
+        lookUp(valueIndexIter->second, propertyPredicate->GetValidProperty()->GetValueAsString());
+    }
+
+    // the predicate falls back on the properties of the data, which are not indexed
+    lookUp(m_DataPropertyCandidates, key);
+    return true;
+  }
+
+  if (const auto *andPredicate = dynamic_cast<const NodePredicateAnd *>(condition))
+  {
+    /* all parts of a conjunction must be fulfilled, so the smallest indexed part is enough */
+    bool indexed = false;
+    for (const auto &childPredicate : andPredicate->GetPredicates())
+    {
+      NodeSet childCandidates;
+      if (this->GetIndexedCandidates(childPredicate, childCandidates) &&
+          (!indexed || childCandidates.size() < candidates.size()))
+      {
+        candidates.swap(childCandidates);
+        indexed = true;
+      }
+    }
+    return indexed;
+  }
+
+  return false;
+}
+
 void mitk::StandaloneDataStorage::PrintSelf(std::ostream &os, itk::Indent indent) const
 {
   os << indent << "StandaloneDataStorage:\n";
@@ -133,4 +133,10 @@ namespace mitk
     static std::string s("org.mitk.io.Size t");
     return s;
   }
+
+  std::string IOConstants::MEMORY_MAPPED()
+  {
+    static std::string s("org.mitk.io.Memory Mapped");
+    return s;
+  }
 }
@@ -20,15 +20,22 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkMemoryMappedFile.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
+#include <itksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <memory>
 
 namespace mitk
 {
@@ -237,7 +244,304 @@ namespace mitk
     return result;
   };
 
+  /** Maps the pixel data of a detached NRRD header (e.g. .nhdr + .raw) if it is stored uncompressed in a
+   * single file in the byte order of the system. Returns nullptr if the data has to be read.
+   * Data attached to the header is only mapped if allowAttachedData is set, because saving the image to
+   * its own file would overwrite the mapped data (detached data is written compressed to a different file).
+   * Mappings that are only copied from (like for partial reads) can use attached data.
+   * @pre ReadImageInformation() was called on imageIO.*/
+  std::shared_ptr<const MemoryMappedFile> MapDetachedNrrdData(itk::ImageIOBase* imageIO,
+                                                              const std::string& path,
+                                                              bool allowAttachedData = false)
+  {
+    if (std::string(imageIO->GetNameOfClass()) != "NrrdImageIO" || imageIO->GetNumberOfComponents() != 1)
+      return nullptr;
+
+    std::ifstream header(path, std::ios::binary);
+    std::string line;
+    if (!std::getline(header, line) || line.compare(0, 4, "NRRD") != 0)
+      return nullptr;
+
+    std::string encoding, endian, dataFile;
+    long long byteSkip = 0;
+    long long lineSkip = 0;
+    std::streamoff headerLength = -1;
+
+    while (std::getline(header, line))
+    {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      // an empty line ends the header
+      if (line.empty())
+      {
+        headerLength = header.tellg();
+        break;
+      }
+
+      const auto separator = line.find(": ");
+      if (line[0] == '#' || separator == std::string::npos)
+        continue;
+
+      const std::string field = line.substr(0, separator);
+      const std::string value = line.substr(separator + 2);
+
+      if (field == "encoding")
+        encoding = value;
+      else if (field == "endian")
+        endian = value;
+      else if (field == "byte skip" || field == "byteskip")
+        byteSkip = std::stoll(value);
+      else if (field == "line skip" || field == "lineskip")
+        lineSkip = std::stoll(value);
+      else if (field == "data file" || field == "datafile")
+        dataFile = value;
+    }
+
+    // headers without data file are attached, lists and formatted names distribute the data over several files
+    const bool attached = dataFile.empty();
+    if ((attached && (!allowAttachedData || headerLength < 0)) || dataFile == "LIST" ||
+        dataFile.find(' ') != std::string::npos || encoding != "raw" || lineSkip != 0 || byteSkip < -1)
+      return nullptr;
+
+    const bool systemIsLittleEndian = itk::ByteSwapper<char>::SystemIsLittleEndian();
+    if (imageIO->GetComponentSize() > 1 && endian != (systemIsLittleEndian ? "little" : "big"))
+      return nullptr;
+
+    std::string dataPath = path;
+    if (!attached)
+    {
+      dataPath = itksys::SystemTools::FileIsFullPath(dataFile)
+                   ? dataFile
+                   : itksys::SystemTools::GetFilenamePath(path) + "/" + dataFile;
+    }
+
+    const std::uint64_t size = imageIO->GetImageSizeInBytes();
+
+    try
+    {
+      // a byte skip of -1 means that the data is located at the end of the file
+      // (attached data starts after the header)
+      const std::uint64_t offset =
+        byteSkip == -1 ? MemoryMappedFile::GetFileSize(dataPath) - size
+                       : static_cast<std::uint64_t>(byteSkip) + (attached ? static_cast<std::uint64_t>(headerLength) : 0);
+
+      return std::make_shared<MemoryMappedFile>(dataPath, offset, size);
+    }
+    catch (const Exception& e)
+    {
+      MITK_WARN << "Cannot map the data of " << path << ", reading it instead: " << e.GetDescription();
+    }
+    return nullptr;
+  }
+
+  /** Voxels of an image file that are read for an ItkImageIO::PartialReadRequest. Dimensions that the
+   * file does not have are of size 1.*/
+  struct PartOfImageFile
+  {
+    std::array<itk::IndexValueType, 3> Index;
+    std::array<itk::SizeValueType, 3> Size;
+    std::array<unsigned int, 3> Stride;
+    /** Number of read voxels per dimension.*/
+    std::array<itk::SizeValueType, 3> OutputSize;
+    std::vector<TimeStepType> TimeSteps;
+    bool IsWholeImage;
+  };
+
+  PartOfImageFile GetPartOfImageFile(const ItkImageIO::PartialReadRequest& request,
+                                     const std::array<itk::SizeValueType, 4>& fileSize)
+  {
+    PartOfImageFile part;
+    part.IsWholeImage = true;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const auto index = request.Index[i];
+      auto size = request.Size[i];
+
+      if (0 == size && index >= 0 && static_cast<itk::SizeValueType>(index) < fileSize[i])
+        size = fileSize[i] - index;
+
+      if (index < 0 || 0 == size || static_cast<itk::SizeValueType>(index) + size > fileSize[i])
+      {
+        mitkThrow() << "Requested region (index " << index << ", size " << size << ") exceeds dimension " << i
+                    << " of the image (size " << fileSize[i] << ").";
+      }
+
+      if (0 == request.Stride[i])
+        mitkThrow() << "Stride of dimension " << i << " must not be 0.";
+
+      part.Index[i] = index;
+      part.Size[i] = size;
+      part.Stride[i] = request.Stride[i];
+      part.OutputSize[i] = (size + part.Stride[i] - 1) / part.Stride[i];
+      part.IsWholeImage &= 0 == index && size == fileSize[i] && 1 == part.Stride[i];
+    }
+
+    if (request.TimeSteps.empty())
+    {
+      for (TimeStepType t = 0; t < fileSize[3]; ++t)
+        part.TimeSteps.push_back(t);
+    }
+    else
+    {
+      for (std::size_t i = 0; i < request.TimeSteps.size(); ++i)
+      {
+        if (request.TimeSteps[i] >= fileSize[3] || (i > 0 && request.TimeSteps[i] <= request.TimeSteps[i - 1]))
+          mitkThrow() << "Requested time steps must be ascending and less than " << fileSize[3] << ".";
+      }
+
+      part.TimeSteps = request.TimeSteps;
+      part.IsWholeImage &= part.TimeSteps.size() == fileSize[3];
+    }
+
+    return part;
+  }
+
+  /** Copies the read voxels of one slice to target. source points to the first voxel of the part
+   * in the slice, its rows are rowPitch bytes apart.*/
+  void CopyPartOfSlice(const unsigned char* source,
+                       std::size_t rowPitch,
+                       const PartOfImageFile& part,
+                       std::size_t pixelSize,
+                       unsigned char* target)
+  {
+    const std::size_t rowSize = part.OutputSize[0] * pixelSize;
+
+    for (itk::SizeValueType y = 0; y < part.OutputSize[1]; ++y, target += rowSize)
+    {
+      const unsigned char* row = source + y * part.Stride[1] * rowPitch;
+
+      if (1 == part.Stride[0])
+      {
+        std::memcpy(target, row, rowSize);
+        continue;
+      }
+
+      for (itk::SizeValueType x = 0; x < part.OutputSize[0]; ++x)
+        std::memcpy(target + x * pixelSize, row + x * part.Stride[0] * pixelSize, pixelSize);
+    }
+  }
+
+  /** Reads the voxels of part into buffer (time step major, then z, y and x).
+   * The voxels are copied from mapped raw NRRD data if possible. Otherwise the requested rows of each
+   * slice are read by imageIO, if it supports streaming. Only if neither is possible, the whole image
+   * is read and the part is copied from it.
+   * @pre ReadImageInformation() was called on imageIO.*/
+  void ReadPartOfImageFile(itk::ImageIOBase* imageIO,
+                           const std::string& path,
+                           const std::array<itk::SizeValueType, 4>& fileSize,
+                           const PartOfImageFile& part,
+                           unsigned char* buffer)
+  {
+    const unsigned int fileDimension = imageIO->GetNumberOfDimensions();
+    const std::size_t pixelSize = imageIO->GetComponentSize() * imageIO->GetNumberOfComponents();
+    const std::size_t outputSliceSize = part.OutputSize[0] * part.OutputSize[1] * pixelSize;
+    const std::size_t fileRowPitch = fileSize[0] * pixelSize;
+
+    // offset of the first voxel of the part in slice z of time step t
+    auto getOffset = [&](itk::SizeValueType z, TimeStepType t) {
+      return static_cast<std::size_t>(((t * fileSize[2] + z) * fileSize[1] + part.Index[1]) * fileSize[0] +
+                                      part.Index[0]) * pixelSize;
+    };
+
+    const auto mappedFile = MapDetachedNrrdData(imageIO, path, true);
+    const bool streaming = nullptr == mappedFile && imageIO->CanStreamRead();
+    std::unique_ptr<unsigned char[]> wholeImage;
+    std::vector<unsigned char> slice;
+
+    if (nullptr != mappedFile)
+    {
+      MITK_INFO << "reading part of the image from memory mapped " << mappedFile->GetPath();
+    }
+    else if (streaming)
+    {
+      imageIO->SetUseStreamedReading(true);
+      slice.resize(part.Size[0] * part.Size[1] * pixelSize);
+    }
+    else
+    {
+      MITK_WARN << imageIO->GetNameOfClass() << " cannot read parts of " << path << ". Reading the whole image.";
+
+      itk::ImageIORegion ioRegion(fileDimension);
+      for (unsigned int i = 0; i < fileDimension; ++i)
+        ioRegion.SetSize(i, imageIO->GetDimensions(i));
+
+      imageIO->SetIORegion(ioRegion);
+      wholeImage.reset(new unsigned char[imageIO->GetImageSizeInBytes()]);
+      imageIO->Read(wholeImage.get());
+    }
+
+    for (std::size_t timeStep = 0; timeStep < part.TimeSteps.size(); ++timeStep)
+    {
+      const auto t = part.TimeSteps[timeStep];
+
+      for (itk::SizeValueType sliceIndex = 0; sliceIndex < part.OutputSize[2]; ++sliceIndex)
+      {
+        const auto z = part.Index[2] + sliceIndex * part.Stride[2];
+        const unsigned char* source = nullptr;
+        std::size_t rowPitch = fileRowPitch;
+
+        if (nullptr != mappedFile)
+        {
+          source = static_cast<const unsigned char*>(mappedFile->GetData()) + getOffset(z, t);
+        }
+        else if (streaming)
+        {
+          itk::ImageIORegion ioRegion(fileDimension);
+          for (unsigned int i = 0; i < 2; ++i)
+          {
+            ioRegion.SetIndex(i, part.Index[i]);
+            ioRegion.SetSize(i, part.Size[i]);
+          }
+
+          if (fileDimension > 2)
+          {
+            ioRegion.SetIndex(2, z);
+            ioRegion.SetSize(2, 1);
+          }
+
+          if (fileDimension > 3)
+          {
+            ioRegion.SetIndex(3, t);
+            ioRegion.SetSize(3, 1);
+          }
+
+          imageIO->SetIORegion(ioRegion);
+          imageIO->Read(slice.data());
+          source = slice.data();
+          rowPitch = part.Size[0] * pixelSize;
+        }
+        else
+        {
+          source = wholeImage.get() + getOffset(z, t);
+        }
+
+        CopyPartOfSlice(
+          source, rowPitch, part, pixelSize, buffer + (timeStep * part.OutputSize[2] + sliceIndex) * outputSliceSize);
+      }
+    }
+  }
+
   Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path)
+  {
+    return LoadRawMitkImageFromImageIO(imageIO, path, PartialReadRequest());
+  }
+
+  Image::Pointer ItkImageIO::LoadPartialImage(const std::string& path, const PartialReadRequest& request)
+  {
+    itk::ImageIOBase::Pointer imageIO =
+      itk::ImageIOFactory::CreateImageIO(path.c_str(), itk::IOFileModeEnum::ReadMode);
+
+    if (imageIO.IsNull())
+      mitkThrow() << "Could not find an ITK ImageIO that can read " << path;
+
+    return LoadRawMitkImageFromImageIO(imageIO, path, request);
+  }
+
+  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO,
+                                                         const std::string& path,
+                                                         const PartialReadRequest& request)
   {
     LocaleSwitch localeSwitch("C");
 
@@ -307,13 +611,53 @@ namespace mitk
     ioRegion.SetSize(ioSize);
     ioRegion.SetIndex(ioStart);
 
-    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
-    imageIO->SetIORegion(ioRegion);
-    void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
-    imageIO->Read(buffer);
+    const std::array<itk::SizeValueType, 4> fileSize = {
+      {dimensions[0], dimensions[1], ndim > 2 ? dimensions[2] : 1u, ndim > 3 ? dimensions[3] : 1u}};
+    const auto part = GetPartOfImageFile(request, fileSize);
+
+    if (part.IsWholeImage)
+    {
+      MITK_INFO << "ioRegion: " << ioRegion << std::endl;
+      image->Initialize(MakePixelType(imageIO), ndim, dimensions);
 
-    image->Initialize(MakePixelType(imageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+      // uncompressed data is mapped, so pixels are only loaded from the file when they are accessed
+      auto mappedFile = ndim == imageIO->GetNumberOfDimensions() ? MapDetachedNrrdData(imageIO, path) : nullptr;
+      if (mappedFile != nullptr)
+      {
+        MITK_INFO << "memory mapped " << mappedFile->GetPath();
+        image->SetMappedChannel(mappedFile);
+      }
+      else
+      {
+        imageIO->SetIORegion(ioRegion);
+        void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
+        imageIO->Read(buffer);
+        image->SetImportChannel(buffer, 0, Image::ManageMemory);
+      }
+    }
+    else
+    {
+      if (ndim != imageIO->GetNumberOfDimensions())
+        mitkThrow() << "Parts can only be read from images with " << MINDIM << " to " << MAXDIM << " dimensions.";
+
+      unsigned int partDimensions[MAXDIM];
+      for (i = 0; i < 3; ++i)
+        partDimensions[i] = static_cast<unsigned int>(part.OutputSize[i]);
+      partDimensions[3] = static_cast<unsigned int>(part.TimeSteps.size());
+
+      MITK_INFO << "reading " << partDimensions[0] << "x" << partDimensions[1] << "x" << partDimensions[2] << "x"
+                << partDimensions[3] << " voxels starting at " << part.Index[0] << ", " << part.Index[1] << ", "
+                << part.Index[2] << " with stride " << part.Stride[0] << ", " << part.Stride[1] << ", "
+                << part.Stride[2];
+      image->Initialize(MakePixelType(imageIO), ndim, partDimensions);
+
+      const std::size_t bufferSize = static_cast<std::size_t>(partDimensions[0]) * partDimensions[1] *
+                                     partDimensions[2] * partDimensions[3] * imageIO->GetComponentSize() *
+                                     imageIO->GetNumberOfComponents();
+      std::unique_ptr<unsigned char[]> buffer(new unsigned char[bufferSize]);
+      ReadPartOfImageFile(imageIO, path, fileSize, part, buffer.get());
+      image->SetImportChannel(buffer.release(), 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary& dictionary = imageIO->GetMetaDataDictionary();
 
@@ -325,6 +669,15 @@ namespace mitk
       for (j = 0; j < itkDimMax3; ++j)
         matrix[i][j] = imageIO->GetDirection(j)[i];
 
+    // a part starts at its first voxel and has the spacing of the read voxels
+    Vector3D partOffset;
+    for (i = 0; i < 3; ++i)
+    {
+      partOffset[i] = part.Index[i] * spacing[i];
+      spacing[i] *= part.Stride[i];
+    }
+    origin += matrix * partOffset;
+
     // re-initialize PlaneGeometry with origin and direction
     PlaneGeometry* planeGeometry = image->GetSlicedGeometry(0)->GetPlaneGeometry(0);
     planeGeometry->SetOrigin(origin);
@@ -375,10 +728,10 @@ namespace mitk
         {
           MITK_ERROR << "Stored timepoints are empty. Meta information seems to bee invalid. Switch to ProportionalTimeGeometry fallback";
         }
-        else if (timePoints.size() - 1 != image->GetDimension(3))
+        else if (timePoints.size() - 1 != fileSize[3])
         {
           MITK_ERROR << "Stored timepoints (" << timePoints.size() - 1 << ") and size of image time dimension ("
-            << image->GetDimension(3) << ") do not match. Switch to ProportionalTimeGeometry fallback";
+            << fileSize[3] << ") do not match. Switch to ProportionalTimeGeometry fallback";
         }
         else
         {
@@ -400,13 +753,23 @@ namespace mitk
     { // Fallback. If no other valid time geometry has been created, create a ProportionalTimeGeometry
       MITK_INFO << "used time geometry: " << ProportionalTimeGeometry::GetStaticNameOfClass();
       ProportionalTimeGeometry::Pointer propTimeGeometry = ProportionalTimeGeometry::New();
-      propTimeGeometry->Initialize(slicedGeometry, image->GetDimension(3));
+      propTimeGeometry->Initialize(slicedGeometry, fileSize[3]);
       timeGeometry = propTimeGeometry;
     }
 
+    if (part.TimeSteps.size() != fileSize[3])
+    { // keep the time bounds of the read time steps
+      ArbitraryTimeGeometry::Pointer partTimeGeometry = ArbitraryTimeGeometry::New();
+      for (const auto timeStep : part.TimeSteps)
+      {
+        const auto timeBounds = timeGeometry->GetTimeBounds(timeStep);
+        partTimeGeometry->AppendNewTimeStepClone(slicedGeometry, timeBounds[0], timeBounds[1]);
+      }
+      timeGeometry = partTimeGeometry;
+    }
+
     image->SetTimeGeometry(timeGeometry);
 
-    buffer = nullptr;
     MITK_INFO << "number of image components: " << image->GetPixelType().GetNumberOfComponents();
     return image;
   }
@@ -0,0 +1,140 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryMappedFile.h"
+
+#include <mitkExceptionMacro.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  /** Mappings have to start at a multiple of this value.*/
+  std::uint64_t GetMappingGranularity()
+  {
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwAllocationGranularity;
+#else
+    return static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+}
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string &path, std::uint64_t offset, std::uint64_t length)
+  : m_Path(path), m_Offset(offset), m_Length(length), m_Data(nullptr), m_MappedAddress(nullptr), m_MappedLength(0)
+{
+  const auto fileSize = GetFileSize(path);
+
+  if (0 == m_Length && offset < fileSize)
+    m_Length = fileSize - offset;
+
+  if (0 == m_Length || offset > fileSize || m_Length > fileSize - offset)
+  {
+    mitkThrow() << "Cannot map " << m_Length << " bytes at offset " << offset << " of file \"" << path
+                << "\" with size " << fileSize << ".";
+  }
+
+  const auto granularity = GetMappingGranularity();
+  const auto mappedOffset = offset - offset % granularity;
+  const auto delta = offset - mappedOffset;
+  m_MappedLength = m_Length + delta;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open file \"" << path << "\" for mapping (error " << GetLastError() << ").";
+
+  // PAGE_WRITECOPY allows writing to the view without changing the file
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  const auto mappingError = GetLastError();
+  CloseHandle(file);
+
+  if (nullptr == mapping)
+    mitkThrow() << "Cannot create file mapping of \"" << path << "\" (error " << mappingError << ").";
+
+  m_MappedAddress = MapViewOfFile(mapping,
+                                  FILE_MAP_COPY,
+                                  static_cast<DWORD>(mappedOffset >> 32),
+                                  static_cast<DWORD>(mappedOffset & 0xFFFFFFFF),
+                                  static_cast<SIZE_T>(m_MappedLength));
+  const auto viewError = GetLastError();
+
+  // the view keeps the mapping object alive
+  CloseHandle(mapping);
+
+  if (nullptr == m_MappedAddress)
+    mitkThrow() << "Cannot map view of file \"" << path << "\" (error " << viewError << ").";
+#else
+  const int fileDescriptor = open(path.c_str(), O_RDONLY);
+  if (-1 == fileDescriptor)
+    mitkThrow() << "Cannot open file \"" << path << "\" for mapping: " << std::strerror(errno);
+
+  // MAP_PRIVATE makes the mapping copy-on-write, so writing never changes the file
+  void *address = mmap(nullptr,
+                       static_cast<std::size_t>(m_MappedLength),
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE,
+                       fileDescriptor,
+                       static_cast<off_t>(mappedOffset));
+  const int mapError = errno;
+
+  // the mapping keeps its own reference to the file
+  close(fileDescriptor);
+
+  if (MAP_FAILED == address)
+    mitkThrow() << "Cannot map file \"" << path << "\": " << std::strerror(mapError);
+
+  m_MappedAddress = address;
+#endif
+
+  m_Data = static_cast<unsigned char *>(m_MappedAddress) + delta;
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  if (nullptr == m_MappedAddress)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_MappedAddress);
+#else
+  munmap(m_MappedAddress, static_cast<std::size_t>(m_MappedLength));
+#endif
+}
+
+std::uint64_t mitk::MemoryMappedFile::GetFileSize(const std::string &path)
+{
+#ifdef _WIN32
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes))
+    mitkThrow() << "Cannot access file \"" << path << "\" (error " << GetLastError() << ").";
+
+  return (static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+#else
+  struct stat fileStatus;
+  if (0 != stat(path.c_str(), &fileStatus))
+    mitkThrow() << "Cannot access file \"" << path << "\": " << std::strerror(errno);
+
+  return static_cast<std::uint64_t>(fileStatus.st_size);
+#endif
+}
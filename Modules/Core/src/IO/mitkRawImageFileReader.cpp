@@ -15,6 +15,9 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 #include "mitkITKImageImport.h"
 #include "mitkImageCast.h"
+#include "mitkMemoryMappedFile.h"
+
+#include <itkByteSwapper.h>
 
 #include <itkImage.h>
 #include <itkImageFileReader.h>
@@ -55,6 +58,8 @@ mitk::RawImageFileReaderService::RawImageFileReaderService()
   defaultOptions[IOConstants::SIZE_Z()] = 0;
   // defaultOptions[IOConstants::SIZE_T()] = 0;
 
+  defaultOptions[IOConstants::MEMORY_MAPPED()] = false;
+
   this->SetDefaultOptions(defaultOptions);
 
   this->RegisterService();
@@ -84,25 +89,27 @@ std::vector<itk::SmartPointer<mitk::BaseData>> mitk::RawImageFileReaderService::
   dimensions[2] = us::any_cast<int>(options.find(IOConstants::SIZE_Z())->second);
   dimensions[3] = 0; // us::any_cast<int>(options.find(IOConstants::SIZE_T())->second);
 
+  const bool memoryMapped = us::any_cast<bool>(options.find(IOConstants::MEMORY_MAPPED())->second);
+
   // check file dimensionality and pixel type and perform reading according to it
   if (dimensionality == "2")
   {
     if (pixelType == IOConstants::PIXEL_TYPE_CHAR())
-      result.push_back(TypedRead<signed char, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed char, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_UCHAR())
-      result.push_back(TypedRead<unsigned char, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned char, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_SHORT())
-      result.push_back(TypedRead<signed short int, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed short int, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_USHORT())
-      result.push_back(TypedRead<unsigned short int, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned short int, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_UINT())
-      result.push_back(TypedRead<unsigned int, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned int, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_INT())
-      result.push_back(TypedRead<signed int, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed int, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_FLOAT())
-      result.push_back(TypedRead<float, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<float, 2>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_DOUBLE())
-      result.push_back(TypedRead<double, 2>(path, endianity, dimensions));
+      result.push_back(TypedRead<double, 2>(path, endianity, dimensions, memoryMapped));
     else
     {
       MITK_INFO << "Error while reading raw file: Dimensionality or pixel type not supported or not properly set"
@@ -112,21 +119,21 @@ std::vector<itk::SmartPointer<mitk::BaseData>> mitk::RawImageFileReaderService::
   else if (dimensionality == "3")
   {
     if (pixelType == IOConstants::PIXEL_TYPE_CHAR())
-      result.push_back(TypedRead<signed char, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed char, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_UCHAR())
-      result.push_back(TypedRead<unsigned char, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned char, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_SHORT())
-      result.push_back(TypedRead<signed short int, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed short int, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_USHORT())
-      result.push_back(TypedRead<unsigned short int, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned short int, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_UINT())
-      result.push_back(TypedRead<unsigned int, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<unsigned int, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_INT())
-      result.push_back(TypedRead<signed int, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<signed int, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_FLOAT())
-      result.push_back(TypedRead<float, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<float, 3>(path, endianity, dimensions, memoryMapped));
     else if (pixelType == IOConstants::PIXEL_TYPE_DOUBLE())
-      result.push_back(TypedRead<double, 3>(path, endianity, dimensions));
+      result.push_back(TypedRead<double, 3>(path, endianity, dimensions, memoryMapped));
     else
     {
       MITK_INFO << "Error while reading raw file: Dimensionality or pixel type not supported or not properly set"
@@ -144,8 +151,19 @@ std::vector<itk::SmartPointer<mitk::BaseData>> mitk::RawImageFileReaderService::
 template <typename TPixel, unsigned int VImageDimensions>
 mitk::BaseData::Pointer mitk::RawImageFileReaderService::TypedRead(const std::string &path,
                                                                    EndianityType endianity,
-                                                                   int *size)
+                                                                   int *size,
+                                                                   bool memoryMapped)
 {
+  if (memoryMapped)
+  {
+    const bool systemIsLittleEndian = itk::ByteSwapper<TPixel>::SystemIsLittleEndian();
+    if (sizeof(TPixel) == 1 || (endianity == LITTLE) == systemIsLittleEndian)
+      return MappedRead<TPixel, VImageDimensions>(path, size);
+
+    MITK_WARN << "Raw file cannot be memory mapped because its endianness differs from the one of the system. "
+                 "Reading it instead.";
+  }
+
   typedef itk::Image<TPixel, VImageDimensions> ImageType;
   typedef itk::ImageFileReader<ImageType> ReaderType;
   typedef itk::RawImageIO<TPixel, VImageDimensions> IOType;
@@ -192,6 +210,23 @@ mitk::BaseData::Pointer mitk::RawImageFileReaderService::TypedRead(const std::st
   return image.GetPointer();
 }
 
+template <typename TPixel, unsigned int VImageDimensions>
+mitk::BaseData::Pointer mitk::RawImageFileReaderService::MappedRead(const std::string &path, int *size)
+{
+  unsigned int dimensions[VImageDimensions];
+  std::uint64_t length = sizeof(TPixel);
+  for (unsigned int dim = 0; dim < VImageDimensions; ++dim)
+  {
+    dimensions[dim] = static_cast<unsigned int>(size[dim]);
+    length *= dimensions[dim];
+  }
+
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->Initialize(mitk::MakeScalarPixelType<TPixel>(), VImageDimensions, dimensions);
+  image->SetMappedChannel(std::make_shared<MemoryMappedFile>(path, 0, length));
+  return image.GetPointer();
+}
+
 mitk::RawImageFileReaderService *mitk::RawImageFileReaderService::Clone() const
 {
   return new RawImageFileReaderService(*this);
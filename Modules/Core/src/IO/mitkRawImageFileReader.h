@@ -20,6 +20,10 @@ namespace mitk
   /**
    * The user must set the dimensionality, the dimensions and the pixel type.
    * If they are incorrect, the image will not be opened or the visualization will be incorrect.
+   *
+   * If the option IOConstants::MEMORY_MAPPED() is set, the file is mapped into memory instead of
+   * being read (see Image::SetMappedChannel()), so only the accessed parts of the file are loaded.
+   * This requires the endianness of the file to match the one of the system, other files are read.
    */
   class RawImageFileReaderService : public AbstractFileReader
   {
@@ -41,7 +45,10 @@ namespace mitk
 
   private:
     template <typename TPixel, unsigned int VImageDimensions>
-    mitk::BaseData::Pointer TypedRead(const std::string &path, EndianityType endianity, int *size);
+    mitk::BaseData::Pointer TypedRead(const std::string &path, EndianityType endianity, int *size, bool memoryMapped);
+
+    template <typename TPixel, unsigned int VImageDimensions>
+    mitk::BaseData::Pointer MappedRead(const std::string &path, int *size);
 
     RawImageFileReaderService *Clone() const override;
   };
@@ -0,0 +1,497 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSliceCache.h"
+
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+
+#include <algorithm>
+#include <set>
+
+namespace
+{
+  /** Planes whose origins and axes differ by less than this (in mm) are considered equal.
+   Positions of prefetched planes are extrapolated and may therefore deviate in the last digits
+   from the planes the slice navigation generates.*/
+  constexpr mitk::ScalarType GEOMETRY_TOLERANCE = 1e-6;
+
+  constexpr std::size_t DEFAULT_CAPACITY = 128 * 1024 * 1024;
+
+  std::size_t GetMemorySize(const mitk::ImageSliceCache::SlicePointer &slice)
+  {
+    // vtkDataObject::GetActualMemorySize() reports kibibytes
+    return nullptr != slice && nullptr != slice->ReslicedImage
+             ? static_cast<std::size_t>(slice->ReslicedImage->GetActualMemorySize()) * 1024
+             : 0;
+  }
+}
+
+mitk::ImageSliceCache::Key::Key(const Image *image,
+                                TimeStepType timeStep,
+                                const PlaneGeometry *plane,
+                                int interpolationMode,
+                                bool inPlaneResampleExtentByGeometry)
+  : SourceImage(image),
+    ImageMTime(image->GetMTime()),
+    TimeGeometryMTime(image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep)->GetMTime()),
+    TimeStep(timeStep),
+    ReferenceGeometry(plane->GetReferenceGeometry()),
+    ReferenceGeometryMTime(nullptr != plane->GetReferenceGeometry() ? plane->GetReferenceGeometry()->GetMTime() : 0),
+    Origin(plane->GetOrigin()),
+    Axis0(plane->GetAxisVector(0)),
+    Axis1(plane->GetAxisVector(1)),
+    Extent0(plane->GetExtent(0)),
+    Extent1(plane->GetExtent(1)),
+    InterpolationMode(interpolationMode),
+    InPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry)
+{
+}
+
+bool mitk::ImageSliceCache::Key::MatchesExceptOrigin(const Key &other) const
+{
+  return SourceImage == other.SourceImage && ImageMTime == other.ImageMTime &&
+         TimeGeometryMTime == other.TimeGeometryMTime && TimeStep == other.TimeStep &&
+         ReferenceGeometry == other.ReferenceGeometry && ReferenceGeometryMTime == other.ReferenceGeometryMTime &&
+         InterpolationMode == other.InterpolationMode &&
+         InPlaneResampleExtentByGeometry == other.InPlaneResampleExtentByGeometry &&
+         Extent0 == other.Extent0 && Extent1 == other.Extent1 &&
+         Equal(Axis0, other.Axis0, GEOMETRY_TOLERANCE) && Equal(Axis1, other.Axis1, GEOMETRY_TOLERANCE);
+}
+
+bool mitk::ImageSliceCache::Key::operator==(const Key &other) const
+{
+  return this->MatchesExceptOrigin(other) && Equal(Origin, other.Origin, GEOMETRY_TOLERANCE);
+}
+
+mitk::ImageSliceCache::ImageSliceCache()
+  : m_Capacity(DEFAULT_CAPACITY),
+    m_Size(0),
+    m_BusyRequester(nullptr),
+    m_BusyRequestCancelled(false),
+    m_PrefetchBusy(false),
+    m_StopPrefetch(false)
+{
+}
+
+mitk::ImageSliceCache::~ImageSliceCache()
+{
+  this->StopPrefetch();
+}
+
+mitk::ImageSliceCache *mitk::ImageSliceCache::GetInstance()
+{
+  // never destroyed, local storages of mappers still cancel their requests during static destruction
+  static ImageSliceCache *instance = []() {
+    auto cache = ImageSliceCache::New();
+    cache->Register();
+    return cache.GetPointer();
+  }();
+  return instance;
+}
+
+mitk::ImageSliceCache::SlicePointer mitk::ImageSliceCache::CreateSlice(ExtractSliceFilter *reslicer)
+{
+  auto slice = std::make_shared<Slice>();
+
+  // the output of the reslicer is reused by its next update, so the cache needs its own copy
+  slice->ReslicedImage = vtkSmartPointer<vtkImageData>::New();
+  slice->ReslicedImage->DeepCopy(reslicer->GetVtkOutput());
+
+  slice->ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  slice->ResliceAxes->DeepCopy(reslicer->GetResliceAxes());
+
+  slice->Spacing[0] = reslicer->GetOutputSpacing()[0];
+  slice->Spacing[1] = reslicer->GetOutputSpacing()[1];
+
+  return slice;
+}
+
+mitk::ImageSliceCache::SlicePointer mitk::ImageSliceCache::Find(const Key &key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto finding = std::find_if(m_Entries.begin(), m_Entries.end(), [&key](const EntryType &entry) { return entry.first == key; });
+
+  if (finding == m_Entries.end())
+  {
+    return nullptr;
+  }
+
+  m_Entries.splice(m_Entries.begin(), m_Entries, finding);
+  return finding->second;
+}
+
+void mitk::ImageSliceCache::Insert(const Key &key, const SlicePointer &slice)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto &latestImageMTime = m_LatestImageMTimes[key.SourceImage];
+  if (key.ImageMTime < latestImageMTime)
+  {
+    // a prefetched slice of an image state that has already been replaced
+    return;
+  }
+
+  if (key.ImageMTime > latestImageMTime)
+  {
+    // MTimes are globally unique, so a newer MTime also covers a different image at the same address
+    latestImageMTime = key.ImageMTime;
+    for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+    {
+      if (iter->first.SourceImage == key.SourceImage && iter->first.ImageMTime < latestImageMTime)
+      {
+        m_Size -= GetMemorySize(iter->second);
+        iter = m_Entries.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  auto finding = std::find_if(m_Entries.begin(), m_Entries.end(), [&key](const EntryType &entry) { return entry.first == key; });
+  if (finding != m_Entries.end())
+  {
+    m_Size -= GetMemorySize(finding->second);
+    m_Entries.erase(finding);
+  }
+
+  m_Entries.emplace_front(key, slice);
+  m_Size += GetMemorySize(slice);
+
+  this->EvictToCapacity();
+}
+
+void mitk::ImageSliceCache::EvictToCapacity()
+{
+  // keep at least the most recently used slice, even if it alone exceeds the capacity
+  bool evicted = false;
+  while (m_Size > m_Capacity && m_Entries.size() > 1)
+  {
+    m_Size -= GetMemorySize(m_Entries.back().second);
+    m_Entries.pop_back();
+    evicted = true;
+  }
+
+  if (evicted)
+  {
+    // forget the states of images without cached slices, e.g. of deleted images
+    std::set<const Image *> cachedImages;
+    for (const auto &entry : m_Entries)
+    {
+      cachedImages.insert(entry.first.SourceImage);
+    }
+
+    for (auto iter = m_LatestImageMTimes.begin(); iter != m_LatestImageMTimes.end();)
+    {
+      iter = cachedImages.count(iter->first) == 0 ? m_LatestImageMTimes.erase(iter) : std::next(iter);
+    }
+  }
+}
+
+void mitk::ImageSliceCache::Clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    m_PendingRequests.clear();
+    m_TimeStepImages.clear();
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+  m_LatestImageMTimes.clear();
+  m_Size = 0;
+}
+
+void mitk::ImageSliceCache::SetCapacity(std::size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Capacity = capacity;
+  this->EvictToCapacity();
+}
+
+std::size_t mitk::ImageSliceCache::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Capacity;
+}
+
+std::size_t mitk::ImageSliceCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Size;
+}
+
+std::size_t mitk::ImageSliceCache::GetNumberOfSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+void mitk::ImageSliceCache::Prefetch(const void *requester,
+                                     Image *image,
+                                     TimeStepType timeStep,
+                                     const std::vector<PlaneGeometry::Pointer> &planes,
+                                     int interpolationMode,
+                                     bool inPlaneResampleExtentByGeometry)
+{
+  if (nullptr == image || planes.empty() || !image->IsVolumeSet(timeStep))
+  {
+    return;
+  }
+
+  auto request = std::make_unique<PrefetchRequest>();
+  request->Requester = requester;
+  request->InterpolationMode = interpolationMode;
+  request->InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+
+  for (const auto &plane : planes)
+  {
+    // the reference geometry is copied as well, it is read while reslicing in the background
+    auto planeCopy = plane->Clone();
+    if (nullptr != plane->GetReferenceGeometry())
+    {
+      planeCopy->SetReferenceGeometry(plane->GetReferenceGeometry()->Clone());
+    }
+
+    Key key(image, timeStep, plane, interpolationMode, inPlaneResampleExtentByGeometry);
+    if (nullptr == this->Find(key))
+    {
+      request->Planes.emplace_back(key, planeCopy);
+    }
+  }
+
+  if (request->Planes.empty())
+  {
+    return;
+  }
+
+  TimeStepImageEntry timeStepImage;
+  {
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    auto finding = m_TimeStepImages.find(requester);
+    if (finding != m_TimeStepImages.end())
+    {
+      timeStepImage = finding->second;
+    }
+  }
+
+  if (timeStepImage.TimeStepImage.IsNull() || timeStepImage.Source != image ||
+      timeStepImage.ImageMTime != image->GetMTime() || timeStepImage.TimeStep != timeStep)
+  {
+    // The time step image references the pixel data of the image. Disconnecting it from the pipeline
+    // ensures that updating the reslicer of the background thread does not propagate to the image.
+    auto timeSelector = ImageTimeSelector::New();
+    timeSelector->SetInput(image);
+    timeSelector->SetTimeNr(static_cast<int>(timeStep));
+    timeSelector->UpdateLargestPossibleRegion();
+
+    timeStepImage.TimeStepImage = timeSelector->GetOutput();
+    timeStepImage.TimeStepImage->DisconnectPipeline();
+    // keeps the referenced pixel data alive if the image is re-initialized while reslicing
+    timeStepImage.Volume = image->GetVolumeData(timeStep);
+    timeStepImage.Source = image;
+    timeStepImage.ImageMTime = image->GetMTime();
+    timeStepImage.TimeStep = timeStep;
+  }
+
+  request->SourceImage = image;
+  request->TimeStepImage = timeStepImage.TimeStepImage;
+  request->Volume = timeStepImage.Volume;
+
+  {
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    if (m_StopPrefetch)
+    {
+      return;
+    }
+
+    m_TimeStepImages[requester] = timeStepImage;
+
+    auto pending = std::find_if(m_PendingRequests.begin(),
+                                m_PendingRequests.end(),
+                                [requester](const std::unique_ptr<PrefetchRequest> &pendingRequest)
+                                { return pendingRequest->Requester == requester; });
+    if (pending != m_PendingRequests.end())
+    {
+      *pending = std::move(request);
+    }
+    else
+    {
+      m_PendingRequests.push_back(std::move(request));
+    }
+
+    if (!m_PrefetchThread.joinable())
+    {
+      m_PrefetchThread = std::thread(&ImageSliceCache::PrefetchThreadMain, this);
+    }
+  }
+  m_PrefetchCondition.notify_all();
+}
+
+void mitk::ImageSliceCache::CancelPrefetch(const void *requester)
+{
+  std::unique_ptr<PrefetchRequest> cancelledRequest;
+  TimeStepImageEntry timeStepImage;
+  {
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+
+    auto pending = std::find_if(m_PendingRequests.begin(),
+                                m_PendingRequests.end(),
+                                [requester](const std::unique_ptr<PrefetchRequest> &pendingRequest)
+                                { return pendingRequest->Requester == requester; });
+    if (pending != m_PendingRequests.end())
+    {
+      cancelledRequest = std::move(*pending);
+      m_PendingRequests.erase(pending);
+    }
+
+    if (m_PrefetchBusy && m_BusyRequester == requester)
+    {
+      m_BusyRequestCancelled = true;
+    }
+
+    auto finding = m_TimeStepImages.find(requester);
+    if (finding != m_TimeStepImages.end())
+    {
+      timeStepImage = finding->second;
+      m_TimeStepImages.erase(finding);
+    }
+  }
+  m_PrefetchCondition.notify_all();
+
+  // the referenced image data is released here, without holding the lock
+}
+
+void mitk::ImageSliceCache::WaitForPrefetch()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+  m_PrefetchCondition.wait(lock, [this] { return m_PendingRequests.empty() && !m_PrefetchBusy; });
+}
+
+void mitk::ImageSliceCache::StopPrefetch()
+{
+  std::list<std::unique_ptr<PrefetchRequest>> discardedRequests;
+  {
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    m_StopPrefetch = true;
+    discardedRequests.swap(m_PendingRequests);
+  }
+  m_PrefetchCondition.notify_all();
+
+  if (m_PrefetchThread.joinable() && m_PrefetchThread.get_id() != std::this_thread::get_id())
+  {
+    m_PrefetchThread.join();
+  }
+
+  // the referenced image data is released here, without holding the lock
+}
+
+bool mitk::ImageSliceCache::IsPrefetchCancelled(const void *requester) const
+{
+  // m_PrefetchMutex must be locked
+  return m_StopPrefetch || m_BusyRequestCancelled ||
+         std::any_of(m_PendingRequests.cbegin(),
+                     m_PendingRequests.cend(),
+                     [requester](const std::unique_ptr<PrefetchRequest> &pendingRequest)
+                     { return pendingRequest->Requester == requester; });
+}
+
+void mitk::ImageSliceCache::PrefetchThreadMain()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+
+  while (true)
+  {
+    m_PrefetchCondition.wait(lock, [this] { return m_StopPrefetch || !m_PendingRequests.empty(); });
+
+    if (m_StopPrefetch)
+    {
+      break;
+    }
+
+    auto request = std::move(m_PendingRequests.front());
+    m_PendingRequests.pop_front();
+    m_BusyRequester = request->Requester;
+    m_BusyRequestCancelled = false;
+    m_PrefetchBusy = true;
+    lock.unlock();
+
+    try
+    {
+      this->ProcessPrefetchRequest(*request);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Prefetching of image slices failed: " << e.what();
+    }
+
+    // release the referenced image data without holding the lock
+    request.reset();
+
+    lock.lock();
+    m_BusyRequester = nullptr;
+    m_BusyRequestCancelled = false;
+    m_PrefetchBusy = false;
+    m_PrefetchCondition.notify_all();
+  }
+}
+
+void mitk::ImageSliceCache::ProcessPrefetchRequest(const PrefetchRequest &request)
+{
+  // Prevents writers of the image from changing the referenced pixel data while reslicing. Prefetching is
+  // only an optimization, so the request is skipped instead of waiting for a writer (which could be the
+  // rendering thread itself).
+  std::unique_ptr<ImageReadAccessor> readAccessor;
+  try
+  {
+    readAccessor = std::make_unique<ImageReadAccessor>(request.SourceImage, request.Volume.GetPointer(), ImageAccessorBase::ExceptionIfLocked);
+  }
+  catch (const MemoryIsLockedException &)
+  {
+    return;
+  }
+
+  auto reslicer = ExtractSliceFilter::New();
+  reslicer->SetInput(request.TimeStepImage);
+  reslicer->SetTimeStep(0);
+  reslicer->SetResliceTransformByGeometry(request.TimeStepImage->GetGeometry());
+  reslicer->SetInPlaneResampleExtentByGeometry(request.InPlaneResampleExtentByGeometry);
+  reslicer->SetInterpolationMode(static_cast<ExtractSliceFilter::ResliceInterpolation>(request.InterpolationMode));
+  reslicer->SetVtkOutputRequest(true);
+  reslicer->SetOutputDimensionality(2);
+
+  for (const auto &plane : request.Planes)
+  {
+    {
+      // stop early if the user already scrolled on (a newer request of the requester is waiting)
+      std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+      if (this->IsPrefetchCancelled(request.Requester))
+      {
+        return;
+      }
+    }
+
+    if (nullptr != this->Find(plane.first))
+    {
+      continue;
+    }
+
+    reslicer->SetWorldGeometry(plane.second);
+    reslicer->Modified();
+    reslicer->UpdateLargestPossibleRegion();
+
+    this->Insert(plane.first, CreateSlice(reslicer));
+  }
+}
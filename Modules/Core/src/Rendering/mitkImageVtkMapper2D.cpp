@@ -100,6 +100,7 @@ namespace
 }
 
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
+  : m_NumberOfPrefetchedSlices(4)
 {
 }
 
@@ -156,6 +157,11 @@ vtkProp *mitk::ImageVtkMapper2D::GetVtkProp(mitk::BaseRenderer *renderer)
   return m_LSH.GetLocalStorage(renderer)->m_PublicActors;
 }
 
+mitk::ImageSliceCache *mitk::ImageVtkMapper2D::GetSliceCache() const
+{
+  return ImageSliceCache::GetInstance();
+}
+
 void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
@@ -204,6 +210,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  auto resliceInterpolation = ExtractSliceFilter::RESLICE_NEAREST;
   if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
@@ -218,20 +225,17 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     switch (interpolationMode)
     {
       case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_NEAREST;
         break;
       case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_LINEAR;
         break;
       case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_CUBIC;
         break;
     }
   }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-  }
+  localStorage->m_Reslicer->SetInterpolationMode(resliceInterpolation);
 
   // set the vtk output property to true, makes sure that no unneeded mitk image conversion
   // is done.
@@ -292,23 +296,52 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
-    localStorage->m_Reslicer->SetOutputDimensionality(3);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
 
-    // Do the reslicing. Modified() is called to make sure that the reslicer is
-    // executed even though the input geometry information did not change; this
-    // is necessary when the input /em data, but not the /em geometry changes.
-    localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+    const int thickSliceMode = thickSlicesMode - 1;
+    if (vtkMitkThickSlicesFilter::MIP != thickSliceMode && vtkMitkThickSlicesFilter::MINIP != thickSliceMode)
+    {
+      // The weighted projection is not supported by the slab of vtkImageReslice. The slab mean
+      // rounds, while vtkMitkThickSlicesFilter truncates (and divides the mean by the number of
+      // slices minus one), so mean and sum are projected by the filter as well to keep their values.
+      // The slab is therefore resliced as volume and projected afterwards.
+      localStorage->m_Reslicer->SetSlab(ExtractSliceFilter::SLAB_MAX, 1);
+      localStorage->m_Reslicer->SetOutputDimensionality(3);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+
+      // Do the reslicing. Modified() is called to make sure that the reslicer is
+      // executed even though the input geometry information did not change; this
+      // is necessary when the input /em data, but not the /em geometry changes.
+      localStorage->m_TSFilter->SetThickSliceMode(thickSliceMode);
+      localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+
+      // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->Update();
+
+      localStorage->m_TSFilter->Modified();
+      localStorage->m_TSFilter->Update();
+      localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    }
+    else
+    {
+      // project the slab while reslicing, the 2D result is written directly (and equals the filter result)
+      const auto slabMode = vtkMitkThickSlicesFilter::MINIP == thickSliceMode ? ExtractSliceFilter::SLAB_MIN
+                                                                              : ExtractSliceFilter::SLAB_MAX;
+
+      localStorage->m_Reslicer->SetSlab(slabMode, 2 * thickSlicesNum + 1);
+      localStorage->m_Reslicer->SetOutputDimensionality(2);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
 
-    // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+      localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    }
 
-    localStorage->m_TSFilter->Modified();
-    localStorage->m_TSFilter->Update();
-    localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    localStorage->m_ResliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+    localStorage->m_SliceSpacing[0] = localStorage->m_Reslicer->GetOutputSpacing()[0];
+    localStorage->m_SliceSpacing[1] = localStorage->m_Reslicer->GetOutputSpacing()[1];
+    localStorage->m_HasLastSliceKey = false;
   }
   else
   {
@@ -316,11 +349,55 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_Reslicer->SetOutputDimensionality(2);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
     localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+    localStorage->m_Reslicer->SetSlab(ExtractSliceFilter::SLAB_MAX, 1);
+
+    // slices of curved geometries are not cached, their keys would not cover the transform
+    const bool isCacheable =
+      nullptr != planeGeometry && nullptr == dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
+
+    ImageSliceCache::Key sliceKey;
+    ImageSliceCache::SlicePointer slice;
+    if (isCacheable)
+    {
+      sliceKey = ImageSliceCache::Key(
+        image, this->GetTimestep(), planeGeometry, resliceInterpolation, inPlaneResampleExtentByGeometry);
+      slice = this->GetSliceCache()->Find(sliceKey);
+    }
+
+    if (nullptr == slice)
+    {
+      localStorage->m_Reslicer->Modified();
+      // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
+      localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+
+      if (isCacheable)
+      {
+        slice = ImageSliceCache::CreateSlice(localStorage->m_Reslicer);
+        this->GetSliceCache()->Insert(sliceKey, slice);
+      }
+      else
+      {
+        localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+        localStorage->m_ResliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+        localStorage->m_SliceSpacing[0] = localStorage->m_Reslicer->GetOutputSpacing()[0];
+        localStorage->m_SliceSpacing[1] = localStorage->m_Reslicer->GetOutputSpacing()[1];
+      }
+    }
 
-    localStorage->m_Reslicer->Modified();
-    // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
-    localStorage->m_Reslicer->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    if (nullptr != slice)
+    {
+      // the cached slice is shared with other renderers and must not be modified
+      localStorage->m_ReslicedImage = slice->ReslicedImage;
+      localStorage->m_ResliceAxes->DeepCopy(slice->ResliceAxes);
+      localStorage->m_SliceSpacing[0] = slice->Spacing[0];
+      localStorage->m_SliceSpacing[1] = slice->Spacing[1];
+
+      this->PrefetchSlices(renderer, image, planeGeometry, sliceKey);
+    }
+    else
+    {
+      localStorage->m_HasLastSliceKey = false;
+    }
   }
 
   // Bounds information for reslicing (only reuqired if reference geometry
@@ -333,9 +410,6 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   }
   localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
-  // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
-
   // calculate minimum bounding rect of IMAGE in texture
   {
     double textureClippingBounds[6];
@@ -669,6 +743,55 @@ void mitk::ImageVtkMapper2D::SetToInvalidState(mitk::ImageVtkMapper2D::LocalStor
   // see bug-13275
   localStorage->m_ReslicedImage = nullptr;
   localStorage->m_Mapper->SetInputData(localStorage->m_EmptyPolyData);
+  localStorage->m_HasLastSliceKey = false;
+}
+
+void mitk::ImageVtkMapper2D::PrefetchSlices(mitk::BaseRenderer *renderer,
+                                            mitk::Image *image,
+                                            const PlaneGeometry *worldGeometry,
+                                            const ImageSliceCache::Key &key)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+
+  const bool hasLastSliceKey = localStorage->m_HasLastSliceKey;
+  const ImageSliceCache::Key lastSliceKey = localStorage->m_LastSliceKey;
+  localStorage->m_LastSliceKey = key;
+  localStorage->m_HasLastSliceKey = true;
+
+  if (0 == m_NumberOfPrefetchedSlices || !hasLastSliceKey || !key.MatchesExceptOrigin(lastSliceKey))
+  {
+    return;
+  }
+
+  // only a movement along the plane normal is a scroll movement (and not e.g. a pan of the crosshair)
+  const Vector3D offset = key.Origin - lastSliceKey.Origin;
+  Vector3D normal = worldGeometry->GetNormal();
+  normal.Normalize();
+
+  const ScalarType offsetAlongNormal = offset * normal;
+  if (std::abs(offsetAlongNormal) < mitk::eps || (offset - normal * offsetAlongNormal).GetNorm() > mitk::sqrteps)
+  {
+    return;
+  }
+
+  std::vector<PlaneGeometry::Pointer> planes;
+  Point3D origin = key.Origin;
+  for (unsigned int i = 0; i < m_NumberOfPrefetchedSlices; ++i)
+  {
+    origin += offset;
+
+    auto plane = worldGeometry->Clone();
+    plane->SetOrigin(origin);
+
+    if (!RenderingGeometryIntersectsImage(plane, image->GetSlicedGeometry()))
+    {
+      break;
+    }
+    planes.push_back(plane);
+  }
+
+  this->GetSliceCache()->Prefetch(
+    localStorage, image, this->GetTimestep(), planes, key.InterpolationMode, key.InPlaneResampleExtentByGeometry);
 }
 
 void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
@@ -1058,8 +1181,7 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or sagittal
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
-  trans->SetMatrix(matrix);
+  trans->SetMatrix(localStorage->m_ResliceAxes);
   // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
   localStorage->m_ImageActor->SetUserTransform(trans);
   // transform the origin to center based coordinates, because MITK is center based.
@@ -1100,6 +1222,8 @@ bool mitk::ImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeometr
 
 mitk::ImageVtkMapper2D::LocalStorage::~LocalStorage()
 {
+  // the shared cache identifies the prefetch requests of this renderer by the local storage
+  ImageSliceCache::GetInstance()->CancelPrefetch(this);
 }
 
 mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
@@ -1123,6 +1247,12 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
+  m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+
+  m_SliceSpacing[0] = 1.0;
+  m_SliceSpacing[1] = 1.0;
+  m_mmPerPixel = m_SliceSpacing;
+  m_HasLastSliceKey = false;
 
   // the following actions are always the same and thus can be performed
   // in the constructor for each image (i.e. the image-corresponding local storage)
@@ -35,6 +35,9 @@ found in the LICENSE file.
 #include "mitkLegacyFileWriterService.h"
 #include <mitkFileWriter.h>
 
+// Rendering
+#include <mitkImageSliceCache.h>
+
 #include <itkGDCMImageIO.h>
 #include <itkNiftiImageIO.h>
 
@@ -239,6 +242,9 @@ void MitkCoreActivator::Load(us::ModuleContext *context)
 
 void MitkCoreActivator::Unload(us::ModuleContext *)
 {
+  // the shared slice cache is never destroyed, its prefetch thread must not outlive the module
+  mitk::ImageSliceCache::GetInstance()->StopPrefetch();
+
   for (auto &elem : m_FileReaders)
   {
     delete elem;
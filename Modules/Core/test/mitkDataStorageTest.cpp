@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
 #include "mitkImage.h"
+#include "mitkPointSet.h"
 #include "mitkReferenceCountWatcher.h"
 #include "mitkStringProperty.h"
 #include "mitkSurface.h"
@@ -27,6 +28,7 @@ found in the LICENSE file.
 #include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateData.h"
 #include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateDataUID.h"
 #include "mitkNodePredicateDimension.h"
 #include "mitkNodePredicateNot.h"
 #include "mitkNodePredicateOr.h"
@@ -36,6 +38,8 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 void TestDataStorage(mitk::DataStorage *ds, std::string filename);
+void TestStandaloneDataStorageIndices();
+void TestBoundingGeometryCache();
 
 namespace mitk
 {
@@ -145,9 +149,11 @@ int mitkDataStorageTest(int argc, char *argv[])
   MITK_TEST_OUTPUT(<< "Testing StandaloneDataStorage: ");
   MITK_TEST_CONDITION_REQUIRED(argc > 1, "Testing correct test invocation");
   TestDataStorage(sds, argv[1]);
-  // TODO: Add specific StandaloneDataStorage Tests here
   sds = nullptr;
 
+  TestStandaloneDataStorageIndices();
+  TestBoundingGeometryCache();
+
   MITK_TEST_END();
 }
 
@@ -871,3 +877,130 @@ void TestDataStorage(mitk::DataStorage *ds, std::string filename)
   ds->Remove(ds->GetAll());
   MITK_TEST_CONDITION(ds->GetAll()->Size() == 0, "Checking Clear DataStorage");
 }
+
+//##Documentation
+//## @brief Test that the indices of the StandaloneDataStorage follow changes of the nodes
+void TestStandaloneDataStorageIndices()
+{
+  mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+
+  mitk::Surface::Pointer surface = mitk::Surface::New();
+  mitk::DataNode::Pointer n1 = mitk::DataNode::New();
+  n1->SetName("indexed");
+  n1->SetData(surface);
+  ds->Add(n1);
+
+  mitk::DataNode::Pointer n2 = mitk::DataNode::New();
+  n2->SetName("indexed");
+  n2->SetProperty("organ", mitk::StringProperty::New("liver"));
+  ds->Add(n2);
+
+  auto namePredicate = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("indexed"));
+  MITK_TEST_CONDITION(ds->GetSubset(namePredicate)->Size() == 2, "Indexed name query finds all nodes");
+  MITK_TEST_CONDITION(ds->GetSubset(namePredicate)->GetElement(0) == ds->GetAll()->GetElement(0),
+                      "Indexed query keeps the order of GetAll()");
+
+  n1->SetName("renamed");
+  MITK_TEST_CONDITION(ds->GetNamedNode("indexed") == n2, "Name index follows SetName()");
+  MITK_TEST_CONDITION(ds->GetNamedNode("renamed") == n1, "Name index contains the new name");
+
+  // a value changed in place sends no modified event of the node, only of the property
+  auto *nameProperty = dynamic_cast<mitk::StringProperty *>(n1->GetProperty("name", nullptr, false));
+  MITK_TEST_CONDITION_REQUIRED(nameProperty != nullptr, "Name property of the node");
+  nameProperty->SetValue("changed in place");
+  MITK_TEST_CONDITION(ds->GetNamedNode("changed in place") == n1 && ds->GetNamedNode("renamed") == nullptr,
+                      "Name index follows changes of the property value");
+  n1->SetName("renamed");
+  MITK_TEST_CONDITION(ds->GetNamedNode("renamed") == n1, "Name index follows SetName() after an in-place change");
+
+  auto surfacePredicate = mitk::NodePredicateDataType::New("Surface");
+  MITK_TEST_CONDITION(ds->GetNode(surfacePredicate) == n1, "Indexed data type query");
+  MITK_TEST_CONDITION(ds->GetNode(mitk::NodePredicateDataUID::New(surface->GetUID())) == n1, "Indexed data UID query");
+
+  n1->SetData(mitk::Image::New());
+  MITK_TEST_CONDITION(ds->GetNode(surfacePredicate) == nullptr, "Data type index follows SetData()");
+  MITK_TEST_CONDITION(ds->GetNode(mitk::NodePredicateDataType::New("Image")) == n1,
+                      "Data type index contains the new data type");
+
+  auto organPredicate = mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New("liver"));
+  MITK_TEST_CONDITION(ds->GetNode(organPredicate) == n2, "Query of a not indexed property key");
+  ds->AddIndexedPropertyKey("organ");
+  MITK_TEST_CONDITION(ds->GetNode(organPredicate) == n2, "Query of a property key indexed later");
+  n1->SetProperty("organ", mitk::StringProperty::New("liver"));
+  MITK_TEST_CONDITION(ds->GetSubset(organPredicate)->Size() == 2, "Property index follows SetProperty()");
+  MITK_TEST_CONDITION(ds->GetSubset(mitk::NodePredicateProperty::New("organ"))->Size() == 2,
+                      "Indexed query for the existence of a property");
+
+  auto conjunction = mitk::NodePredicateAnd::New(organPredicate, namePredicate);
+  MITK_TEST_CONDITION(ds->GetNode(conjunction) == n2 && ds->GetSubset(conjunction)->Size() == 1,
+                      "Conjunction with indexed parts checks all parts");
+
+  ds->BlockNodeModifiedEvents(true);
+  n2->SetName("blocked");
+  ds->BlockNodeModifiedEvents(false);
+  MITK_TEST_CONDITION(ds->GetNamedNode("blocked") == n2, "Indices are updated while node events are blocked");
+
+  mitk::Surface::Pointer surfaceWithProperty = mitk::Surface::New();
+  mitk::DataNode::Pointer n3 = mitk::DataNode::New();
+  n3->SetData(surfaceWithProperty);
+  ds->Add(n3);
+  surfaceWithProperty->SetProperty("organ", mitk::StringProperty::New("liver"));
+  MITK_TEST_CONDITION(ds->GetSubset(organPredicate)->Size() == 3, "Indexed query finds properties of the data");
+  ds->Remove(n3);
+
+  ds->Remove(n2);
+  MITK_TEST_CONDITION(ds->GetNamedNode("blocked") == nullptr && ds->GetSubset(organPredicate)->Size() == 1,
+                      "Removed node is not found in the indices");
+}
+
+//##Documentation
+//## @brief Test that the cached bounds of the nodes follow changes of the data and the visibility
+void TestBoundingGeometryCache()
+{
+  mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+
+  mitk::PointSet::Pointer pointSet = mitk::PointSet::New();
+  mitk::Point3D point;
+  mitk::FillVector3D(point, 0.0, 0.0, 0.0);
+  pointSet->InsertPoint(0, point);
+  mitk::FillVector3D(point, 10.0, 10.0, 10.0);
+  pointSet->InsertPoint(1, point);
+
+  mitk::DataNode::Pointer node = mitk::DataNode::New();
+  node->SetData(pointSet);
+  node->SetVisibility(true);
+  ds->Add(node);
+
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 10.0), "Bounds of the point set");
+  MITK_TEST_CONDITION(ds->ComputeVisibleBoundingGeometry3D().IsNotNull(), "Visible bounding geometry");
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 10.0), "Cached bounds of the point set");
+
+  mitk::FillVector3D(point, 20.0, 20.0, 20.0);
+  pointSet->SetPoint(1, point);
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 20.0), "Bounds follow the modified data");
+
+  // the transform is changed in place, neither the data nor its geometries are modified
+  mitk::Vector3D offset;
+  mitk::FillVector3D(offset, 5.0, 5.0, 5.0);
+  pointSet->GetGeometry()->GetIndexToWorldTransform()->SetOffset(offset);
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 25.0),
+                      "Bounds follow the modified transform of the geometry");
+
+  mitk::PointSet::Pointer otherPointSet = mitk::PointSet::New();
+  mitk::FillVector3D(point, -30.0, 0.0, 0.0);
+  otherPointSet->InsertPoint(0, point);
+  mitk::FillVector3D(point, 30.0, 1.0, 1.0);
+  otherPointSet->InsertPoint(1, point);
+  node->SetData(otherPointSet);
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 30.0), "Bounds follow the new data");
+  node->SetData(pointSet);
+  MITK_TEST_CONDITION(mitk::Equal(ds->ComputeBoundingBox()->GetMaximum()[0], 25.0), "Bounds follow the old data");
+
+  node->SetVisibility(false);
+  MITK_TEST_CONDITION(ds->ComputeVisibleBoundingGeometry3D().IsNull(), "Invisible node is not respected");
+  node->SetVisibility(true);
+  MITK_TEST_CONDITION(ds->ComputeVisibleBoundingGeometry3D().IsNotNull(), "Visible node is respected again");
+
+  ds->Remove(node);
+  MITK_TEST_CONDITION(ds->ComputeBoundingGeometry3D().IsNull(), "Removed node is not respected");
+}
@@ -0,0 +1,158 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkMultiThreaderBase.h>
+#include <itkTimeProbe.h>
+
+#include <cstring>
+
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(ThreadedNearestNeighborEqualsSerial);
+  MITK_TEST(ThreadedLinearEqualsSerial);
+  MITK_TEST(ThreadedCubicEqualsSerial);
+  MITK_TEST(Benchmark);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::PlaneGeometry::Pointer m_ObliquePlane;
+
+  mitk::Image::Pointer ExtractSlice(mitk::ExtractSliceFilter2::Interpolator interpolator, itk::ThreadIdType numberOfWorkUnits)
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(m_Image);
+    filter->SetOutputGeometry(m_ObliquePlane);
+    filter->SetInterpolator(interpolator);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+
+    return filter->GetOutput();
+  }
+
+  void CheckThreadedEqualsSerial(mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    auto serialSlice = this->ExtractSlice(interpolator, 1);
+    auto threadedSlice = this->ExtractSlice(interpolator, std::max(4u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+
+    const auto bufferSize = serialSlice->GetPixelType().GetSize() * m_ObliquePlane->GetExtent(0) * m_ObliquePlane->GetExtent(1);
+
+    mitk::ImageReadAccessor serialAccessor(serialSlice);
+    mitk::ImageReadAccessor threadedAccessor(threadedSlice);
+
+    CPPUNIT_ASSERT_MESSAGE("Threaded slice differs from serial slice.",
+      0 == std::memcmp(serialAccessor.GetData(), threadedAccessor.GetData(), static_cast<std::size_t>(bufferSize)));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<float>(256, 256, 64);
+
+    mitk::Vector3D rightVector;
+    mitk::FillVector3D(rightVector, 1.0, 0.3, 0.1);
+    mitk::Vector3D downVector;
+    mitk::FillVector3D(downVector, -0.1, 0.2, 1.0);
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.5, 0.5, 1.0);
+
+    m_ObliquePlane = mitk::PlaneGeometry::New();
+    m_ObliquePlane->InitializeStandardPlane(512, 512, rightVector, downVector, &spacing);
+
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 20.0, 30.0, 5.0);
+    m_ObliquePlane->SetOrigin(origin);
+    m_ObliquePlane->ImageGeometryOn();
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_ObliquePlane = nullptr;
+  }
+
+  void ThreadedNearestNeighborEqualsSerial()
+  {
+    this->CheckThreadedEqualsSerial(mitk::ExtractSliceFilter2::NearestNeighbor);
+  }
+
+  void ThreadedLinearEqualsSerial()
+  {
+    this->CheckThreadedEqualsSerial(mitk::ExtractSliceFilter2::Linear);
+  }
+
+  void ThreadedCubicEqualsSerial()
+  {
+    this->CheckThreadedEqualsSerial(mitk::ExtractSliceFilter2::Cubic);
+  }
+
+  /** Compares ExtractSliceFilter2 with the vtkImageReslice based ExtractSliceFilter.
+   *  Timings are only reported, they are not part of the test result. */
+  void Benchmark()
+  {
+    const unsigned int numberOfRuns = 10;
+
+    const std::pair<mitk::ExtractSliceFilter2::Interpolator, mitk::ExtractSliceFilter::ResliceInterpolation> interpolators[] = {
+      { mitk::ExtractSliceFilter2::NearestNeighbor, mitk::ExtractSliceFilter::RESLICE_NEAREST },
+      { mitk::ExtractSliceFilter2::Linear, mitk::ExtractSliceFilter::RESLICE_LINEAR },
+      { mitk::ExtractSliceFilter2::Cubic, mitk::ExtractSliceFilter::RESLICE_CUBIC }
+    };
+
+    for (const auto& interpolator : interpolators)
+    {
+      auto filter2 = mitk::ExtractSliceFilter2::New();
+      filter2->SetInput(m_Image);
+      filter2->SetInterpolator(interpolator.first);
+
+      auto filter = mitk::ExtractSliceFilter::New();
+      filter->SetInput(m_Image);
+      filter->SetInterpolationMode(interpolator.second);
+
+      itk::TimeProbe probe2;
+      itk::TimeProbe probe;
+
+      for (unsigned int run = 0; run < numberOfRuns; ++run)
+      {
+        // a new geometry instance forces both filters to resample
+        auto plane = m_ObliquePlane->Clone();
+
+        probe2.Start();
+        filter2->SetOutputGeometry(plane);
+        filter2->Update();
+        probe2.Stop();
+
+        probe.Start();
+        filter->SetWorldGeometry(plane);
+        filter->Modified();
+        filter->Update();
+        probe.Stop();
+      }
+
+      MITK_INFO << "Interpolator " << interpolator.first << ": ExtractSliceFilter2 " << probe2.GetMean()
+                << " s, ExtractSliceFilter " << probe.GetMean() << " s (mean of " << numberOfRuns << " runs, "
+                << m_ObliquePlane->GetExtent(0) << "x" << m_ObliquePlane->GetExtent(1) << " pixels)";
+
+      CPPUNIT_ASSERT(filter2->GetOutput()->IsInitialized());
+      CPPUNIT_ASSERT(filter->GetOutput()->IsInitialized());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
@@ -0,0 +1,155 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include <mitkTestingMacros.h>
+// MITK includes
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageGenerator.h>
+#include <vtkMitkThickSlicesFilter.h>
+
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkSmartPointer.h>
+
+class mitkExtractSliceFilterSlabTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilterSlabTestSuite);
+  MITK_TEST(SlabMax_EqualsThickSlicesMIP);
+  MITK_TEST(SlabMin_EqualsThickSlicesMinIP);
+  MITK_TEST(SlabMean_EqualsThickSlicesSum);
+  MITK_TEST(ExternalReslicer_SlabSettingsKept);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::PlaneGeometry::Pointer m_Plane;
+
+  static const int NUMBER_OF_SLICES = 3;
+
+  mitk::ExtractSliceFilter::Pointer CreateReslicer()
+  {
+    auto reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(m_Image);
+    reslicer->SetWorldGeometry(m_Plane);
+    reslicer->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->SetOutputSpacingZDirection(1.0);
+    return reslicer;
+  }
+
+  vtkSmartPointer<vtkImageData> ProjectSlab(mitk::ExtractSliceFilter::SlabMode mode)
+  {
+    auto reslicer = this->CreateReslicer();
+    reslicer->SetSlab(mode, 2 * NUMBER_OF_SLICES + 1);
+    reslicer->SetOutputDimensionality(2);
+    reslicer->Update();
+
+    auto result = vtkSmartPointer<vtkImageData>::New();
+    result->DeepCopy(reslicer->GetVtkOutput());
+    return result;
+  }
+
+  vtkSmartPointer<vtkImageData> ProjectThickSlices(int mode)
+  {
+    auto reslicer = this->CreateReslicer();
+    reslicer->SetOutputDimensionality(3);
+    reslicer->SetOutputExtentZDirection(-NUMBER_OF_SLICES, NUMBER_OF_SLICES);
+
+    auto thickSlicesFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+    thickSlicesFilter->SetThickSliceMode(mode);
+    thickSlicesFilter->SetInputData(reslicer->GetVtkOutput());
+    reslicer->Update();
+    thickSlicesFilter->Update();
+
+    auto result = vtkSmartPointer<vtkImageData>::New();
+    result->DeepCopy(thickSlicesFilter->GetOutput());
+    return result;
+  }
+
+  void CheckEqual(vtkImageData *slab, vtkImageData *thickSlices, double tolerance)
+  {
+    int slabDimensions[3], thickSlicesDimensions[3];
+    slab->GetDimensions(slabDimensions);
+    thickSlices->GetDimensions(thickSlicesDimensions);
+    CPPUNIT_ASSERT_EQUAL(thickSlicesDimensions[0], slabDimensions[0]);
+    CPPUNIT_ASSERT_EQUAL(thickSlicesDimensions[1], slabDimensions[1]);
+
+    for (int y = 0; y < slabDimensions[1]; ++y)
+    {
+      for (int x = 0; x < slabDimensions[0]; ++x)
+      {
+        const double slabValue = slab->GetScalarComponentAsDouble(x, y, 0, 0);
+        const double thickSlicesValue = thickSlices->GetScalarComponentAsDouble(x, y, 0, 0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(thickSlicesValue, slabValue, tolerance);
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(40, 30, 20, 1, 1, 1, 1, 1000, -1000);
+
+    m_Plane = mitk::PlaneGeometry::New();
+    m_Plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, 10);
+    m_Plane->SetReferenceGeometry(m_Image->GetGeometry());
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Plane = nullptr;
+  }
+
+  void SlabMax_EqualsThickSlicesMIP()
+  {
+    this->CheckEqual(this->ProjectSlab(mitk::ExtractSliceFilter::SLAB_MAX),
+                     this->ProjectThickSlices(vtkMitkThickSlicesFilter::MIP), 0.0);
+  }
+
+  void SlabMin_EqualsThickSlicesMinIP()
+  {
+    this->CheckEqual(this->ProjectSlab(mitk::ExtractSliceFilter::SLAB_MIN),
+                     this->ProjectThickSlices(vtkMitkThickSlicesFilter::MINIP), 0.0);
+  }
+
+  void SlabMean_EqualsThickSlicesSum()
+  {
+    // the thick slices filter normalizes the sum by the number of slices and truncates, the slab rounds
+    this->CheckEqual(this->ProjectSlab(mitk::ExtractSliceFilter::SLAB_MEAN),
+                     this->ProjectThickSlices(vtkMitkThickSlicesFilter::SUM), 1.0);
+  }
+
+  void ExternalReslicer_SlabSettingsKept()
+  {
+    auto vtkReslicer = vtkSmartPointer<vtkImageReslice>::New();
+    vtkReslicer->SetSlabMode(VTK_IMAGE_SLAB_SUM);
+    vtkReslicer->SetSlabNumberOfSlices(5);
+    vtkReslicer->SetSlabSliceSpacingFraction(0.5);
+
+    auto reslicer = mitk::ExtractSliceFilter::New(vtkReslicer);
+    reslicer->SetInput(m_Image);
+    reslicer->SetWorldGeometry(m_Plane);
+    reslicer->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->SetSlab(mitk::ExtractSliceFilter::SLAB_MAX, 3);
+    reslicer->Update();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(VTK_IMAGE_SLAB_SUM), vtkReslicer->GetSlabMode());
+    CPPUNIT_ASSERT_EQUAL(5, vtkReslicer->GetSlabNumberOfSlices());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, vtkReslicer->GetSlabSliceSpacingFraction(), 0.0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilterSlab)
@@ -22,6 +22,7 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <random>
 
@@ -230,5 +231,34 @@ int mitkImageAccessorTest(int argc, char *argv[])
 
   MITK_TEST_CONDITION_REQUIRED(TestSuccessful, "Testing image access from multiple threads");
 
+  // SHARED READ ACCESS
+  image->ResetAccessorContention();
+  {
+    mitk::ImageReadAccessor first(image);
+    mitk::ImageReadAccessor second(image);
+  }
+  MITK_TEST_CONDITION_REQUIRED(image->GetAccessorContention().LockedReads == 0,
+                               "Testing that concurrent read accessors do not lock the image");
+
+  MITK_TEST_OUTPUT(<< "Testing a write access to a part that is read by the same thread, should end in an exception ...");
+  MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+  mitk::ImageReadAccessor first(image);
+  mitk::ImageWriteAccessor second(image);
+  MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+  {
+    auto reader = std::make_unique<mitk::ImageReadAccessor>(image);
+    std::thread writerThread([&image]() { mitk::ImageWriteAccessor writer(image); });
+
+    // the write accessor has to wait for the shared read access
+    while (image->GetAccessorContention().Waits == 0)
+      std::this_thread::yield();
+
+    reader.reset();
+    writerThread.join();
+  }
+  MITK_TEST_CONDITION_REQUIRED(image->GetAccessorContention().Waits == 1,
+                               "Testing that a write accessor waits for a shared read access of another thread");
+
   MITK_TEST_END();
 }
@@ -0,0 +1,247 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include <mitkTestingMacros.h>
+// MITK includes
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageSliceCache.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cstring>
+
+class mitkImageSliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSliceCacheTestSuite);
+  MITK_TEST(Find_InsertedSlice);
+  MITK_TEST(Find_ModifiedImage_Miss);
+  MITK_TEST(Insert_ExceedsCapacity_LeastRecentlyUsedEvicted);
+  MITK_TEST(Insert_OtherImage_SlicesKept);
+  MITK_TEST(Prefetch_EqualsReslicedSlices);
+  MITK_TEST(Prefetch_TwoRequesters_BothProcessed);
+  MITK_TEST(Prefetch_ImageWriteLocked_Skipped);
+  MITK_TEST(StopPrefetch_LaterRequestsIgnored);
+  MITK_TEST(GetInstance_SharedCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::ImageSliceCache::Pointer m_Cache;
+
+  mitk::PlaneGeometry::Pointer CreatePlane(unsigned int slice)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, slice);
+    plane->SetReferenceGeometry(m_Image->GetGeometry());
+    return plane;
+  }
+
+  mitk::ImageSliceCache::Key CreateKey(const mitk::PlaneGeometry *plane)
+  {
+    return mitk::ImageSliceCache::Key(m_Image, 0, plane, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+  }
+
+  mitk::ImageSliceCache::SlicePointer ResliceDirectly(const mitk::PlaneGeometry *plane)
+  {
+    auto reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(m_Image);
+    reslicer->SetWorldGeometry(plane);
+    reslicer->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    reslicer->SetInterpolationMode(mitk::ExtractSliceFilter::RESLICE_NEAREST);
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->SetOutputDimensionality(2);
+    reslicer->Modified();
+    reslicer->UpdateLargestPossibleRegion();
+
+    return mitk::ImageSliceCache::CreateSlice(reslicer);
+  }
+
+  bool AreEqual(const mitk::ImageSliceCache::SlicePointer &slice1, const mitk::ImageSliceCache::SlicePointer &slice2)
+  {
+    auto image1 = slice1->ReslicedImage;
+    auto image2 = slice2->ReslicedImage;
+
+    int dimensions1[3], dimensions2[3];
+    image1->GetDimensions(dimensions1);
+    image2->GetDimensions(dimensions2);
+    if (!std::equal(dimensions1, dimensions1 + 3, dimensions2))
+      return false;
+
+    const auto size = static_cast<std::size_t>(dimensions1[0]) * dimensions1[1] * dimensions1[2] *
+                      image1->GetScalarSize() * image1->GetNumberOfScalarComponents();
+    return 0 == std::memcmp(image1->GetScalarPointer(), image2->GetScalarPointer(), size);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(64, 48, 32);
+    m_Cache = mitk::ImageSliceCache::New();
+  }
+
+  void tearDown() override
+  {
+    m_Cache = nullptr;
+    m_Image = nullptr;
+  }
+
+  void Find_InsertedSlice()
+  {
+    auto plane = this->CreatePlane(10);
+    auto slice = this->ResliceDirectly(plane);
+
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane)));
+
+    m_Cache->Insert(this->CreateKey(plane), slice);
+    CPPUNIT_ASSERT(slice == m_Cache->Find(this->CreateKey(plane)));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(this->CreatePlane(11))));
+  }
+
+  void Find_ModifiedImage_Miss()
+  {
+    auto plane = this->CreatePlane(10);
+    m_Cache->Insert(this->CreateKey(plane), this->ResliceDirectly(plane));
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane)));
+
+    // slices of the outdated image state are dropped with the first slice of the new state
+    m_Cache->Insert(this->CreateKey(plane), this->ResliceDirectly(plane));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Cache->GetNumberOfSlices());
+  }
+
+  void Insert_ExceedsCapacity_LeastRecentlyUsedEvicted()
+  {
+    auto plane0 = this->CreatePlane(0);
+    auto plane1 = this->CreatePlane(1);
+    auto plane2 = this->CreatePlane(2);
+
+    m_Cache->Insert(this->CreateKey(plane0), this->ResliceDirectly(plane0));
+    m_Cache->Insert(this->CreateKey(plane1), this->ResliceDirectly(plane1));
+    m_Cache->SetCapacity(m_Cache->GetSize());
+
+    // plane 0 becomes the most recently used slice, so plane 1 has to be evicted
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane0)));
+    m_Cache->Insert(this->CreateKey(plane2), this->ResliceDirectly(plane2));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane0)));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane1)));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane2)));
+  }
+
+  void Insert_OtherImage_SlicesKept()
+  {
+    auto plane = this->CreatePlane(10);
+    m_Cache->Insert(this->CreateKey(plane), this->ResliceDirectly(plane));
+
+    // the other image has a newer MTime, but that must not outdate the slices of the first image
+    auto otherImage = mitk::ImageGenerator::GenerateRandomImage<short>(64, 48, 32);
+    mitk::ImageSliceCache::Key otherKey(otherImage, 0, plane, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->Insert(otherKey, this->ResliceDirectly(plane));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane)));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(otherKey));
+  }
+
+  void Prefetch_EqualsReslicedSlices()
+  {
+    std::vector<mitk::PlaneGeometry::Pointer> planes = { this->CreatePlane(5), this->CreatePlane(6), this->CreatePlane(7) };
+
+    m_Cache->Prefetch(this, m_Image, 0, planes, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->WaitForPrefetch();
+
+    for (const auto &plane : planes)
+    {
+      auto prefetchedSlice = m_Cache->Find(this->CreateKey(plane));
+      CPPUNIT_ASSERT_MESSAGE("Slice was not prefetched.", nullptr != prefetchedSlice);
+      CPPUNIT_ASSERT_MESSAGE("Prefetched slice differs from resliced slice.",
+                             this->AreEqual(prefetchedSlice, this->ResliceDirectly(plane)));
+    }
+  }
+
+  void Prefetch_TwoRequesters_BothProcessed()
+  {
+    int requester1 = 0;
+    int requester2 = 0;
+    std::vector<mitk::PlaneGeometry::Pointer> planes1 = { this->CreatePlane(5), this->CreatePlane(6) };
+    std::vector<mitk::PlaneGeometry::Pointer> planes2 = { this->CreatePlane(20), this->CreatePlane(21) };
+
+    m_Cache->Prefetch(&requester1, m_Image, 0, planes1, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->Prefetch(&requester2, m_Image, 0, planes2, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->WaitForPrefetch();
+
+    for (const auto &plane : planes1)
+      CPPUNIT_ASSERT_MESSAGE("Slice of the first requester was not prefetched.", nullptr != m_Cache->Find(this->CreateKey(plane)));
+    for (const auto &plane : planes2)
+      CPPUNIT_ASSERT_MESSAGE("Slice of the second requester was not prefetched.", nullptr != m_Cache->Find(this->CreateKey(plane)));
+
+    m_Cache->CancelPrefetch(&requester1);
+    m_Cache->CancelPrefetch(&requester2);
+  }
+
+  void Prefetch_ImageWriteLocked_Skipped()
+  {
+    std::vector<mitk::PlaneGeometry::Pointer> planes = { this->CreatePlane(5) };
+    std::vector<mitk::PlaneGeometry::Pointer> lockedPlanes = { this->CreatePlane(6) };
+
+    // creates the time step image of the requester before the image gets locked
+    m_Cache->Prefetch(this, m_Image, 0, planes, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->WaitForPrefetch();
+
+    {
+      mitk::ImageWriteAccessor writeAccessor(m_Image);
+      m_Cache->Prefetch(this, m_Image, 0, lockedPlanes, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+      m_Cache->WaitForPrefetch();
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Slice was prefetched while the image was locked by a writer.",
+                           nullptr == m_Cache->Find(this->CreateKey(lockedPlanes.front())));
+
+    m_Cache->Prefetch(this, m_Image, 0, lockedPlanes, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->WaitForPrefetch();
+
+    CPPUNIT_ASSERT_MESSAGE("Slice was not prefetched after the writer was released.",
+                           nullptr != m_Cache->Find(this->CreateKey(lockedPlanes.front())));
+
+    m_Cache->CancelPrefetch(this);
+  }
+
+  void StopPrefetch_LaterRequestsIgnored()
+  {
+    std::vector<mitk::PlaneGeometry::Pointer> planes = { this->CreatePlane(5) };
+
+    m_Cache->StopPrefetch();
+    m_Cache->Prefetch(this, m_Image, 0, planes, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    m_Cache->WaitForPrefetch();
+
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(planes.front())));
+
+    // still usable as a plain cache
+    m_Cache->Insert(this->CreateKey(planes.front()), this->ResliceDirectly(planes.front()));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(planes.front())));
+
+    m_Cache->CancelPrefetch(this);
+  }
+
+  void GetInstance_SharedCache()
+  {
+    CPPUNIT_ASSERT(nullptr != mitk::ImageSliceCache::GetInstance());
+    CPPUNIT_ASSERT(mitk::ImageSliceCache::GetInstance() == mitk::ImageSliceCache::GetInstance());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSliceCache)
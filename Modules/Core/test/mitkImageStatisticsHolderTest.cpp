@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include <mitkTestingMacros.h>
+// MITK includes
+#include "mitkImage.h"
+#include "mitkImageGenerator.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageStatisticsHolder.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+class mitkImageStatisticsHolderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageStatisticsHolderTestSuite);
+  MITK_TEST(Extrema_MatchReference);
+  MITK_TEST(SliceWrite_NewExtrema);
+  MITK_TEST(SliceWrite_RemovedExtrema);
+  MITK_TEST(WriteWithoutAccessor_Recomputed);
+  MITK_TEST(TimeSteps_Independent);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  struct Reference
+  {
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double secondMin = std::numeric_limits<double>::max();
+    double secondMax = std::numeric_limits<double>::lowest();
+    unsigned int countOfMin = 0;
+    unsigned int countOfMax = 0;
+  };
+
+  Reference ComputeReference(const mitk::Image *image, unsigned int t = 0)
+  {
+    mitk::ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    const auto *data = static_cast<const short *>(accessor.GetData());
+    const std::size_t numberOfPixels =
+      image->GetDimension(0) * image->GetDimension(1) * image->GetDimension(2);
+
+    Reference reference;
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      reference.min = std::min(reference.min, static_cast<double>(data[i]));
+      reference.max = std::max(reference.max, static_cast<double>(data[i]));
+    }
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      const double value = data[i];
+      if (value == reference.min)
+        ++reference.countOfMin;
+      else
+        reference.secondMin = std::min(reference.secondMin, value);
+
+      if (value == reference.max)
+        ++reference.countOfMax;
+      else
+        reference.secondMax = std::max(reference.secondMax, value);
+    }
+    return reference;
+  }
+
+  void CheckStatistics(mitk::Image *image, unsigned int t = 0)
+  {
+    const auto reference = this->ComputeReference(image, t);
+    auto statistics = image->GetStatistics();
+
+    CPPUNIT_ASSERT_EQUAL(reference.min, statistics->GetScalarValueMin(t));
+    CPPUNIT_ASSERT_EQUAL(reference.max, statistics->GetScalarValueMax(t));
+    CPPUNIT_ASSERT_EQUAL(reference.secondMin, statistics->GetScalarValue2ndMin(t));
+    CPPUNIT_ASSERT_EQUAL(reference.secondMax, statistics->GetScalarValue2ndMax(t));
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(reference.countOfMin), statistics->GetCountOfMinValuedVoxels(t));
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(reference.countOfMax), statistics->GetCountOfMaxValuedVoxels(t));
+  }
+
+  void FillSlice(mitk::Image *image, unsigned int slice, short value, unsigned int t = 0)
+  {
+    mitk::ImageWriteAccessor accessor(image, image->GetSliceData(slice, t));
+    auto *data = static_cast<short *>(accessor.GetData());
+    std::fill_n(data, image->GetDimension(0) * image->GetDimension(1), value);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(16, 12, 10, 2, 1, 1, 1, 1000, -1000);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void Extrema_MatchReference()
+  {
+    this->CheckStatistics(m_Image);
+    this->CheckStatistics(m_Image, 1);
+  }
+
+  void SliceWrite_NewExtrema()
+  {
+    this->CheckStatistics(m_Image);
+
+    this->FillSlice(m_Image, 4, 2000);
+    m_Image->Modified();
+    this->CheckStatistics(m_Image);
+    CPPUNIT_ASSERT_EQUAL(2000., m_Image->GetStatistics()->GetScalarValueMax());
+
+    this->FillSlice(m_Image, 7, -2000);
+    m_Image->Modified();
+    this->CheckStatistics(m_Image);
+    CPPUNIT_ASSERT_EQUAL(-2000., m_Image->GetStatistics()->GetScalarValueMin());
+  }
+
+  void SliceWrite_RemovedExtrema()
+  {
+    this->FillSlice(m_Image, 2, 2000);
+    this->FillSlice(m_Image, 3, -2000);
+    m_Image->Modified();
+    this->CheckStatistics(m_Image);
+
+    // overwrite the slices that contain the extrema, so the remaining blocks define them again
+    this->FillSlice(m_Image, 2, 0);
+    this->FillSlice(m_Image, 3, 0);
+    m_Image->Modified();
+    this->CheckStatistics(m_Image);
+  }
+
+  void WriteWithoutAccessor_Recomputed()
+  {
+    this->CheckStatistics(m_Image);
+
+    std::vector<short> volume(16 * 12 * 10, 5);
+    volume[100] = 3000;
+    m_Image->SetVolume(volume.data());
+    this->CheckStatistics(m_Image);
+    CPPUNIT_ASSERT_EQUAL(3000., m_Image->GetStatistics()->GetScalarValueMax());
+    CPPUNIT_ASSERT_EQUAL(5., m_Image->GetStatistics()->GetScalarValueMin());
+  }
+
+  void TimeSteps_Independent()
+  {
+    this->CheckStatistics(m_Image);
+    this->CheckStatistics(m_Image, 1);
+
+    this->FillSlice(m_Image, 9, 4000, 1);
+    m_Image->Modified();
+    this->CheckStatistics(m_Image);
+    this->CheckStatistics(m_Image, 1);
+    CPPUNIT_ASSERT(m_Image->GetStatistics()->GetScalarValueMax(0) < 4000.);
+    CPPUNIT_ASSERT_EQUAL(4000., m_Image->GetStatistics()->GetScalarValueMax(1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageStatisticsHolder)
@@ -16,13 +16,19 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 
 #include "mitkIOUtil.h"
+#include <mitkImageDataItem.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkItkImageIO.h>
 #include <mitkUtf8Util.h>
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkByteSwapper.h>
 #include <itkImageRegionIterator.h>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -44,6 +50,11 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestPartialReadNrrd);
+  MITK_TEST(TestPartialReadRawNrrd);
+  MITK_TEST(TestPartialReadNifti);
+  MITK_TEST(TestPartialReadInvalidRequest);
+  MITK_TEST(TestDetachedRawNrrdRoundTrip);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -63,6 +74,226 @@ public:
     TestImageWriter("3D+t-ITKIO-TestData/LinearModel_4D_prop_time_geometry.nrrd");
   }
 
+  /** 3D+t image whose pixel values encode their index: x + 10y + 100z + 1000t.*/
+  mitk::Image::Pointer CreatePartialReadTestImage()
+  {
+    typedef itk::Image<short, 4> ImageType;
+    ImageType::Pointer itkImage = ImageType::New();
+
+    ImageType::SizeType size;
+    size[0] = 7;
+    size[1] = 6;
+    size[2] = 5;
+    size[3] = 3;
+    itkImage->SetRegions(size);
+
+    ImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 0.75;
+    spacing[2] = 2.0;
+    spacing[3] = 1.0;
+    itkImage->SetSpacing(spacing);
+
+    ImageType::PointType origin;
+    origin[0] = 10.0;
+    origin[1] = -5.0;
+    origin[2] = 3.0;
+    origin[3] = 0.0;
+    itkImage->SetOrigin(origin);
+    itkImage->Allocate();
+
+    itk::ImageRegionIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      iter.Set(static_cast<short>(index[0] + 10 * index[1] + 100 * index[2] + 1000 * index[3]));
+    }
+
+    return mitk::ImportItkImage(itkImage)->Clone();
+  }
+
+  void CheckPartialRead(const std::string &path)
+  {
+    auto image = CreatePartialReadTestImage();
+
+    mitk::ItkImageIO::PartialReadRequest request;
+    request.Index[0] = 1;
+    request.Index[1] = 2;
+    request.Index[2] = 1;
+    request.Size[0] = 5;
+    request.Size[1] = 3;
+    request.Stride = {{2, 1, 2}};
+    request.TimeSteps = {0, 2};
+
+    auto part = mitk::ItkImageIO::LoadPartialImage(path, request);
+
+    CPPUNIT_ASSERT_EQUAL(4u, part->GetDimension());
+    CPPUNIT_ASSERT_EQUAL(3u, part->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(3u, part->GetDimension(1));
+    CPPUNIT_ASSERT_EQUAL(2u, part->GetDimension(2));
+    CPPUNIT_ASSERT_EQUAL(2u, part->GetDimension(3));
+
+    mitk::ImageReadAccessor accessor(part);
+    const auto *pixels = static_cast<const short *>(accessor.GetData());
+
+    for (unsigned int t = 0; t < 2; ++t)
+      for (unsigned int z = 0; z < 2; ++z)
+        for (unsigned int y = 0; y < 3; ++y)
+          for (unsigned int x = 0; x < 3; ++x)
+          {
+            const int expected = (1 + 2 * x) + 10 * (2 + y) + 100 * (1 + 2 * z) + 1000 * request.TimeSteps[t];
+            CPPUNIT_ASSERT_EQUAL(expected, static_cast<int>(pixels[((t * 2 + z) * 3 + y) * 3 + x]));
+          }
+
+    // the part starts at its first voxel and has the spacing of the read voxels
+    mitk::Point3D firstVoxel;
+    firstVoxel[0] = 1;
+    firstVoxel[1] = 2;
+    firstVoxel[2] = 1;
+    mitk::Point3D expectedOrigin;
+    image->GetGeometry()->IndexToWorld(firstVoxel, expectedOrigin);
+
+    CPPUNIT_ASSERT(mitk::Equal(expectedOrigin, part->GetGeometry()->GetOrigin(), mitk::eps, true));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, part->GetGeometry()->GetSpacing()[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, part->GetGeometry()->GetSpacing()[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, part->GetGeometry()->GetSpacing()[2], mitk::eps);
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    const auto expectedTimeBounds = loadedImage->GetTimeGeometry()->GetTimeBounds(2);
+    CPPUNIT_ASSERT_EQUAL(expectedTimeBounds[0], part->GetTimeGeometry()->GetTimeBounds(1)[0]);
+    CPPUNIT_ASSERT_EQUAL(expectedTimeBounds[1], part->GetTimeGeometry()->GetTimeBounds(1)[1]);
+  }
+
+  void TestPartialReadNrrd()
+  {
+    // compressed, so the whole image is read
+    auto path = mitk::IOUtil::CreateTemporaryFile("PartialReadXXXXXX.nrrd");
+    mitk::IOUtil::Save(CreatePartialReadTestImage(), path);
+    CheckPartialRead(path);
+  }
+
+  void TestPartialReadRawNrrd()
+  {
+    // uncompressed data attached to the header, only the part is copied from the mapped file
+    auto image = CreatePartialReadTestImage();
+    std::ofstream file;
+    auto path = mitk::IOUtil::CreateTemporaryFile(
+      file, std::ios_base::out | std::ios_base::binary, "PartialReadRawXXXXXX.nrrd");
+
+    file << "NRRD0004\n"
+         << "type: short\n"
+         << "dimension: 4\n"
+         << "space dimension: 4\n"
+         << "sizes: 7 6 5 3\n"
+         << "space directions: (0.5,0,0,0) (0,0.75,0,0) (0,0,2,0) (0,0,0,1)\n"
+         << "kinds: domain domain domain domain\n"
+         << "endian: " << (itk::ByteSwapper<short>::SystemIsLittleEndian() ? "little" : "big") << "\n"
+         << "encoding: raw\n"
+         << "space origin: (10,-5,3,0)\n"
+         << "\n";
+
+    mitk::ImageReadAccessor accessor(image);
+    file.write(static_cast<const char *>(accessor.GetData()), 7 * 6 * 5 * 3 * sizeof(short));
+    file.close();
+
+    CheckPartialRead(path);
+  }
+
+  void TestPartialReadNifti()
+  {
+    // streamed reading of the requested rows
+    auto path = mitk::IOUtil::CreateTemporaryFile("PartialReadXXXXXX.nii");
+    mitk::IOUtil::Save(CreatePartialReadTestImage(), path);
+    CheckPartialRead(path);
+  }
+
+  void TestDetachedRawNrrdRoundTrip()
+  {
+    // uncompressed data in a separate file, the loaded image is backed by a mapping of that file
+    auto image = CreatePartialReadTestImage();
+    std::ofstream header;
+    auto headerPath = mitk::IOUtil::CreateTemporaryFile(
+      header, std::ios_base::out | std::ios_base::binary, "DetachedRawXXXXXX.nhdr");
+    const auto dataPath = itksys::SystemTools::GetFilenameWithoutLastExtension(headerPath) + ".raw";
+    const auto dataFullPath = itksys::SystemTools::GetFilenamePath(headerPath) + "/" + dataPath;
+    const std::size_t dataSize = 7 * 6 * 5 * 3 * sizeof(short);
+
+    header << "NRRD0004\n"
+           << "type: short\n"
+           << "dimension: 4\n"
+           << "space dimension: 4\n"
+           << "sizes: 7 6 5 3\n"
+           << "space directions: (0.5,0,0,0) (0,0.75,0,0) (0,0,2,0) (0,0,0,1)\n"
+           << "kinds: domain domain domain domain\n"
+           << "endian: " << (itk::ByteSwapper<short>::SystemIsLittleEndian() ? "little" : "big") << "\n"
+           << "encoding: raw\n"
+           << "space origin: (10,-5,3,0)\n"
+           << "data file: " << dataPath << "\n"
+           << "\n";
+    header.close();
+
+    {
+      mitk::ImageReadAccessor accessor(image);
+      std::ofstream data(dataFullPath, std::ios_base::out | std::ios_base::binary);
+      data.write(static_cast<const char *>(accessor.GetData()), dataSize);
+    }
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(headerPath);
+    CPPUNIT_ASSERT_MESSAGE("Testing if the image data is backed by the data file.",
+                           loadedImage->GetChannelData()->GetMappedFile() != nullptr);
+    CPPUNIT_ASSERT_EQUAL(4u, loadedImage->GetDimension());
+    {
+      mitk::ImageReadAccessor originalAccessor(image);
+      mitk::ImageReadAccessor loadedAccessor(loadedImage);
+      CPPUNIT_ASSERT_MESSAGE("Testing if the mapped image equals the written image.",
+                             0 == std::memcmp(originalAccessor.GetData(), loadedAccessor.GetData(), dataSize));
+    }
+
+    // writing to the image changes private copies of the mapped pages only
+    {
+      mitk::ImageWriteAccessor accessor(loadedImage);
+      static_cast<short *>(accessor.GetData())[0] = -1;
+    }
+
+    std::vector<char> fileContent(dataSize);
+    {
+      std::ifstream data(dataFullPath, std::ios_base::in | std::ios_base::binary);
+      data.read(fileContent.data(), dataSize);
+    }
+    mitk::ImageReadAccessor originalAccessor(image);
+    CPPUNIT_ASSERT_MESSAGE("Testing if the data file is unchanged after writing to the mapped image.",
+                           0 == std::memcmp(fileContent.data(), originalAccessor.GetData(), dataSize));
+
+    // the mapped image is saved and loaded again like any other image
+    auto savedPath = mitk::IOUtil::CreateTemporaryFile("DetachedRawRoundTripXXXXXX.nrrd");
+    mitk::IOUtil::Save(loadedImage, savedPath);
+    auto reloadedImage = mitk::IOUtil::Load<mitk::Image>(savedPath);
+    MITK_ASSERT_EQUAL(loadedImage, reloadedImage, "Testing if the saved mapped image equals the reloaded image");
+
+    itksys::SystemTools::RemoveFile(headerPath);
+    itksys::SystemTools::RemoveFile(dataFullPath);
+    itksys::SystemTools::RemoveFile(savedPath);
+  }
+
+  void TestPartialReadInvalidRequest()
+  {
+    auto path = mitk::IOUtil::CreateTemporaryFile("PartialReadXXXXXX.nrrd");
+    mitk::IOUtil::Save(CreatePartialReadTestImage(), path);
+
+    mitk::ItkImageIO::PartialReadRequest outside;
+    outside.Index[0] = 5;
+    outside.Size[0] = 3;
+    CPPUNIT_ASSERT_THROW(mitk::ItkImageIO::LoadPartialImage(path, outside), mitk::Exception);
+
+    mitk::ItkImageIO::PartialReadRequest noStride;
+    noStride.Stride[1] = 0;
+    CPPUNIT_ASSERT_THROW(mitk::ItkImageIO::LoadPartialImage(path, noStride), mitk::Exception);
+
+    mitk::ItkImageIO::PartialReadRequest timeSteps;
+    timeSteps.TimeSteps = {2, 1};
+    CPPUNIT_ASSERT_THROW(mitk::ItkImageIO::LoadPartialImage(path, timeSteps), mitk::Exception);
+  }
+
   void TestImageWriterSimple()
   {
     // TODO
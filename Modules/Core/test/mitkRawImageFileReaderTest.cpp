@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkIOConstants.h"
 #include "mitkIOUtil.h"
+#include "mitkImageDataItem.h"
 #include "mitkTestFixture.h"
 #include "mitkTestingMacros.h"
 
@@ -19,6 +20,7 @@ class mitkRawImageFileReaderTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkRawImageFileReaderTestSuite);
   MITK_TEST(testReadFile);
+  MITK_TEST(testReadFileMemoryMapped);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -57,6 +59,26 @@ public:
     MITK_ASSERT_EQUAL(
       compareImage, readFile, "Testing if image is equal to the same image as reference file loaded with mitk");
   }
+
+  void testReadFileMemoryMapped()
+  {
+    mitk::IFileReader::Options options;
+    options[mitk::IOConstants::DIMENSION()] = 3;
+    options[mitk::IOConstants::PIXEL_TYPE()] = mitk::IOConstants::PIXEL_TYPE_FLOAT();
+    options[mitk::IOConstants::SIZE_X()] = 91;
+    options[mitk::IOConstants::SIZE_Y()] = 109;
+    options[mitk::IOConstants::SIZE_Z()] = 91;
+    options[mitk::IOConstants::ENDIANNESS()] = mitk::IOConstants::ENDIANNESS_LITTLE();
+    options[mitk::IOConstants::MEMORY_MAPPED()] = true;
+    mitk::Image::Pointer readFile = mitk::IOUtil::Load<mitk::Image>(m_ImagePath, options);
+    CPPUNIT_ASSERT_MESSAGE("Testing reading a raw file memory mapped.", readFile.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Testing if the image data is backed by the file.",
+                           readFile->GetChannelData()->GetMappedFile() != nullptr);
+
+    mitk::Image::Pointer compareImage = mitk::IOUtil::Load<mitk::Image>(m_ImagePathNrrdRef);
+    MITK_ASSERT_EQUAL(
+      compareImage, readFile, "Testing if mapped image is equal to the same image as reference file loaded with mitk");
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkRawImageFileReader)
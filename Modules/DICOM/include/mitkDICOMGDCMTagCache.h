@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -43,7 +44,17 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
-      const gdcm::Scanner& GetScanner() const;
+      /**
+        \brief Initializes the cache with the results of several scanners, each of them
+        having scanned a consecutive partition of inputFiles.
+        The frame info list is merged in the order of inputFiles. The cache keeps all scanners
+        alive, because the frame infos refer to the values stored by the scanners.
+        @pre partitions and scanners must have the same size, the partitions must cover inputFiles in order.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags,
+                     const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                     const std::vector<std::pair<std::size_t, std::size_t>>& partitions,
+                     const StringList& inputFiles);
 
   protected:
 
@@ -52,7 +63,7 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
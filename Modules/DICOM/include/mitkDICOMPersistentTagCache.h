@@ -0,0 +1,130 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include "mitkDICOMTagCache.h"
+#include "mitkDICOMGenericImageFrameInfo.h"
+
+#include <map>
+#include <set>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Tag cache that is backed by a persistent index file.
+
+    The index stores the scanned tag values of every file together with the
+    file size and modification time. Calling Update() only scans files that
+    are not part of the index yet or have changed on disk since they were
+    indexed; all other files are served from the index. The updated index is
+    written back to the index file afterwards.
+
+    Typical usage:
+     - set the index file (e.g. one per archive folder or one per user)
+     - add the tags of interest (e.g. DICOMFileReader::GetTagsOfInterest())
+     - set the input files
+     - call Update()
+     - pass the cache to a reader via DICOMFileReader::SetTagCache()
+
+    DICOMITKSeriesGDCMReader (and therefore all derived readers) calls Update()
+    on its own if such a cache is set as external tag cache.
+
+    New or changed files are scanned with DICOMGDCMTagScanner as long as all
+    tag paths refer to a single top-level tag (like the readers do), otherwise
+    DICOMDCMTKTagScanner is used.
+
+    @remark If tags are requested that are not part of the index yet, all files
+    have to be scanned again.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagCache : public DICOMTagCache
+  {
+    public:
+
+      mitkClassMacro(DICOMPersistentTagCache, DICOMTagCache);
+      itkFactorylessNewMacro( DICOMPersistentTagCache );
+      mitkNewMacro1Param( DICOMPersistentTagCache, const std::string& );
+
+      DICOMDatasetFinding GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const override;
+
+      FindingsListType GetTagValue(DICOMImageFrameInfo* frame, const DICOMTagPath& path) const override;
+
+      /**
+        \brief Frame infos of the input files (in input order).
+        @pre Update() must have been called after the last change of input files or tags.
+      */
+      DICOMDatasetAccessingImageFrameList GetFrameInfoList() const override;
+
+      /** File the index is loaded from and saved to. Changing it discards the index content
+       that was loaded so far.*/
+      void SetIndexFilePath(const std::string& path);
+      itkGetStringMacro(IndexFilePath);
+
+      void AddTag(const DICOMTag& tag);
+      void AddTagPath(const DICOMTagPath& path);
+      void AddTagPaths(const DICOMTagPathList& paths);
+
+      /**
+        \brief Brings the cache up to date for the current input files and tags.
+        Loads the index file (if not done yet), scans new or changed files and
+        saves the index file if anything changed.
+      */
+      void Update();
+
+      /** Number of files that had to be scanned by the last Update().*/
+      itkGetConstMacro(NumberOfScannedFiles, std::size_t);
+
+    protected:
+
+      DICOMPersistentTagCache();
+      explicit DICOMPersistentTagCache(const std::string& indexFilePath);
+      ~DICOMPersistentTagCache() override;
+
+      struct IndexEntry
+      {
+        std::uintmax_t fileSize = 0;
+        long long modificationTime = 0;
+        std::map<DICOMTagPath, std::string> values;
+      };
+
+      using IndexType = std::map<std::string, IndexEntry>;
+
+      /** Loads the index file. A missing or unreadable index file results in an empty index.*/
+      void LoadIndex();
+      void SaveIndex() const;
+
+      /** Returns the generic frame info for the passed frame or nullptr if the frame is unknown.*/
+      DICOMGenericImageFrameInfo* FindFrameInfo(const DICOMImageFrameInfo* frame) const;
+
+      std::string m_IndexFilePath;
+      bool m_IndexLoaded;
+
+      /** Tags of interest of the cache user(s).*/
+      std::set<DICOMTagPath> m_TagPaths;
+      /** Tags the entries of the index have been scanned for.*/
+      std::set<DICOMTagPath> m_IndexedTagPaths;
+      IndexType m_Index;
+
+      DICOMDatasetAccessingImageFrameList m_ScanResult;
+      std::map<std::string, DICOMGenericImageFrameInfo::Pointer> m_FrameInfoLookup;
+
+      std::size_t m_NumberOfScannedFiles;
+
+    private:
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
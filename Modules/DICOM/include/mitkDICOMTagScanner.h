@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <stack>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMTagPath.h"
@@ -86,8 +88,27 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+      \brief Number of worker threads used by Scan().
+      The input file list is split into contiguous partitions that are scanned
+      concurrently and merged in input order afterwards, so the scan result is
+      identical to a serial scan. Default is 1 (serial scan).
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
     protected:
 
+      /** Half-open range [first, second) of indices into the input file list.*/
+      using FileIndexRange = std::pair<std::size_t, std::size_t>;
+
+      /**
+      \brief Splits numberOfFiles into contiguous, ordered partitions, one per worker.
+      The number of partitions is limited by NumberOfThreads and by the
+      minimal number of files a worker should handle to be worth its start up.
+      */
+      std::vector<FileIndexRange> GetScanPartitions(std::size_t numberOfFiles) const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -104,6 +125,8 @@ namespace mitk
       DICOMTagScanner();
       ~DICOMTagScanner() override;
 
+      unsigned int m_NumberOfThreads;
+
     private:
 
       static std::mutex s_LocaleMutex;
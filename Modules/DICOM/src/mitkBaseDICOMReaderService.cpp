@@ -32,6 +32,7 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 #include <itksys/Directory.hxx>
+#include <itkMultiThreaderBase.h>
 
 namespace mitk
 {
@@ -142,6 +143,7 @@ std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::DoRead()
           mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
           scanner->AddTagPaths(reader->GetTagsOfInterest());
           scanner->SetInputFiles(relevantFiles);
+          scanner->SetNumberOfThreads(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
           scanner->Scan();
 
           reader->SetTagCache(scanner->GetScanCache());
@@ -16,6 +16,9 @@ found in the LICENSE file.
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
 
+#include <exception>
+#include <thread>
+
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
 }
@@ -98,61 +101,123 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
+namespace
+{
+  /** Scans one file for all given tag paths. Returns nullptr if the file could not be opened.*/
+  mitk::DICOMGenericImageFrameInfo::Pointer ScanFile(const std::string& fileName, const std::set<mitk::DICOMTagPath>& scannedTags, DcmPathProcessor& processor)
+  {
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFile(fileName.c_str());
+    if (cond.bad())
+    {
+      MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+      return nullptr;
+    }
+
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
+
+    for (const auto& path : scannedTags)
+    {
+      std::string tagPath = mitk::DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
+      {
+        OFList< DcmPath * > findings;
+        processor.getResults(findings);
+        for (const auto& finding : findings)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
+            }
+          }
+        }
+      }
+    }
+
+    return info;
+  }
+}
+
 void mitk::DICOMDCMTKTagScanner::Scan()
 {
   this->PushLocale();
 
   try
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
-
     DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
 
-    for (const auto& fileName : this->m_InputFilenames)
+    // Every worker scans a consecutive partition of the input into its own slots
+    // of the result list; the cache is filled in input order afterwards, so the
+    // result does not depend on the number of threads.
+    const auto partitions = this->GetScanPartitions(m_InputFilenames.size());
+    std::vector<DICOMGenericImageFrameInfo::Pointer> infos(m_InputFilenames.size());
+    std::vector<std::exception_ptr> errors(partitions.size());
+
+    auto scanPartition = [&infos, &errors, &partitions, this](std::size_t partitionIndex)
     {
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
-      {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
-      }
-      else
+      try
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        DcmPathProcessor processor;
+        processor.setItemWildcardSupport(true);
 
-        for (const auto& path : this->m_ScannedTags)
+        for (auto i = partitions[partitionIndex].first; i < partitions[partitionIndex].second; ++i)
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
-          {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
-          }
+          infos[i] = ScanFile(m_InputFilenames[i], m_ScannedTags, processor);
         }
+      }
+      catch (...)
+      {
+        errors[partitionIndex] = std::current_exception();
+      }
+    };
+
+    if (partitions.size() < 2)
+    {
+      scanPartition(0);
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(partitions.size());
+
+      for (std::size_t i = 0; i < partitions.size(); ++i)
+      {
+        threads.emplace_back(scanPartition, i);
+      }
+
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+    }
+
+    for (const auto& error : errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    for (const auto& info : infos)
+    {
+      if (info.IsNotNull())
+      {
         newCache->AddFrameInfo(info);
       }
     }
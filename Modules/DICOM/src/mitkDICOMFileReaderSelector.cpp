@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <usModuleResourceStream.h>
 #include <usModule.h>
 
+#include <itkMultiThreaderBase.h>
+
 mitk::DICOMFileReaderSelector
 ::DICOMFileReaderSelector()
 {
@@ -191,6 +193,7 @@ mitk::DICOMFileReaderSelector
   // do the tag scanning externally and just ONCE
   DICOMGDCMTagScanner::Pointer gdcmScanner = DICOMGDCMTagScanner::New();
   gdcmScanner->SetInputFiles( m_InputFilenames );
+  gdcmScanner->SetNumberOfThreads( itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() );
 
   // let all readers analyze the file set
   for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++rIter )
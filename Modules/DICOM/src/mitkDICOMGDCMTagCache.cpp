@@ -83,22 +83,36 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
 {
+  this->InitCache(scannedTags, { scanner }, { std::make_pair(std::size_t(0), inputFiles.size()) }, inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags,
+                                   const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                                   const std::vector<std::pair<std::size_t, std::size_t>>& partitions,
+                                   const StringList& inputFiles)
+{
+  if (scanners.size() != partitions.size())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). Number of scanners (" << scanners.size()
+                << ") does not match the number of file partitions (" << partitions.size() << ").";
+  }
+
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
-  for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
+  for (std::size_t partitionIndex = 0; partitionIndex < partitions.size(); ++partitionIndex)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    const auto& scanner = m_Scanners[partitionIndex];
+    for (auto fileIndex = partitions[partitionIndex].first; fileIndex < partitions[partitionIndex].second; ++fileIndex)
+    {
+      const auto& filename = m_InputFilenames[fileIndex];
+      m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(filename, 0),
+        scanner->GetMapping(filename.c_str())).GetPointer());
+    }
   }
 }
-
-const gdcm::Scanner&
-mitk::DICOMGDCMTagCache::GetScanner() const
-{
-  return *(this->m_Scanner);
-}
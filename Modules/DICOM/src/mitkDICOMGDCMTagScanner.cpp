@@ -16,6 +16,9 @@ found in the LICENSE file.
 
 #include <gdcmScanner.h>
 
+#include <exception>
+#include <thread>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
   m_GDCMScanner = std::make_shared<gdcm::Scanner>();
@@ -92,11 +95,64 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 
 void mitk::DICOMGDCMTagScanner::Scan()
 {
-  // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  const auto partitions = this->GetScanPartitions(m_InputFilenames.size());
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+
+  if (partitions.size() < 2)
+  {
+    // TODO integrate push/pop locale??
+    m_GDCMScanner->Scan( m_InputFilenames );
+    newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  }
+  else
+  {
+    // gdcm::Scanner instances are not shareable between threads, so every
+    // worker gets its own scanner for its consecutive partition of the input.
+    std::vector<std::shared_ptr<gdcm::Scanner>> scanners(partitions.size());
+    std::vector<std::exception_ptr> errors(partitions.size());
+    std::vector<std::thread> threads;
+    threads.reserve(partitions.size());
+
+    for (std::size_t i = 0; i < partitions.size(); ++i)
+    {
+      scanners[i] = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanners[i]->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+
+      threads.emplace_back([&scanner = scanners[i], &partition = partitions[i], &error = errors[i], this]()
+      {
+        // an exception must not leave the thread, it is rethrown after all workers joined
+        try
+        {
+          StringList filenames(m_InputFilenames.cbegin() + partition.first,
+                               m_InputFilenames.cbegin() + partition.second);
+          scanner->Scan(filenames);
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const auto& error : errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    newCache->InitCache(m_ScannedTags, scanners, partitions, m_InputFilenames);
+  }
 
   m_Cache = newCache;
 }
@@ -14,12 +14,14 @@ found in the LICENSE file.
 #define ENABLE_TIMING
 
 #include <itkTimeProbesCollectorBase.h>
+#include <itkMultiThreaderBase.h>
 #include <gdcmUIDs.h>
 #include "mitkDICOMITKSeriesGDCMReader.h"
 #include "mitkITKDICOMSeriesReaderHelper.h"
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 std::mutex mitk::DICOMITKSeriesGDCMReader::s_LocaleMutex;
 
@@ -237,6 +239,7 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     filescanner->SetInputFiles( inputFilenames );
     filescanner->AddTagPaths( this->GetTagsOfInterest() );
+    filescanner->SetNumberOfThreads( itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() );
 
     PushLocale();
     filescanner->Scan();
@@ -246,6 +249,15 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     timeStop("Tag scanning");
   }
+  else if (auto persistentCache = dynamic_cast<DICOMPersistentTagCache*>(m_TagCache.GetPointer()))
+  {
+    // persistent caches are cheap to update: only new or changed files are scanned
+    timeStart( "Tag index update" );
+    persistentCache->SetInputFiles( inputFilenames );
+    persistentCache->AddTagPaths( this->GetTagsOfInterest() );
+    persistentCache->Update();
+    timeStop( "Tag index update" );
+  }
   else
   {
     // ensure that the tag cache contains our required tags AND files and has scanned!
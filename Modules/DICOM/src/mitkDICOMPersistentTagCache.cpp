@@ -0,0 +1,498 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMDCMTKTagScanner.h"
+
+#include <itkMultiThreaderBase.h>
+
+#include <tinyxml2.h>
+
+#include <boost/beast/core/detail/base64.hpp>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+  constexpr int INDEX_VERSION = 2;
+
+  /** Checks if the string is valid UTF-8 and only contains characters that survive an
+   XML round trip unchanged (no control characters except tab and line feed).*/
+  bool IsXMLSafe(const std::string& value)
+  {
+    const auto* data = reinterpret_cast<const unsigned char*>(value.data());
+    const auto size = value.size();
+
+    for (std::size_t i = 0; i < size;)
+    {
+      const unsigned char c = data[i];
+      std::size_t length = 0;
+      std::uint32_t codePoint = 0;
+
+      if (c < 0x80)
+      {
+        if (c < 0x20 && c != '\t' && c != '\n')
+          return false;
+        ++i;
+        continue;
+      }
+      else if ((c & 0xE0) == 0xC0)
+      {
+        length = 2;
+        codePoint = c & 0x1F;
+      }
+      else if ((c & 0xF0) == 0xE0)
+      {
+        length = 3;
+        codePoint = c & 0x0F;
+      }
+      else if ((c & 0xF8) == 0xF0)
+      {
+        length = 4;
+        codePoint = c & 0x07;
+      }
+      else
+      {
+        return false;
+      }
+
+      if (i + length > size)
+        return false;
+
+      for (std::size_t j = 1; j < length; ++j)
+      {
+        if ((data[i + j] & 0xC0) != 0x80)
+          return false;
+        codePoint = (codePoint << 6) | (data[i + j] & 0x3F);
+      }
+
+      const bool overlong = (length == 2 && codePoint < 0x80) || (length == 3 && codePoint < 0x800) || (length == 4 && codePoint < 0x10000);
+      const bool invalid = codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint == 0xFFFE || codePoint == 0xFFFF;
+      if (overlong || invalid)
+        return false;
+
+      i += length;
+    }
+
+    return true;
+  }
+
+  std::string EncodeBase64(const std::string& value)
+  {
+    using namespace boost::beast::detail;
+
+    std::string encoded(base64::encoded_size(value.size()), '\0');
+    encoded.resize(base64::encode(encoded.data(), value.data(), value.size()));
+    return encoded;
+  }
+
+  std::string DecodeBase64(const std::string& encoded)
+  {
+    using namespace boost::beast::detail;
+
+    std::string value(base64::decoded_size(encoded.size()), '\0');
+    value.resize(base64::decode(value.data(), encoded.data(), encoded.size()).first);
+    return value;
+  }
+
+  /** Stores the string as text or, if it would not be written as valid XML, base64 encoded
+   in combination with the passed encoding attribute.*/
+  void SetSafeAttribute(tinyxml2::XMLElement* element, const char* name, const char* encodingName, const std::string& value)
+  {
+    if (IsXMLSafe(value))
+    {
+      element->SetAttribute(name, value.c_str());
+    }
+    else
+    {
+      element->SetAttribute(name, EncodeBase64(value).c_str());
+      element->SetAttribute(encodingName, "base64");
+    }
+  }
+
+  std::string GetSafeAttribute(const tinyxml2::XMLElement* element, const char* name, const char* encodingName)
+  {
+    const char* value = element->Attribute(name);
+    if (nullptr == value)
+      return std::string();
+
+    return element->Attribute(encodingName, "base64") ? DecodeBase64(value) : std::string(value);
+  }
+
+  void SetSafeText(tinyxml2::XMLElement* element, const std::string& value)
+  {
+    if (IsXMLSafe(value))
+    {
+      element->SetText(value.c_str());
+    }
+    else
+    {
+      element->SetText(EncodeBase64(value).c_str());
+      element->SetAttribute("encoding", "base64");
+    }
+  }
+
+  std::string GetSafeText(const tinyxml2::XMLElement* element)
+  {
+    const char* text = element->GetText();
+    if (nullptr == text)
+      return std::string();
+
+    return element->Attribute("encoding", "base64") ? DecodeBase64(text) : std::string(text);
+  }
+
+  bool GetFileStamp(const std::string& filename, std::uintmax_t& fileSize, long long& modificationTime)
+  {
+    std::error_code errorCode;
+    fileSize = std::filesystem::file_size(filename, errorCode);
+    if (errorCode)
+      return false;
+
+    const auto writeTime = std::filesystem::last_write_time(filename, errorCode);
+    if (errorCode)
+      return false;
+
+    modificationTime = static_cast<long long>(writeTime.time_since_epoch().count());
+    return true;
+  }
+}
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache()
+  : m_IndexLoaded(false), m_NumberOfScannedFiles(0)
+{
+}
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache(const std::string& indexFilePath)
+  : m_IndexFilePath(indexFilePath), m_IndexLoaded(false), m_NumberOfScannedFiles(0)
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+void mitk::DICOMPersistentTagCache::SetIndexFilePath(const std::string& path)
+{
+  if (path != m_IndexFilePath)
+  {
+    m_IndexFilePath = path;
+    m_IndexLoaded = false;
+    m_Index.clear();
+    m_IndexedTagPaths.clear();
+    this->Modified();
+  }
+}
+
+void mitk::DICOMPersistentTagCache::AddTag(const DICOMTag& tag)
+{
+  this->AddTagPath(DICOMTagPath(tag));
+}
+
+void mitk::DICOMPersistentTagCache::AddTagPath(const DICOMTagPath& path)
+{
+  if (m_TagPaths.insert(path).second)
+  {
+    this->Modified();
+  }
+}
+
+void mitk::DICOMPersistentTagCache::AddTagPaths(const DICOMTagPathList& paths)
+{
+  for (const auto& path : paths)
+  {
+    this->AddTagPath(path);
+  }
+}
+
+mitk::DICOMGenericImageFrameInfo* mitk::DICOMPersistentTagCache::FindFrameInfo(const DICOMImageFrameInfo* frame) const
+{
+  assert(frame);
+
+  const auto finding = m_FrameInfoLookup.find(frame->Filename);
+  if (finding != m_FrameInfoLookup.cend() && finding->second->FrameNo == frame->FrameNo)
+  {
+    return finding->second;
+  }
+  return nullptr;
+}
+
+mitk::DICOMDatasetFinding mitk::DICOMPersistentTagCache::GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const
+{
+  auto info = this->FindFrameInfo(frame);
+
+  if (nullptr != info)
+  {
+    return info->GetTagValueAsString(tag);
+  }
+
+  return DICOMDatasetFinding();
+}
+
+mitk::DICOMDatasetAccess::FindingsListType
+mitk::DICOMPersistentTagCache::GetTagValue(DICOMImageFrameInfo* frame, const DICOMTagPath& path) const
+{
+  auto info = this->FindFrameInfo(frame);
+
+  if (nullptr != info)
+  {
+    return info->GetTagValueAsString(path);
+  }
+
+  return FindingsListType();
+}
+
+mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMPersistentTagCache::GetFrameInfoList() const
+{
+  return m_ScanResult;
+}
+
+void mitk::DICOMPersistentTagCache::Update()
+{
+  if (!m_IndexLoaded)
+  {
+    this->LoadIndex();
+  }
+
+  m_NumberOfScannedFiles = 0;
+  bool indexChanged = false;
+
+  if (!std::includes(m_IndexedTagPaths.cbegin(), m_IndexedTagPaths.cend(), m_TagPaths.cbegin(), m_TagPaths.cend()))
+  {
+    // The index does not know all requested tags, so every file has to be rescanned.
+    // Keep the tags indexed so far, so that alternating users of the index do not invalidate each other.
+    m_IndexedTagPaths.insert(m_TagPaths.cbegin(), m_TagPaths.cend());
+    m_Index.clear();
+    indexChanged = true;
+  }
+
+  StringList staleFiles;
+  std::map<std::string, std::pair<std::uintmax_t, long long>> staleFileStamps;
+
+  for (const auto& filename : m_InputFilenames)
+  {
+    std::uintmax_t fileSize = 0;
+    long long modificationTime = 0;
+    const bool hasStamp = GetFileStamp(filename, fileSize, modificationTime);
+
+    const auto finding = m_Index.find(filename);
+    if (!hasStamp || finding == m_Index.cend() || finding->second.fileSize != fileSize || finding->second.modificationTime != modificationTime)
+    {
+      if (staleFileStamps.emplace(filename, std::make_pair(fileSize, modificationTime)).second)
+      {
+        staleFiles.push_back(filename);
+      }
+    }
+  }
+
+  if (!staleFiles.empty())
+  {
+    const bool onlyTopLevelTags = std::all_of(m_IndexedTagPaths.cbegin(), m_IndexedTagPaths.cend(),
+      [](const DICOMTagPath& path) { return path.Size() == 1 && path.IsExplicit(); });
+
+    DICOMTagScanner::Pointer scanner;
+    if (onlyTopLevelTags)
+    {
+      scanner = DICOMGDCMTagScanner::New().GetPointer();
+    }
+    else
+    {
+      scanner = DICOMDCMTKTagScanner::New().GetPointer();
+    }
+
+    scanner->SetInputFiles(staleFiles);
+    scanner->AddTagPaths(DICOMTagPathList(m_IndexedTagPaths.cbegin(), m_IndexedTagPaths.cend()));
+    scanner->SetNumberOfThreads(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+    scanner->Scan();
+
+    for (const auto& filename : staleFiles)
+    {
+      m_Index.erase(filename);
+    }
+
+    for (const auto& info : scanner->GetFrameInfoList())
+    {
+      const auto& stamp = staleFileStamps[info->Filename];
+
+      IndexEntry entry;
+      entry.fileSize = stamp.first;
+      entry.modificationTime = stamp.second;
+
+      for (const auto& path : m_IndexedTagPaths)
+      {
+        for (const auto& finding : info->GetTagValueAsString(path))
+        {
+          if (finding.isValid)
+          {
+            // scanners that only support explicit top-level tags do not report the path of the finding
+            entry.values[finding.path.Size() > 0 ? finding.path : path] = finding.value;
+          }
+        }
+      }
+
+      m_Index[info->Filename] = entry;
+    }
+
+    m_NumberOfScannedFiles = staleFiles.size();
+    indexChanged = true;
+  }
+
+  m_ScanResult.clear();
+  m_ScanResult.reserve(m_InputFilenames.size());
+  m_FrameInfoLookup.clear();
+
+  for (const auto& filename : m_InputFilenames)
+  {
+    const auto finding = m_Index.find(filename);
+    if (finding != m_Index.cend())
+    {
+      auto info = DICOMGenericImageFrameInfo::New(filename);
+      for (const auto& value : finding->second.values)
+      {
+        info->SetTagValue(value.first, value.second);
+      }
+      m_ScanResult.push_back(info.GetPointer());
+      m_FrameInfoLookup[filename] = info;
+    }
+  }
+
+  if (indexChanged && !m_IndexFilePath.empty())
+  {
+    this->SaveIndex();
+  }
+
+  this->Modified();
+}
+
+void mitk::DICOMPersistentTagCache::LoadIndex()
+{
+  m_Index.clear();
+  m_IndexedTagPaths.clear();
+  m_IndexLoaded = true;
+
+  if (m_IndexFilePath.empty() || !std::filesystem::exists(m_IndexFilePath))
+  {
+    return;
+  }
+
+  tinyxml2::XMLDocument doc;
+  if (tinyxml2::XML_SUCCESS != doc.LoadFile(m_IndexFilePath.c_str()))
+  {
+    MITK_WARN << "Cannot read DICOM tag index. Index will be rebuilt. File: " << m_IndexFilePath;
+    return;
+  }
+
+  auto rootElement = doc.FirstChildElement("DICOMTagIndex");
+  if (nullptr == rootElement || rootElement->IntAttribute("version") != INDEX_VERSION)
+  {
+    MITK_WARN << "Unsupported DICOM tag index. Index will be rebuilt. File: " << m_IndexFilePath;
+    return;
+  }
+
+  // tag paths are stored once and referenced by id, parsing them is comparably expensive
+  std::map<int, DICOMTagPath> pathsById;
+  for (auto element = rootElement->FirstChildElement("Path"); nullptr != element; element = element->NextSiblingElement("Path"))
+  {
+    pathsById[element->IntAttribute("id")] = DICOMTagPath().FromStr(element->Attribute("path"));
+  }
+
+  for (auto element = rootElement->FirstChildElement("Tag"); nullptr != element; element = element->NextSiblingElement("Tag"))
+  {
+    m_IndexedTagPaths.insert(pathsById[element->IntAttribute("path")]);
+  }
+
+  for (auto fileElement = rootElement->FirstChildElement("File"); nullptr != fileElement; fileElement = fileElement->NextSiblingElement("File"))
+  {
+    IndexEntry entry;
+    entry.fileSize = static_cast<std::uintmax_t>(fileElement->Int64Attribute("size"));
+    entry.modificationTime = fileElement->Int64Attribute("mtime");
+
+    for (auto valueElement = fileElement->FirstChildElement("Value"); nullptr != valueElement; valueElement = valueElement->NextSiblingElement("Value"))
+    {
+      entry.values[pathsById[valueElement->IntAttribute("path")]] = GetSafeText(valueElement);
+    }
+
+    m_Index[GetSafeAttribute(fileElement, "path", "pathEncoding")] = entry;
+  }
+}
+
+void mitk::DICOMPersistentTagCache::SaveIndex() const
+{
+  std::map<DICOMTagPath, int> idsByPath;
+  for (const auto& path : m_IndexedTagPaths)
+  {
+    idsByPath.emplace(path, static_cast<int>(idsByPath.size()));
+  }
+  for (const auto& entry : m_Index)
+  {
+    for (const auto& value : entry.second.values)
+    {
+      idsByPath.emplace(value.first, static_cast<int>(idsByPath.size()));
+    }
+  }
+
+  tinyxml2::XMLDocument doc;
+  doc.InsertEndChild(doc.NewDeclaration());
+
+  auto rootElement = doc.NewElement("DICOMTagIndex");
+  rootElement->SetAttribute("version", INDEX_VERSION);
+  doc.InsertEndChild(rootElement);
+
+  for (const auto& path : idsByPath)
+  {
+    auto element = doc.NewElement("Path");
+    element->SetAttribute("id", path.second);
+    element->SetAttribute("path", path.first.ToStr().c_str());
+    rootElement->InsertEndChild(element);
+  }
+
+  for (const auto& path : m_IndexedTagPaths)
+  {
+    auto element = doc.NewElement("Tag");
+    element->SetAttribute("path", idsByPath[path]);
+    rootElement->InsertEndChild(element);
+  }
+
+  for (const auto& entry : m_Index)
+  {
+    auto fileElement = doc.NewElement("File");
+    SetSafeAttribute(fileElement, "path", "pathEncoding", entry.first);
+    fileElement->SetAttribute("size", static_cast<int64_t>(entry.second.fileSize));
+    fileElement->SetAttribute("mtime", static_cast<int64_t>(entry.second.modificationTime));
+
+    for (const auto& value : entry.second.values)
+    {
+      auto valueElement = doc.NewElement("Value");
+      valueElement->SetAttribute("path", idsByPath[value.first]);
+      SetSafeText(valueElement, value.second);
+      fileElement->InsertEndChild(valueElement);
+    }
+
+    rootElement->InsertEndChild(fileElement);
+  }
+
+  // write to a temporary file first to never leave a truncated index behind
+  const std::string temporaryPath = m_IndexFilePath + ".tmp";
+  if (tinyxml2::XML_SUCCESS != doc.SaveFile(temporaryPath.c_str()))
+  {
+    MITK_WARN << "Cannot write DICOM tag index. File: " << m_IndexFilePath;
+    return;
+  }
+
+  std::error_code errorCode;
+  std::filesystem::rename(temporaryPath, m_IndexFilePath, errorCode);
+  if (errorCode)
+  {
+    MITK_WARN << "Cannot write DICOM tag index. File: " << m_IndexFilePath << ". Reason: " << errorCode.message();
+  }
+}
@@ -12,9 +12,18 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <algorithm>
+
 std::mutex mitk::DICOMTagScanner::s_LocaleMutex;
 
+namespace
+{
+  /** Below this number of files per worker, thread start up costs more than it saves.*/
+  constexpr std::size_t MINIMUM_FILES_PER_SCAN_THREAD = 32;
+}
+
 mitk::DICOMTagScanner::DICOMTagScanner()
+  : m_NumberOfThreads(1)
 {
 }
 
@@ -70,3 +79,20 @@ std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
 }
+
+std::vector<mitk::DICOMTagScanner::FileIndexRange>
+mitk::DICOMTagScanner::GetScanPartitions(std::size_t numberOfFiles) const
+{
+  std::size_t numberOfPartitions = std::max<std::size_t>(1, m_NumberOfThreads);
+  numberOfPartitions = std::min(numberOfPartitions, std::max<std::size_t>(1, numberOfFiles / MINIMUM_FILES_PER_SCAN_THREAD));
+
+  std::vector<FileIndexRange> result;
+  result.reserve(numberOfPartitions);
+
+  for (std::size_t i = 0; i < numberOfPartitions; ++i)
+  {
+    result.emplace_back(i * numberOfFiles / numberOfPartitions, (i + 1) * numberOfFiles / numberOfPartitions);
+  }
+
+  return result;
+}
@@ -24,6 +24,7 @@ class mitkDICOMDCMTKTagScannerTestSuite : public mitk::TestFixture
 
   MITK_TEST(DeepScanning);
   MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -119,6 +120,44 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", findings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
   }
 
+
+  void ParallelScanning()
+  {
+    mitk::DICOMTagPath instanceUID(0x0008, 0x0018);
+
+    // repeat the files to get enough input to be split across several workers
+    mitk::StringList manyFiles;
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+      manyFiles.insert(manyFiles.end(), ctFiles.cbegin(), ctFiles.cend());
+    }
+
+    scanner->SetInputFiles(manyFiles);
+    scanner->AddTagPath(instanceUID);
+    scanner->Scan();
+    mitk::DICOMDatasetAccessingImageFrameList serialFrames = scanner->GetFrameInfoList();
+
+    mitk::DICOMDCMTKTagScanner::Pointer parallelScanner = mitk::DICOMDCMTKTagScanner::New();
+    parallelScanner->SetInputFiles(manyFiles);
+    parallelScanner->AddTagPath(instanceUID);
+    parallelScanner->SetNumberOfThreads(4);
+    parallelScanner->Scan();
+    mitk::DICOMDatasetAccessingImageFrameList parallelFrames = parallelScanner->GetFrameInfoList();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of parallel scan", parallelFrames.size() == manyFiles.size());
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of serial scan", serialFrames.size() == manyFiles.size());
+
+    for (std::size_t i = 0; i < manyFiles.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing file order of parallel scan", parallelFrames[i]->Filename == manyFiles[i]);
+
+      auto serialFindings = serialFrames[i]->GetTagValueAsString(instanceUID);
+      auto parallelFindings = parallelFrames[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Testing number of findings of parallel scan", parallelFindings.size() == 1 && serialFindings.size() == 1);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of parallel scan", parallelFindings.front().value == serialFindings.front().value);
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkDICOMDCMTKTagScanner)
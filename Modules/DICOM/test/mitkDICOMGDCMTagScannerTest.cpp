@@ -0,0 +1,97 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkDICOMGDCMTagScannerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMGDCMTagScannerTestSuite);
+
+  MITK_TEST(ParallelScanning);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  std::vector<mitk::DICOMTag> tags;
+
+  mitk::DICOMDatasetAccessingImageFrameList Scan(const mitk::StringList& files, unsigned int numberOfThreads)
+  {
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(files);
+    for (const auto& tag : tags)
+    {
+      scanner->AddTag(tag);
+    }
+    scanner->SetNumberOfThreads(numberOfThreads);
+    scanner->Scan();
+    return scanner->GetFrameInfoList();
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    tags.clear();
+    tags.push_back(mitk::DICOMTag(0x0008, 0x0018)); // SOP instance UID
+    tags.push_back(mitk::DICOMTag(0x0020, 0x000e)); // series instance UID
+    tags.push_back(mitk::DICOMTag(0x0020, 0x0032)); // image position patient
+    tags.push_back(mitk::DICOMTag(0x0020, 0x0013)); // instance number
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void ParallelScanning()
+  {
+    // repeat the files to get enough input to be split across several workers
+    mitk::StringList manyFiles;
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+      manyFiles.insert(manyFiles.end(), ctFiles.cbegin(), ctFiles.cend());
+    }
+
+    const auto serialFrames = this->Scan(manyFiles, 1);
+    const auto parallelFrames = this->Scan(manyFiles, 4);
+
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of serial scan", serialFrames.size() == manyFiles.size());
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of parallel scan", parallelFrames.size() == manyFiles.size());
+
+    for (std::size_t i = 0; i < manyFiles.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing file order of parallel scan", parallelFrames[i]->Filename == manyFiles[i]);
+
+      for (const auto& tag : tags)
+      {
+        const auto serialFinding = serialFrames[i]->GetTagValueAsString(tag);
+        const auto parallelFinding = parallelFrames[i]->GetTagValueAsString(tag);
+        CPPUNIT_ASSERT_MESSAGE("Testing validity of serial scan", serialFinding.isValid);
+        CPPUNIT_ASSERT_MESSAGE("Testing validity of parallel scan", parallelFinding.isValid);
+        CPPUNIT_ASSERT_MESSAGE("Testing value of parallel scan", parallelFinding.value == serialFinding.value);
+      }
+    }
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMGDCMTagScanner)
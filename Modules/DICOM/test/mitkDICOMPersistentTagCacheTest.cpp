@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+
+#include <cstdio>
+
+namespace
+{
+  /** Grants access to the index to inject values that are not valid UTF-8.*/
+  class TestPersistentTagCache : public mitk::DICOMPersistentTagCache
+  {
+  public:
+    mitkClassMacro(TestPersistentTagCache, mitk::DICOMPersistentTagCache);
+    mitkNewMacro1Param(TestPersistentTagCache, const std::string&);
+
+    using Superclass::LoadIndex;
+    using Superclass::SaveIndex;
+    using Superclass::m_Index;
+
+  protected:
+    explicit TestPersistentTagCache(const std::string& indexFilePath) : Superclass(indexFilePath) {}
+  };
+}
+
+class mitkDICOMPersistentTagCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheTestSuite);
+
+  MITK_TEST(ScanAndReuseIndex);
+  MITK_TEST(NewTagsInvalidateIndex);
+  MITK_TEST(NonUTF8ValuesRoundTrip);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  std::string indexFile;
+
+  const mitk::DICOMTag instanceUID = mitk::DICOMTag(0x0008, 0x0018);
+  const mitk::DICOMTag instanceNumber = mitk::DICOMTag(0x0020, 0x0013);
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    indexFile = mitk::IOUtil::GetTempPath() + "/mitkDICOMPersistentTagCacheTest_index.xml";
+    std::remove(indexFile.c_str());
+  }
+
+  void tearDown() override
+  {
+    std::remove(indexFile.c_str());
+  }
+
+  void ScanAndReuseIndex()
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+    auto refFrames = scanner->GetFrameInfoList();
+
+    auto cache = mitk::DICOMPersistentTagCache::New(indexFile);
+    cache->SetInputFiles(ctFiles);
+    cache->AddTag(instanceUID);
+    cache->Update();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of scanned files of initial update", std::size_t(4), cache->GetNumberOfScannedFiles());
+
+    auto reloadedCache = mitk::DICOMPersistentTagCache::New(indexFile);
+    reloadedCache->SetInputFiles(ctFiles);
+    reloadedCache->AddTag(instanceUID);
+    reloadedCache->Update();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of scanned files of update with existing index", std::size_t(0), reloadedCache->GetNumberOfScannedFiles());
+
+    auto frames = reloadedCache->GetFrameInfoList();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of frames", refFrames.size(), frames.size());
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing file order", refFrames[i]->Filename, frames[i]->Filename);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing indexed value", refFrames[i]->GetTagValueAsString(instanceUID).value, frames[i]->GetTagValueAsString(instanceUID).value);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing GetTagValue()", refFrames[i]->GetTagValueAsString(instanceUID).value, reloadedCache->GetTagValue(frames[i], instanceUID).value);
+    }
+  }
+
+  void NewTagsInvalidateIndex()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New(indexFile);
+    cache->SetInputFiles(ctFiles);
+    cache->AddTag(instanceUID);
+    cache->Update();
+
+    auto extendedCache = mitk::DICOMPersistentTagCache::New(indexFile);
+    extendedCache->SetInputFiles(ctFiles);
+    extendedCache->AddTag(instanceNumber);
+    extendedCache->Update();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of scanned files after adding a tag", std::size_t(4), extendedCache->GetNumberOfScannedFiles());
+
+    auto frames = extendedCache->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing previously indexed tag is kept", frames.front()->GetTagValueAsString(instanceUID).isValid);
+    CPPUNIT_ASSERT_MESSAGE("Testing new tag is indexed", frames.front()->GetTagValueAsString(instanceNumber).isValid);
+  }
+
+  void NonUTF8ValuesRoundTrip()
+  {
+    const std::string latin1Value("M\xfcller^J\xf6rg");
+    const std::string controlValue("A\x01" "B\r\n", 5);
+    const std::string utf8Value("M\xc3\xbcller");
+    const std::string latin1Path("/data/\xe4rzte/1.dcm");
+
+    auto cache = TestPersistentTagCache::New(indexFile);
+    auto& entry = cache->m_Index[latin1Path];
+    entry.fileSize = 42;
+    entry.modificationTime = 4711;
+    entry.values[mitk::DICOMTagPath(instanceUID)] = latin1Value;
+    entry.values[mitk::DICOMTagPath(instanceNumber)] = controlValue;
+    entry.values[mitk::DICOMTagPath(0x0010, 0x0010)] = utf8Value;
+    cache->SaveIndex();
+
+    auto reloadedCache = TestPersistentTagCache::New(indexFile);
+    reloadedCache->LoadIndex();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of index entries", std::size_t(1), reloadedCache->m_Index.size());
+    auto finding = reloadedCache->m_Index.find(latin1Path);
+    CPPUNIT_ASSERT_MESSAGE("Testing non UTF-8 file path", finding != reloadedCache->m_Index.end());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing file size", std::uintmax_t(42), finding->second.fileSize);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing Latin-1 value", latin1Value, finding->second.values[mitk::DICOMTagPath(instanceUID)]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing value with control characters", controlValue, finding->second.values[mitk::DICOMTagPath(instanceNumber)]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing UTF-8 value", utf8Value, finding->second.values[mitk::DICOMTagPath(0x0010, 0x0010)]);
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCache)
@@ -54,6 +54,7 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestUS4DCroppedParallelTimeSteps);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +85,8 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestUS4DCroppedParallelTimeSteps();
 private:
   mitk::Image::ConstPointer m_TestImage;
 
@@ -1026,6 +1029,80 @@ void mitkImageStatisticsCalculatorTestSuite::TestUS4DCropped3DMask()
     expected_maxIndex);
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestUS4DCroppedParallelTimeSteps()
+{
+  MITK_INFO << std::endl << "Test US4D cropped with binary mask and parallel timesteps:-----------------------------------------------------------------------------------";
+
+  std::string US4DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/US4D_cropped.nrrd");
+  m_US4DCroppedImage = mitk::IOUtil::Load<mitk::Image>(US4DCroppedFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading US4D_cropped", m_US4DCroppedImage.IsNotNull());
+
+  std::string US4DCroppedBinMaskFile = this->GetTestDataFilePath("ImageStatisticsTestData/US4D_croppedBinMask.nrrd");
+  m_US4DCroppedBinMask = mitk::IOUtil::Load<mitk::Image>(US4DCroppedBinMaskFile);
+  CPPUNIT_ASSERT_MESSAGE("Failed loading US4D binary mask", m_US4DCroppedBinMask.IsNotNull());
+
+  mitk::ImageMaskGenerator::Pointer serialMaskGen = mitk::ImageMaskGenerator::New();
+  serialMaskGen->SetInputImage(m_US4DCroppedImage);
+  serialMaskGen->SetImageMask(m_US4DCroppedBinMask);
+  mitk::ImageStatisticsCalculator::Pointer serialCalculator = mitk::ImageStatisticsCalculator::New();
+  serialCalculator->SetInputImage(m_US4DCroppedImage);
+  serialCalculator->SetMask(serialMaskGen.GetPointer());
+
+  mitk::ImageMaskGenerator::Pointer parallelMaskGen = mitk::ImageMaskGenerator::New();
+  parallelMaskGen->SetInputImage(m_US4DCroppedImage);
+  parallelMaskGen->SetImageMask(m_US4DCroppedBinMask);
+  mitk::ImageStatisticsCalculator::Pointer parallelCalculator = mitk::ImageStatisticsCalculator::New();
+  parallelCalculator->SetInputImage(m_US4DCroppedImage);
+  parallelCalculator->SetMask(parallelMaskGen.GetPointer());
+  parallelCalculator->ParallelizeTimeStepsOn();
+  CPPUNIT_ASSERT(parallelCalculator->GetParallelizeTimeSteps());
+
+  mitk::ImageStatisticsContainer::Pointer serialStatistics;
+  mitk::ImageStatisticsContainer::Pointer parallelStatistics;
+  CPPUNIT_ASSERT_NO_THROW(serialStatistics = serialCalculator->GetStatistics(1));
+  CPPUNIT_ASSERT_NO_THROW(parallelStatistics = parallelCalculator->GetStatistics(1));
+  CPPUNIT_ASSERT(serialStatistics.IsNotNull());
+  CPPUNIT_ASSERT(parallelStatistics.IsNotNull());
+
+  const auto timeSteps = m_US4DCroppedImage->GetTimeSteps();
+  CPPUNIT_ASSERT_EQUAL(serialStatistics->GetNumberOfTimeSteps(), parallelStatistics->GetNumberOfTimeSteps());
+  for (unsigned int timeStep = 0; timeStep < timeSteps; ++timeStep)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Serial statistics miss a timestep", serialStatistics->TimeStepExists(timeStep));
+    CPPUNIT_ASSERT_MESSAGE("Parallel statistics miss a timestep", parallelStatistics->TimeStepExists(timeStep));
+
+    const auto& serialObject = serialStatistics->GetStatisticsForTimeStep(timeStep);
+    const auto& parallelObject = parallelStatistics->GetStatisticsForTimeStep(timeStep);
+    const auto names = serialObject.GetExistingStatisticNames();
+    CPPUNIT_ASSERT_EQUAL(names.size(), parallelObject.GetExistingStatisticNames().size());
+
+    for (const auto& name : names)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Parallel statistics miss " + name, parallelObject.HasStatistic(name));
+      const auto serialValue = serialObject.GetValueNonConverted(name);
+      const auto parallelValue = parallelObject.GetValueNonConverted(name);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Type of " + name + " differs", serialValue.which(), parallelValue.which());
+
+      if (const auto* serialReal = boost::get<mitk::ImageStatisticsContainer::RealType>(&serialValue))
+      {
+        const auto parallelReal = boost::get<mitk::ImageStatisticsContainer::RealType>(parallelValue);
+        if (std::isnan(*serialReal))
+        {
+          CPPUNIT_ASSERT_MESSAGE("Parallel value of " + name + " is not NaN", std::isnan(parallelReal));
+        }
+        else
+        {
+          CPPUNIT_ASSERT_MESSAGE("Parallel value of " + name + " differs", std::abs(*serialReal - parallelReal) < mitk::eps);
+        }
+      }
+      else
+      {
+        CPPUNIT_ASSERT_MESSAGE("Parallel value of " + name + " differs", serialValue == parallelValue);
+      }
+    }
+  }
+}
+
 mitk::PlanarPolygon::Pointer mitkImageStatisticsCalculatorTestSuite::GeneratePlanarPolygon(mitk::PlaneGeometry::Pointer geometry, std::vector <mitk::Point2D> points)
 {
   mitk::PlanarPolygon::Pointer figure = mitk::PlanarPolygon::New();
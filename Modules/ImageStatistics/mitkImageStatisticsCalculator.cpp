@@ -24,6 +24,11 @@ found in the LICENSE file.
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <itkMultiThreaderBase.h>
+
+#include <exception>
+#include <thread>
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -106,89 +111,206 @@ namespace mitk
     {
       auto timeGeometry = m_Image->GetTimeGeometry();
       // always compute statistics on all timesteps
-      for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
+      if (m_ParallelizeTimeSteps && m_Image->GetTimeSteps() > 1)
+      {
+        this->CalculateStatisticsForTimeStepsInParallel(timeGeometry);
+      }
+      else
       {
-        if (m_MaskGenerator.IsNotNull())
+        for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
         {
-          m_MaskGenerator->SetTimeStep(timeStep);
-          //See T25625: otherwise, the mask is not computed again after setting a different time step
-          m_MaskGenerator->Modified();
-          m_InternalMask = m_MaskGenerator->GetMask();
-          if (m_MaskGenerator->GetReferenceImage().IsNotNull())
+          this->CalculateStatisticsForTimeStep(this->PrepareTimeStep(timeStep), timeGeometry, 0);
+        }
+      }
+    }
+
+    auto it = m_StatisticContainers.find(label);
+    if (it != m_StatisticContainers.end())
+    {
+      return (it->second).GetPointer();
+    }
+    else
+    {
+      mitkThrow() << "unknown label";
+      return nullptr;
+    }
+  }
+
+  ImageStatisticsCalculator::TimeStepInput ImageStatisticsCalculator::PrepareTimeStep(TimeStepType timeStep)
+  {
+    TimeStepInput input;
+    input.timeStep = timeStep;
+
+    if (m_MaskGenerator.IsNotNull())
+    {
+      m_MaskGenerator->SetTimeStep(timeStep);
+      //See T25625: otherwise, the mask is not computed again after setting a different time step
+      m_MaskGenerator->Modified();
+      input.mask = m_MaskGenerator->GetMask();
+      if (m_MaskGenerator->GetReferenceImage().IsNotNull())
+      {
+        input.imageForStatistics = m_MaskGenerator->GetReferenceImage();
+      }
+      else
+      {
+        input.imageForStatistics = m_Image;
+      }
+    }
+    else
+    {
+      input.imageForStatistics = m_Image;
+    }
+
+    if (m_SecondaryMaskGenerator.IsNotNull())
+    {
+      m_SecondaryMaskGenerator->SetTimeStep(timeStep);
+      input.secondaryMask = m_SecondaryMaskGenerator->GetMask();
+    }
+
+    ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
+    imgTimeSel->SetInput(input.imageForStatistics);
+    imgTimeSel->SetTimeNr(timeStep);
+    imgTimeSel->UpdateLargestPossibleRegion();
+    imgTimeSel->Update();
+    input.imageTimeSlice = imgTimeSel->GetOutput();
+
+    // workaround: if m_SecondaryMaskGenerator ist not null but m_MaskGenerator is! (this is the case if we request a
+    // 'ignore zuero valued pixels' mask in the gui but do not define a primary mask)
+    if (input.secondaryMask.IsNotNull() && input.mask.IsNull())
+    {
+      input.mask = input.secondaryMask;
+      input.secondaryMask = nullptr;
+    }
+
+    // dirty workaround for a bug when pf mask + any other mask is used in conjunction. We need a proper fix for this
+    // (Fabian Isensee is responsible and probably working on it!)
+    if (input.secondaryMask.IsNotNull() && input.mask->GetDimension() == 2 &&
+        (input.secondaryMask->GetDimension() == 3 || input.secondaryMask->GetDimension() == 4))
+    {
+      mitk::Image::ConstPointer old_img = m_SecondaryMaskGenerator->GetReferenceImage();
+      m_SecondaryMaskGenerator->SetInputImage(m_MaskGenerator->GetReferenceImage());
+      input.secondaryMask = m_SecondaryMaskGenerator->GetMask();
+      m_SecondaryMaskGenerator->SetInputImage(old_img);
+    }
+
+    return input;
+  }
+
+  void ImageStatisticsCalculator::CalculateStatisticsForTimeStep(const TimeStepInput &input,
+                                                                 const TimeGeometry *timeGeometry,
+                                                                 unsigned int numberOfWorkUnits)
+  {
+    // Calculate statistics with/without mask
+    if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
+    {
+      // 1) calculate statistics unmasked:
+      AccessByItk_n(input.imageTimeSlice.GetPointer(),
+                    InternalCalculateStatisticsUnmasked,
+                    (timeGeometry, input.timeStep, numberOfWorkUnits));
+    }
+    else
+    {
+      // 2) calculate statistics masked
+      AccessByItk_n(input.imageTimeSlice.GetPointer(),
+                    InternalCalculateStatisticsMasked,
+                    (timeGeometry, input, numberOfWorkUnits));
+    }
+  }
+
+  void ImageStatisticsCalculator::CalculateStatisticsForTimeStepsInParallel(const TimeGeometry *timeGeometry)
+  {
+    const TimeStepType numberOfTimeSteps = m_Image->GetTimeSteps();
+    const unsigned int numberOfAvailableThreads =
+      std::max(1u, static_cast<unsigned int>(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+    const auto numberOfThreads = static_cast<unsigned int>(std::min<TimeStepType>(numberOfTimeSteps, numberOfAvailableThreads));
+    // share the remaining threads between the filters of the concurrently processed time steps
+    const unsigned int numberOfWorkUnits = std::max(1u, numberOfAvailableThreads / numberOfThreads);
+
+    std::mutex mutex;
+    TimeStepType nextTimeStep = 0;
+    std::exception_ptr exception;
+
+    auto worker = [&]() {
+      while (true)
+      {
+        TimeStepInput input;
+        {
+          // mask generators and the time selection are not thread safe, so the inputs are prepared one after the other
+          std::lock_guard<std::mutex> lock(mutex);
+          if (exception || nextTimeStep >= numberOfTimeSteps)
+            return;
+
+          try
           {
-            m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
+            input = this->PrepareTimeStep(nextTimeStep++);
           }
-          else
+          catch (...)
           {
-            m_InternalImageForStatistics = m_Image;
+            exception = std::current_exception();
+            return;
           }
         }
-        else
-        {
-          m_InternalImageForStatistics = m_Image;
-        }
 
-        if (m_SecondaryMaskGenerator.IsNotNull())
+        try
         {
-          m_SecondaryMaskGenerator->SetTimeStep(timeStep);
-          m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
+          this->CalculateStatisticsForTimeStep(input, timeGeometry, numberOfWorkUnits);
         }
-
-        ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
-        imgTimeSel->SetInput(m_InternalImageForStatistics);
-        imgTimeSel->SetTimeNr(timeStep);
-        imgTimeSel->UpdateLargestPossibleRegion();
-        imgTimeSel->Update();
-        m_ImageTimeSlice = imgTimeSel->GetOutput();
-
-        // Calculate statistics with/without mask
-        if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
+        catch (...)
         {
-          // 1) calculate statistics unmasked:
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeGeometry, timeStep)
-        }
-        else
-        {
-          // 2) calculate statistics masked
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeGeometry, timeStep)
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!exception)
+            exception = std::current_exception();
+          return;
         }
       }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back(worker);
     }
+    worker();
 
-    auto it = m_StatisticContainers.find(label);
-    if (it != m_StatisticContainers.end())
+    for (auto &thread : threads)
     {
-      return (it->second).GetPointer();
+      thread.join();
     }
-    else
+
+    if (exception)
     {
-      mitkThrow() << "unknown label";
-      return nullptr;
+      std::rethrow_exception(exception);
+    }
+  }
+
+  void ImageStatisticsCalculator::SetStatisticsForTimeStep(LabelIndex label,
+                                                           const TimeGeometry *timeGeometry,
+                                                           TimeStepType timeStep,
+                                                           const ImageStatisticsContainer::ImageStatisticsObject &statistics)
+  {
+    std::lock_guard<std::mutex> lock(m_StatisticContainersMutex);
+
+    auto &statisticContainer = m_StatisticContainers[label];
+    if (statisticContainer.IsNull())
+    {
+      statisticContainer = ImageStatisticsContainer::New();
+      statisticContainer->SetTimeGeometry(const_cast<mitk::TimeGeometry *>(timeGeometry));
     }
+    statisticContainer->SetStatisticsForTimeStep(timeStep, statistics);
   }
 
   template <typename TPixel, unsigned int VImageDimension>
   void ImageStatisticsCalculator::InternalCalculateStatisticsUnmasked(
-    typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
+    typename itk::Image<TPixel, VImageDimension> *image,
+    const TimeGeometry *timeGeometry,
+    TimeStepType timeStep,
+    unsigned int numberOfWorkUnits)
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
     typedef typename mitk::StatisticsImageFilter<ImageType> ImageStatisticsFilterType;
     typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
 
-    // reset statistics container if exists
-    ImageStatisticsContainer::Pointer statisticContainerForImage;
     LabelIndex labelNoMask = 1;
-    auto it = m_StatisticContainers.find(labelNoMask);
-    if (it != m_StatisticContainers.end())
-    {
-      statisticContainerForImage = it->second;
-    }
-    else
-    {
-      statisticContainerForImage = ImageStatisticsContainer::New();
-      statisticContainerForImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
-      m_StatisticContainers.emplace(labelNoMask, statisticContainerForImage);
-    }
 
     auto statObj = ImageStatisticsContainer::ImageStatisticsObject();
 
@@ -196,6 +318,10 @@ namespace mitk
     statisticsFilter->SetInput(image);
     statisticsFilter->SetCoordinateTolerance(0.001);
     statisticsFilter->SetDirectionTolerance(0.001);
+    if (numberOfWorkUnits > 0)
+    {
+      statisticsFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    }
 
     // TODO: this is single threaded. Implement our own image filter that does this multi threaded
     //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
@@ -205,6 +331,10 @@ namespace mitk
 
     typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
     minMaxFilter->SetInput(image);
+    if (numberOfWorkUnits > 0)
+    {
+      minMaxFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    }
     minMaxFilter->UpdateLargestPossibleRegion();
     typename ImageType::PixelType minval = minMaxFilter->GetMin();
     typename ImageType::PixelType maxval = minMaxFilter->GetMax();
@@ -277,7 +407,7 @@ namespace mitk
     statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), statisticsFilter->GetUniformity());
     statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), statisticsFilter->GetUPP());
     statObj.m_Histogram = statisticsFilter->GetHistogram();
-    statisticContainerForImage->SetStatisticsForTimeStep(timeStep, statObj);
+    this->SetStatisticsForTimeStep(labelNoMask, timeGeometry, timeStep, statObj);
   }
 
   template <typename TPixel, unsigned int VImageDimension>
@@ -295,7 +425,8 @@ namespace mitk
   template <typename TPixel, unsigned int VImageDimension>
   void ImageStatisticsCalculator::InternalCalculateStatisticsMasked(typename itk::Image<TPixel, VImageDimension> *image,
                                                                     const TimeGeometry *timeGeometry,
-                                                                    unsigned int timeStep)
+                                                                    const TimeStepInput &input,
+                                                                    unsigned int numberOfWorkUnits)
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
@@ -304,48 +435,28 @@ namespace mitk
     typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
     typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
 
-    // workaround: if m_SecondaryMaskGenerator ist not null but m_MaskGenerator is! (this is the case if we request a
-    // 'ignore zuero valued pixels' mask in the gui but do not define a primary mask)
-    bool swapMasks = false;
-    if (m_SecondaryMask.IsNotNull() && m_InternalMask.IsNull())
-    {
-      m_InternalMask = m_SecondaryMask;
-      m_SecondaryMask = nullptr;
-      swapMasks = true;
-    }
-
     // maskImage has to have the same dimension as image
     typename MaskType::ConstPointer maskImage = MaskType::New();
     try
     {
       // try to access the pixel values directly (no copying or casting). Only works if mask pixels are of pixelType
       // unsigned short
-      maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(m_InternalMask);
+      maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(input.mask);
     }
     catch (const itk::ExceptionObject &)
 
     {
       typename MaskType::Pointer noneConstMaskImage; //needed to work arround the fact that CastToItkImage currently does not support const itk images.
-      // if the pixel type of the mask is not short, then we have to make a copy of m_InternalMask (and cast the values)
-      CastToItkImage(m_InternalMask, noneConstMaskImage);
+      // if the pixel type of the mask is not short, then we have to make a copy of the mask (and cast the values)
+      CastToItkImage(input.mask, noneConstMaskImage);
       maskImage = noneConstMaskImage;
     }
 
     // if we have a secondary mask (say a ignoreZeroPixelMask) we need to combine the masks (corresponds to AND)
-    if (m_SecondaryMask.IsNotNull())
+    if (input.secondaryMask.IsNotNull())
     {
-      // dirty workaround for a bug when pf mask + any other mask is used in conjunction. We need a proper fix for this
-      // (Fabian Isensee is responsible and probably working on it!)
-      if (m_InternalMask->GetDimension() == 2 &&
-          (m_SecondaryMask->GetDimension() == 3 || m_SecondaryMask->GetDimension() == 4))
-      {
-        mitk::Image::ConstPointer old_img = m_SecondaryMaskGenerator->GetReferenceImage();
-        m_SecondaryMaskGenerator->SetInputImage(m_MaskGenerator->GetReferenceImage());
-        m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
-        m_SecondaryMaskGenerator->SetInputImage(old_img);
-      }
       typename MaskType::ConstPointer secondaryMaskImage = MaskType::New();
-      secondaryMaskImage = ImageToItkImage<MaskPixelType, VImageDimension>(m_SecondaryMask);
+      secondaryMaskImage = ImageToItkImage<MaskPixelType, VImageDimension>(input.secondaryMask);
 
       // secondary mask should be a ignore zero value pixel mask derived from image. it has to be cropped to the mask
       // region (which may be planar or simply smaller)
@@ -361,6 +472,10 @@ namespace mitk
       maskFilter->SetInput2(adaptedSecondaryMaskImage);
       maskFilter->SetMaskingValue(
         1); // all pixels of maskImage where secondaryMaskImage==1 will be kept, all the others are set to 0
+      if (numberOfWorkUnits > 0)
+      {
+        maskFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      }
       maskFilter->UpdateLargestPossibleRegion();
       maskImage = maskFilter->GetOutput();
     }
@@ -378,6 +493,10 @@ namespace mitk
     typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
     minMaxFilter->SetInput(adaptedImage);
     minMaxFilter->SetLabelInput(maskImage);
+    if (numberOfWorkUnits > 0)
+    {
+      minMaxFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    }
     minMaxFilter->UpdateLargestPossibleRegion();
 
     // set histogram parameters for each label individually (min/max may be different for each label)
@@ -415,6 +534,10 @@ namespace mitk
     imageStatisticsFilter->SetInput(adaptedImage);
     imageStatisticsFilter->SetLabelInput(maskImage);
     imageStatisticsFilter->SetHistogramParameters(nBins, minVals, maxVals);
+    if (numberOfWorkUnits > 0)
+    {
+      imageStatisticsFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    }
     imageStatisticsFilter->Update();
 
     auto labels = imageStatisticsFilter->GetValidLabelValues();
@@ -422,22 +545,6 @@ namespace mitk
 
     while (it != labels.end())
     {
-      ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
-      auto labelIt = m_StatisticContainers.find(*it);
-      // reset if statisticContainer already exist
-      if (labelIt != m_StatisticContainers.end())
-      {
-        statisticContainerForLabelImage = labelIt->second;
-      }
-      // create new statisticContainer
-      else
-      {
-        statisticContainerForLabelImage = ImageStatisticsContainer::New();
-        statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
-        // link label (*it) to statisticContainer
-        m_StatisticContainers.emplace(*it, statisticContainerForLabelImage);
-      }
-
       ImageStatisticsContainer::ImageStatisticsObject statObj;
 
       // find min, max, minindex and maxindex
@@ -448,8 +555,8 @@ namespace mitk
       mitk::Point3D worldCoordinateMax;
       mitk::Point3D indexCoordinateMin;
       mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
+      input.imageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
+      input.imageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
@@ -492,16 +599,9 @@ namespace mitk
       statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
       statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
       statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it);
-      statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
+      this->SetStatisticsForTimeStep(*it, timeGeometry, input.timeStep, statObj);
       ++it;
     }
-
-    // swap maskGenerators back
-    if (swapMasks)
-    {
-      m_SecondaryMask = m_InternalMask;
-      m_InternalMask = nullptr;
-    }
   }
 
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
 
+#include <mutex>
+
 namespace mitk
 {
     class MITKIMAGESTATISTICS_EXPORT ImageStatisticsCalculator: public itk::Object
@@ -70,6 +72,14 @@ namespace mitk
         That solely depends on which parameter has been set last.*/
         double GetBinSizeForHistogramStatistics() const;
 
+        /**Documentation
+        @brief If enabled, the time steps of the input image are processed concurrently. Masks are still generated
+        one time step after the other (mask generators are not thread safe), the statistics of all labels of a
+        time step are computed by the same filters as in the sequential mode. Default is off.*/
+        itkSetMacro(ParallelizeTimeSteps, bool);
+        itkGetConstMacro(ParallelizeTimeSteps, bool);
+        itkBooleanMacro(ParallelizeTimeSteps);
+
         /**Documentation
         @brief Returns the statistics for label @a label. If these requested statistics are not computed yet the computation is done as well.
         For performance reasons, statistics for all labels in the image are computed at once.
@@ -81,17 +91,42 @@ namespace mitk
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_ParallelizeTimeSteps = false;
         };
 
 
     private:
+        /** Everything the statistics of one time step are computed from.*/
+        struct TimeStepInput
+        {
+          TimeStepType timeStep = 0;
+          mitk::Image::Pointer imageTimeSlice;
+          mitk::Image::ConstPointer imageForStatistics;
+          mitk::Image::ConstPointer mask;
+          mitk::Image::ConstPointer secondaryMask;
+        };
+
+        /** Generates the masks and selects the image of the passed time step. Not thread safe (mask generators).*/
+        TimeStepInput PrepareTimeStep(TimeStepType timeStep);
+
+        /** Computes the statistics of one time step. Thread safe as long as the inputs of the time step are not shared.
+         numberOfWorkUnits is passed to the used ITK filters (0: default of the filters).*/
+        void CalculateStatisticsForTimeStep(const TimeStepInput& input, const TimeGeometry* timeGeometry, unsigned int numberOfWorkUnits);
+
+        void CalculateStatisticsForTimeStepsInParallel(const TimeGeometry* timeGeometry);
+
+        /** Stores the statistics of a label for a time step (creates the container of the label if needed).*/
+        void SetStatisticsForTimeStep(LabelIndex label, const TimeGeometry* timeGeometry, TimeStepType timeStep,
+          const ImageStatisticsContainer::ImageStatisticsObject& statistics);
+
         //Calculates statistics for each timestep for image
         template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsUnmasked(
-                typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry, TimeStepType timeStep);
+                typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry, TimeStepType timeStep,
+                unsigned int numberOfWorkUnits);
 
         template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsMasked(
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
-                unsigned int timeStep);
+                const TimeStepInput& input, unsigned int numberOfWorkUnits);
 
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
@@ -99,20 +134,18 @@ namespace mitk
         bool IsUpdateRequired(LabelIndex label) const;
 
         mitk::Image::ConstPointer m_Image;
-        mitk::Image::Pointer m_ImageTimeSlice;
-        mitk::Image::ConstPointer m_InternalImageForStatistics;
 
         mitk::MaskGenerator::Pointer m_MaskGenerator;
-        mitk::Image::ConstPointer m_InternalMask;
 
         mitk::MaskGenerator::Pointer m_SecondaryMaskGenerator;
-        mitk::Image::ConstPointer m_SecondaryMask;
 
         unsigned int m_nBinsForHistogramStatistics;
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
+        bool m_ParallelizeTimeSteps;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+        std::mutex m_StatisticContainersMutex;
     };
 
 }
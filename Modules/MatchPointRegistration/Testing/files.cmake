@@ -1,4 +1,5 @@
 SET(MODULE_TESTS
   mitkTimeFramesRegistrationHelperTest.cpp
   itkStitchImageFilterTest.cpp
+  mitkImageMappingHelperTest.cpp
 )
\ No newline at end of file
@@ -0,0 +1,353 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+#include "mitkImageGenerator.h"
+#include "mitkImageMappingHelper.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageTimeSelector.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkLabelSetImage.h"
+#include "mitkMAPAlgorithmHelper.h"
+
+#include <mapPreCachedRegistrationKernel.h>
+#include <mapRegistrationManipulator.h>
+#include <itkTranslationTransform.h>
+
+#include <map>
+
+class mitkImageMappingHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMappingHelperTestSuite);
+  MITK_TEST(MapTimesteps_Linear);
+  MITK_TEST(MapTimesteps_NearestNeighbor);
+  MITK_TEST(MapLabelSetImage_NearestNeighbor);
+  MITK_TEST(MapLabelSetImage_Linear);
+  MITK_TEST(MapTimesteps_Translation);
+  MITK_TEST(MapLabelSetImage_Translation_NearestNeighbor);
+  MITK_TEST(MapLabelSetImage_Translation_LinearWeightsPerLabel);
+  MITK_TEST(MapLabelSetImage_Fallback);
+  CPPUNIT_TEST_SUITE_END();
+private:
+  mitk::Image::Pointer m_DynamicImage;
+  mitk::BaseGeometry::Pointer m_ResultGeometry;
+  mitk::MAPRegistrationWrapper::Pointer m_Registration;
+
+  mitk::Image::Pointer SelectTimeStep(const mitk::Image* image, unsigned int timeStep)
+  {
+    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
+    timeSelector->SetInput(image);
+    timeSelector->SetTimeNr(timeStep);
+    timeSelector->UpdateLargestPossibleRegion();
+    return timeSelector->GetOutput();
+  }
+
+  /** Registration that maps every point of the result (target) space to the point shifted by offset in the input (moving) space.*/
+  mitk::MAPRegistrationWrapper::Pointer GenerateTranslationRegistration(const mitk::Vector3D& offset)
+  {
+    typedef ::map::core::Registration<3, 3> RegistrationType;
+    typedef itk::TranslationTransform<double, 3> TransformType;
+
+    auto inverseTransform = TransformType::New();
+    TransformType::OutputVectorType inverseOffset;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      inverseOffset[d] = offset[d];
+    }
+    inverseTransform->SetOffset(inverseOffset);
+
+    auto directTransform = TransformType::New();
+    directTransform->SetOffset(-inverseOffset);
+
+    auto inverseKernel = ::map::core::PreCachedRegistrationKernel<3, 3>::New();
+    inverseKernel->setTransformModel(inverseTransform);
+    auto directKernel = ::map::core::PreCachedRegistrationKernel<3, 3>::New();
+    directKernel->setTransformModel(directTransform);
+
+    auto registration = RegistrationType::New();
+    ::map::core::RegistrationManipulator<RegistrationType> manipulator(registration);
+    manipulator.setInverseMapping(inverseKernel);
+    manipulator.setDirectMapping(directKernel);
+
+    return mitk::MAPRegistrationWrapper::New(registration);
+  }
+
+  /** Label set image with two layers filled with blocks of two labels each.*/
+  mitk::LabelSetImage::Pointer GenerateLabelSetImage(mitk::Image* templateImage)
+  {
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->Initialize(templateImage);
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(1, "first"));
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(2, "second"));
+    this->FillActiveLayer(labelSetImage, 1, 2);
+
+    labelSetImage->AddLayer();
+    labelSetImage->GetLabelSet(1)->AddLabel(mitk::Label::New(3, "third"));
+    labelSetImage->GetLabelSet(1)->AddLabel(mitk::Label::New(4, "fourth"));
+    this->FillActiveLayer(labelSetImage, 4, 3);
+
+    return labelSetImage;
+  }
+
+  /** Maps the dynamic image at once and compares every time step with the mapping of the single time step.*/
+  void CheckMapTimesteps(mitk::ImageMappingInterpolator::Type interpolatorType)
+  {
+    this->CheckMapTimesteps(interpolatorType, m_Registration);
+  }
+
+  void CheckMapTimesteps(mitk::ImageMappingInterpolator::Type interpolatorType, const mitk::MAPRegistrationWrapper* registration)
+  {
+    mitk::Image::Pointer result = mitk::ImageMappingHelper::map(m_DynamicImage, registration, false, -1.,
+      m_ResultGeometry, true, 0., interpolatorType);
+
+    CPPUNIT_ASSERT(result.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(m_DynamicImage->GetTimeSteps(), result->GetTimeSteps());
+
+    for (unsigned int i = 0; i < m_DynamicImage->GetTimeSteps(); ++i)
+    {
+      mitk::Image::Pointer frameResult = mitk::ImageMappingHelper::map(this->SelectTimeStep(m_DynamicImage, i),
+        registration, false, -1., m_ResultGeometry, true, 0., interpolatorType);
+
+      CPPUNIT_ASSERT_MESSAGE("Check mapped time step", mitk::Equal(*frameResult, *(this->SelectTimeStep(result, i)), 1e-4, true));
+    }
+  }
+
+  /** Content of a layer. The content of the active layer is stored in the image itself.*/
+  std::vector<mitk::LabelSetImage::PixelType> GetLayerContent(mitk::LabelSetImage* image, unsigned int layer)
+  {
+    const mitk::Image* layerImage = layer == image->GetActiveLayer() ? image : image->GetLayerImage(layer);
+    mitk::ImageReadAccessor access(layerImage);
+    auto data = static_cast<const mitk::LabelSetImage::PixelType*>(access.GetData());
+    return std::vector<mitk::LabelSetImage::PixelType>(data, data + access.GetSize() / sizeof(mitk::LabelSetImage::PixelType));
+  }
+
+  /** Fills the active layer with blocks of two labels.*/
+  void FillActiveLayer(mitk::LabelSetImage* image, mitk::LabelSetImage::PixelType firstLabel, mitk::LabelSetImage::PixelType secondLabel)
+  {
+    mitk::ImageWriteAccessor access(image);
+    auto data = static_cast<mitk::LabelSetImage::PixelType*>(access.GetData());
+    const unsigned int dimX = image->GetDimension(0);
+    const unsigned int dimY = image->GetDimension(1);
+
+    for (unsigned int z = 0; z < image->GetDimension(2); ++z)
+      for (unsigned int y = 0; y < dimY; ++y)
+        for (unsigned int x = 0; x < dimX; ++x)
+          data[(z * dimY + y) * dimX + x] = x < 3 ? 0 : (y < 4 ? firstLabel : secondLabel);
+  }
+
+  void CheckMapLabelSetImage(mitk::ImageMappingInterpolator::Type interpolatorType)
+  {
+    auto templateImage = mitk::ImageGenerator::GenerateRandomImage<float>(8, 9, 7, 1, 1., 1., 1., 1., 0.);
+    auto labelSetImage = this->GenerateLabelSetImage(templateImage);
+
+    const auto layer0 = this->GetLayerContent(labelSetImage, 0);
+    const auto layer1 = this->GetLayerContent(labelSetImage, 1);
+
+    auto result = mitk::ImageMappingHelper::map(labelSetImage, m_Registration, false, 0., templateImage->GetGeometry(), true, 0., interpolatorType);
+    auto resultLabelSetImage = dynamic_cast<mitk::LabelSetImage*>(result.GetPointer());
+
+    CPPUNIT_ASSERT(nullptr != resultLabelSetImage);
+    CPPUNIT_ASSERT_EQUAL(2u, resultLabelSetImage->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(1u, resultLabelSetImage->GetActiveLayer());
+    CPPUNIT_ASSERT(resultLabelSetImage->GetLabelSet(0)->ExistLabel(2));
+    CPPUNIT_ASSERT(resultLabelSetImage->GetLabelSet(1)->ExistLabel(4));
+
+    // identity registration on the same grid has to reproduce the layers, without changing the input
+    CPPUNIT_ASSERT(layer0 == this->GetLayerContent(resultLabelSetImage, 0));
+    CPPUNIT_ASSERT(layer1 == this->GetLayerContent(resultLabelSetImage, 1));
+    CPPUNIT_ASSERT_EQUAL(1u, labelSetImage->GetActiveLayer());
+    CPPUNIT_ASSERT(layer0 == this->GetLayerContent(labelSetImage, 0));
+    CPPUNIT_ASSERT(layer1 == this->GetLayerContent(labelSetImage, 1));
+  }
+
+public:
+  void setUp() override
+  {
+    m_DynamicImage = mitk::ImageGenerator::GenerateRandomImage<float>(10, 12, 8, 4, 1., 1., 1., 100., 0.);
+
+    // shift the result grid by fractions of a voxel, so it has to be interpolated and padded
+    m_ResultGeometry = m_DynamicImage->GetGeometry(0)->Clone();
+    mitk::Point3D origin = m_ResultGeometry->GetOrigin();
+    origin[0] += 0.3;
+    origin[1] -= 0.6;
+    origin[2] += 1.25;
+    m_ResultGeometry->SetOrigin(origin);
+
+    m_Registration = mitk::GenerateIdentityRegistration3D();
+  }
+
+  void tearDown() override
+  {
+    m_DynamicImage = nullptr;
+    m_ResultGeometry = nullptr;
+    m_Registration = nullptr;
+  }
+
+  void MapTimesteps_Linear()
+  {
+    this->CheckMapTimesteps(mitk::ImageMappingInterpolator::Linear);
+  }
+
+  void MapTimesteps_NearestNeighbor()
+  {
+    this->CheckMapTimesteps(mitk::ImageMappingInterpolator::NearestNeighbor);
+  }
+
+  void MapLabelSetImage_NearestNeighbor()
+  {
+    this->CheckMapLabelSetImage(mitk::ImageMappingInterpolator::NearestNeighbor);
+  }
+
+  void MapLabelSetImage_Linear()
+  {
+    this->CheckMapLabelSetImage(mitk::ImageMappingInterpolator::Linear);
+  }
+
+  void MapTimesteps_Translation()
+  {
+    mitk::Vector3D offset;
+    offset[0] = 1.7;
+    offset[1] = -0.4;
+    offset[2] = 0.25;
+    auto registration = this->GenerateTranslationRegistration(offset);
+
+    this->CheckMapTimesteps(mitk::ImageMappingInterpolator::Linear, registration);
+    this->CheckMapTimesteps(mitk::ImageMappingInterpolator::NearestNeighbor, registration);
+  }
+
+  void MapLabelSetImage_Translation_NearestNeighbor()
+  {
+    auto templateImage = mitk::ImageGenerator::GenerateRandomImage<float>(8, 9, 7, 1, 1., 1., 1., 1., 0.);
+    auto labelSetImage = this->GenerateLabelSetImage(templateImage);
+    const auto layer0 = this->GetLayerContent(labelSetImage, 0);
+
+    // shifts by whole voxels, voxels without input are padded
+    mitk::Vector3D offset;
+    offset[0] = 2.;
+    offset[1] = -1.;
+    offset[2] = 0.;
+    auto result = mitk::ImageMappingHelper::map(labelSetImage, this->GenerateTranslationRegistration(offset), false, 9.,
+      templateImage->GetGeometry(), true, 0., mitk::ImageMappingInterpolator::NearestNeighbor);
+    auto resultLabelSetImage = dynamic_cast<mitk::LabelSetImage*>(result.GetPointer());
+    CPPUNIT_ASSERT(nullptr != resultLabelSetImage);
+
+    const auto resultLayer0 = this->GetLayerContent(resultLabelSetImage, 0);
+    const int dimX = 8, dimY = 9, dimZ = 7;
+    for (int z = 0; z < dimZ; ++z)
+      for (int y = 0; y < dimY; ++y)
+        for (int x = 0; x < dimX; ++x)
+        {
+          const int inputX = x + 2;
+          const int inputY = y - 1;
+          const bool isInside = inputX < dimX && inputY >= 0;
+          const auto expected = isInside ? layer0[(z * dimY + inputY) * dimX + inputX] : mitk::LabelSetImage::PixelType(9);
+          CPPUNIT_ASSERT_EQUAL(expected, resultLayer0[(z * dimY + y) * dimX + x]);
+        }
+  }
+
+  void MapLabelSetImage_Translation_LinearWeightsPerLabel()
+  {
+    typedef mitk::LabelSetImage::PixelType PixelType;
+    const int dimX = 8, dimY = 9, dimZ = 3;
+
+    auto templateImage = mitk::ImageGenerator::GenerateRandomImage<float>(dimX, dimY, dimZ, 1, 1., 1., 1., 1., 0.);
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->Initialize(templateImage);
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(1, "first"));
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(2, "second"));
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(3, "third"));
+
+    // checkerboard like pattern: the nearest voxel of a position shifted by (0.4, 0.4) has label 1, but the
+    // two neighbors with label 2 have the higher summed weight (0.24 + 0.24 > 0.36)
+    auto labelAt = [](int x, int y) { return static_cast<PixelType>(1 + (x % 2) + (y % 2)); };
+    {
+      mitk::ImageWriteAccessor access(labelSetImage);
+      auto data = static_cast<PixelType*>(access.GetData());
+      for (int z = 0; z < dimZ; ++z)
+        for (int y = 0; y < dimY; ++y)
+          for (int x = 0; x < dimX; ++x)
+            data[(z * dimY + y) * dimX + x] = labelAt(x, y);
+    }
+
+    mitk::Vector3D offset;
+    offset[0] = 0.4;
+    offset[1] = 0.4;
+    offset[2] = 0.;
+    auto registration = this->GenerateTranslationRegistration(offset);
+
+    auto linearResult = mitk::ImageMappingHelper::map(labelSetImage, registration, false, 0., templateImage->GetGeometry(),
+      true, 0., mitk::ImageMappingInterpolator::Linear);
+    auto nearestResult = mitk::ImageMappingHelper::map(labelSetImage, registration, false, 0., templateImage->GetGeometry(),
+      true, 0., mitk::ImageMappingInterpolator::NearestNeighbor);
+
+    const auto linearLayer = this->GetLayerContent(dynamic_cast<mitk::LabelSetImage*>(linearResult.GetPointer()), 0);
+    const auto nearestLayer = this->GetLayerContent(dynamic_cast<mitk::LabelSetImage*>(nearestResult.GetPointer()), 0);
+
+    const double cornerWeights[4] = { 0.6 * 0.6, 0.4 * 0.6, 0.6 * 0.4, 0.4 * 0.4 };
+    for (int z = 0; z < dimZ; ++z)
+      for (int y = 0; y < dimY - 1; ++y)
+        for (int x = 0; x < dimX - 1; ++x)
+        {
+          std::map<PixelType, double> labelWeights;
+          labelWeights[labelAt(x, y)] += cornerWeights[0];
+          labelWeights[labelAt(x + 1, y)] += cornerWeights[1];
+          labelWeights[labelAt(x, y + 1)] += cornerWeights[2];
+          labelWeights[labelAt(x + 1, y + 1)] += cornerWeights[3];
+
+          auto expected = labelWeights.begin();
+          for (auto iter = labelWeights.begin(); iter != labelWeights.end(); ++iter)
+          {
+            if (iter->second > expected->second)
+              expected = iter;
+          }
+
+          const auto pos = (z * dimY + y) * dimX + x;
+          CPPUNIT_ASSERT_EQUAL(expected->first, linearLayer[pos]);
+          CPPUNIT_ASSERT_EQUAL(labelAt(x, y), nearestLayer[pos]);
+        }
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), linearLayer[0]);
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), nearestLayer[0]);
+  }
+
+  void MapLabelSetImage_Fallback()
+  {
+    // time steps with different geometries cannot share one sampling field, so every layer and time step
+    // is mapped on its own
+    auto templateImage = mitk::ImageGenerator::GenerateRandomImage<float>(8, 9, 7, 2, 1., 1., 1., 1., 0.);
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->Initialize(templateImage);
+
+    auto secondGeometry = labelSetImage->GetTimeGeometry()->GetGeometryForTimeStep(1);
+    mitk::Point3D origin = secondGeometry->GetOrigin();
+    origin[0] += 1e-6;
+    secondGeometry->SetOrigin(origin);
+
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(1, "first"));
+    labelSetImage->GetLabelSet(0)->AddLabel(mitk::Label::New(2, "second"));
+    this->FillActiveLayer(labelSetImage, 1, 2);
+
+    const auto layer0 = this->GetLayerContent(labelSetImage, 0);
+
+    auto result = mitk::ImageMappingHelper::map(labelSetImage, m_Registration, false, 0., templateImage->GetGeometry(),
+      true, 0., mitk::ImageMappingInterpolator::NearestNeighbor);
+    auto resultLabelSetImage = dynamic_cast<mitk::LabelSetImage*>(result.GetPointer());
+
+    CPPUNIT_ASSERT(nullptr != resultLabelSetImage);
+    CPPUNIT_ASSERT_EQUAL(2u, resultLabelSetImage->GetTimeSteps());
+    CPPUNIT_ASSERT(layer0 == this->GetLayerContent(resultLabelSetImage, 0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMappingHelper)
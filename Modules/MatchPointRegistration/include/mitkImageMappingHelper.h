@@ -61,6 +61,13 @@ namespace mitk
      * @pre Dimensionality of the registration must match with the input imageinput must be valid
      * @remark Depending in the settings of throwOnOutOfInputAreaError and throwOnMappingError it may also throw
      * due to inconsistencies in the mapping process. See parameter description.
+     * @remark If a 3D+t image (with the same geometry for all time steps) is mapped with a 3D registration, the
+     * registration is evaluated only once for the grid of the result image and all time steps are interpolated
+     * in parallel with these sampling positions.
+     * @remark LabelSetImages are mapped layer by layer without changing the state of the input. Labels are never blended:
+     * NearestNeighbor uses the label of the closest voxel; all other interpolator types use the label with the highest
+     * summed linear weight of the neighboring voxels (if the image can be mapped with one sampling field, see above,
+     * otherwise the layers are linearly interpolated).
      * @result Pointer to the resulting mapped image.h*/
     MITKMATCHPOINTREGISTRATION_EXPORT ResultImageType::Pointer map(const InputImageType* input, const RegistrationType* registration,
       bool throwOnOutOfInputAreaError = false, const double& paddingValue = 0,
@@ -21,8 +21,19 @@ found in the LICENSE file.
 #include <mitkGeometry3D.h>
 #include <mitkImageToItk.h>
 #include <mitkImageTimeSelector.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 
+#include <itkMath.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "mapRegistration.h"
 
 #include "mitkImageMappingHelper.h"
@@ -238,6 +249,331 @@ void doMapTimesteps(const mitk::ImageMappingHelper::InputImageType* input, mitk:
   }
 }
 
+typedef ::map::core::Registration<3, 3> SamplingFieldRegistrationType;
+
+/**Positions (continuous indices in the input image) that are sampled for the voxels of the result image.
+ * They only depend on the registration and the geometries. So they are evaluated once and then reused
+ * for all time steps of an image.*/
+struct ImageSamplingField
+{
+  std::vector<itk::ContinuousIndex<double, 3> > Positions;
+  /**0 if the registration cannot map the respective voxel.*/
+  std::vector<unsigned char> IsMapped;
+};
+
+/**Checks if all time steps of the image can be mapped with one sampling field (3D or 3D+t image with identical
+ * geometries for all time steps and a 3D registration).*/
+bool canMapTimestepsWithSamplingField(const mitk::ImageMappingHelper::InputImageType* input, const mitk::ImageMappingHelper::RegistrationType* registration, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry)
+{
+  if (nullptr == resultGeometry || input->GetDimension() < 3 || input->GetDimension() > 4 || nullptr == dynamic_cast<const SamplingFieldRegistrationType*>(registration))
+  {
+    return false;
+  }
+
+  const mitk::BaseGeometry* firstGeometry = input->GetGeometry(0);
+  for (unsigned int i = 1; i < input->GetTimeSteps(); ++i)
+  {
+    if (!mitk::Equal(*firstGeometry, *(input->GetGeometry(i)), mitk::eps, false))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**Evaluates the registration for every voxel of the result image (given by resultGeometry and resultSize).*/
+ImageSamplingField generateSamplingField(const SamplingFieldRegistrationType* registration, const mitk::BaseGeometry* inputGeometry, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry, const unsigned int* resultSize, bool throwOnMappingError)
+{
+  const std::size_t sliceSize = static_cast<std::size_t>(resultSize[0]) * resultSize[1];
+
+  ImageSamplingField field;
+  field.Positions.resize(sliceSize * resultSize[2]);
+  field.IsMapped.resize(sliceSize * resultSize[2], 0);
+
+  auto mapSlice = [&](itk::SizeValueType z)
+  {
+    mitk::Point3D resultIndex;
+    mitk::Point3D worldPoint;
+    mitk::Point3D inputIndex;
+    SamplingFieldRegistrationType::TargetPointType targetPoint;
+    SamplingFieldRegistrationType::MovingPointType movingPoint;
+
+    resultIndex[2] = z;
+    std::size_t pos = z * sliceSize;
+
+    for (unsigned int y = 0; y < resultSize[1]; ++y)
+    {
+      resultIndex[1] = y;
+      for (unsigned int x = 0; x < resultSize[0]; ++x, ++pos)
+      {
+        resultIndex[0] = x;
+        resultGeometry->IndexToWorld(resultIndex, worldPoint);
+        targetPoint.CastFrom(worldPoint);
+
+        if (registration->mapPointInverse(targetPoint, movingPoint))
+        {
+          worldPoint.CastFrom(movingPoint);
+          inputGeometry->WorldToIndex(worldPoint, inputIndex);
+          field.Positions[pos].CastFrom(inputIndex);
+          field.IsMapped[pos] = 1;
+        }
+      }
+    }
+  };
+
+  if (resultSize[2] > 0)
+  {
+    //The first slice is mapped alone, so kernels that are generated lazily are initialized before the threads start.
+    mapSlice(0);
+    itk::MultiThreaderBase::New()->ParallelizeArray(1, resultSize[2], mapSlice, nullptr);
+  }
+
+  if (throwOnMappingError && std::find(field.IsMapped.begin(), field.IsMapped.end(), 0) != field.IsMapped.end())
+  {
+    mitkThrow() << "Cannot map image. Registration does not support the whole requested region of the result image.";
+  }
+
+  return field;
+}
+
+/**Returns for every position of the sampling field if it is mapped and lies inside the buffer of frame.*/
+template <typename TFrameImage>
+std::vector<unsigned char> checkSamplingFieldInsideInput(const TFrameImage* frame, const ImageSamplingField& field, bool throwOnOutOfInputAreaError)
+{
+  std::vector<unsigned char> isInside(field.Positions.size(), 0);
+
+  auto insideChecker = ::itk::NearestNeighborInterpolateImageFunction<TFrameImage>::New();
+  insideChecker->SetInputImage(frame);
+
+  for (std::size_t pos = 0; pos < field.Positions.size(); ++pos)
+  {
+    isInside[pos] = field.IsMapped[pos] && insideChecker->IsInsideBuffer(field.Positions[pos]);
+
+    if (throwOnOutOfInputAreaError && field.IsMapped[pos] && !isInside[pos])
+    {
+      mitkThrow() << "Cannot map image. Input image does not cover the whole requested region of the result image.";
+    }
+  }
+
+  return isInside;
+}
+
+/**Applies the sampling field to all time steps of the input image in parallel and writes the results directly
+ * into the buffer of result. Values are interpolated and casted like itk::ResampleImageFilter does it.*/
+template <typename TPixelType, unsigned int VImageDimension >
+void doMapTimestepsWithSamplingField(const ::itk::Image<TPixelType, VImageDimension>* input, mitk::Image* result, const ImageSamplingField& field,
+  bool throwOnOutOfInputAreaError, double paddingValue, double errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+{
+  typedef ::itk::Image<TPixelType, VImageDimension - 1> FrameImageType;
+  typedef ::itk::InterpolateImageFunction< FrameImageType > BaseInterpolatorType;
+
+  const auto inputRegion = input->GetLargestPossibleRegion();
+
+  typename FrameImageType::RegionType frameRegion;
+  typename FrameImageType::PointType frameOrigin;
+  typename FrameImageType::SpacingType frameSpacing;
+  typename FrameImageType::DirectionType frameDirection;
+  for (unsigned int i = 0; i < VImageDimension - 1; ++i)
+  {
+    frameRegion.SetIndex(i, inputRegion.GetIndex(i));
+    frameRegion.SetSize(i, inputRegion.GetSize(i));
+    frameOrigin[i] = input->GetOrigin()[i];
+    frameSpacing[i] = input->GetSpacing()[i];
+    for (unsigned int j = 0; j < VImageDimension - 1; ++j)
+    {
+      frameDirection[i][j] = input->GetDirection()[i][j];
+    }
+  }
+
+  const itk::SizeValueType frameSize = frameRegion.GetNumberOfPixels();
+  const itk::SizeValueType timeSteps = inputRegion.GetSize(VImageDimension - 1);
+
+  //The frames are only views on the buffer of the input image
+  auto generateFrame = [&](itk::SizeValueType timeStep)
+  {
+    typename FrameImageType::Pointer frame = FrameImageType::New();
+    frame->SetRegions(frameRegion);
+    frame->SetOrigin(frameOrigin);
+    frame->SetSpacing(frameSpacing);
+    frame->SetDirection(frameDirection);
+    frame->GetPixelContainer()->SetImportPointer(const_cast<TPixelType*>(input->GetBufferPointer()) + timeStep * frameSize, frameSize, false);
+    return frame;
+  };
+
+  //Whether a position is inside of the input does not depend on the frame. Check it once.
+  const std::size_t resultFrameSize = field.Positions.size();
+  const auto isInside = checkSamplingFieldInsideInput(generateFrame(0).GetPointer(), field, throwOnOutOfInputAreaError);
+
+  mitk::ImageWriteAccessor resultAccess(result);
+  auto* resultBuffer = static_cast<TPixelType*>(resultAccess.GetData());
+
+  typedef typename BaseInterpolatorType::OutputType InterpolatorOutputType;
+  const InterpolatorOutputType minOutputValue = static_cast<InterpolatorOutputType>(::itk::NumericTraits<TPixelType>::NonpositiveMin());
+  const InterpolatorOutputType maxOutputValue = static_cast<InterpolatorOutputType>(::itk::NumericTraits<TPixelType>::max());
+  const auto resultPaddingValue = static_cast<TPixelType>(paddingValue);
+  const auto resultErrorValue = static_cast<TPixelType>(errorValue);
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, timeSteps, [&](itk::SizeValueType timeStep)
+  {
+    typename BaseInterpolatorType::Pointer interpolator = generateInterpolator<FrameImageType>(interpolatorType);
+    interpolator->SetInputImage(generateFrame(timeStep));
+
+    TPixelType* resultFrame = resultBuffer + timeStep * resultFrameSize;
+
+    for (std::size_t pos = 0; pos < resultFrameSize; ++pos)
+    {
+      if (!field.IsMapped[pos])
+      {
+        resultFrame[pos] = resultErrorValue;
+      }
+      else if (!isInside[pos])
+      {
+        resultFrame[pos] = resultPaddingValue;
+      }
+      else
+      {
+        const InterpolatorOutputType value = interpolator->EvaluateAtContinuousIndex(field.Positions[pos]);
+        resultFrame[pos] = static_cast<TPixelType>(std::min(std::max(value, minOutputValue), maxOutputValue));
+      }
+    }
+  }, nullptr);
+}
+
+typedef mitk::LabelSetImage::PixelType LabelPixelType;
+typedef ::itk::Image<LabelPixelType, 3> LabelFrameImageType;
+
+/**Frame (3D volume of one layer at one time step) of a label set image that should be mapped.*/
+struct LabelFrameMappingJob
+{
+  const LabelPixelType* Input;
+  LabelPixelType* Result;
+};
+
+/**Returns the label at the continuous index position. Labels are never blended: With nearest neighbor
+ * interpolation the label of the closest voxel is used. Otherwise the linear interpolation weights of the
+ * 8 neighboring voxels are summed up per label and the label with the highest weight is used (which equals
+ * a linear interpolation of every label mask on its own).*/
+LabelPixelType interpolateLabel(const LabelPixelType* frame, const LabelFrameImageType::SizeType& size, const itk::ContinuousIndex<double, 3>& position, bool useNearestNeighbor)
+{
+  const itk::OffsetValueType strides[3] = { 1, static_cast<itk::OffsetValueType>(size[0]), static_cast<itk::OffsetValueType>(size[0] * size[1]) };
+
+  if (useNearestNeighbor)
+  {
+    itk::OffsetValueType offset = 0;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const auto index = std::min(std::max(itk::Math::RoundHalfIntegerUp<itk::OffsetValueType>(position[d]), itk::OffsetValueType(0)), static_cast<itk::OffsetValueType>(size[d]) - 1);
+      offset += index * strides[d];
+    }
+    return frame[offset];
+  }
+
+  itk::OffsetValueType lower[3];
+  itk::OffsetValueType upper[3];
+  double upperWeight[3];
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    const double floorPosition = std::floor(position[d]);
+    const auto maxIndex = static_cast<itk::OffsetValueType>(size[d]) - 1;
+    upperWeight[d] = position[d] - floorPosition;
+    lower[d] = std::min(std::max(static_cast<itk::OffsetValueType>(floorPosition), itk::OffsetValueType(0)), maxIndex);
+    upper[d] = std::min(std::max(static_cast<itk::OffsetValueType>(floorPosition) + 1, itk::OffsetValueType(0)), maxIndex);
+  }
+
+  LabelPixelType labels[8];
+  double weights[8];
+  unsigned int labelCount = 0;
+
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    double weight = 1.;
+    itk::OffsetValueType offset = 0;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const bool isUpper = (corner >> d) & 1;
+      weight *= isUpper ? upperWeight[d] : 1. - upperWeight[d];
+      offset += (isUpper ? upper[d] : lower[d]) * strides[d];
+    }
+
+    if (weight <= 0.)
+    {
+      continue;
+    }
+
+    const LabelPixelType label = frame[offset];
+    unsigned int i = 0;
+    while (i < labelCount && labels[i] != label)
+    {
+      ++i;
+    }
+
+    if (i == labelCount)
+    {
+      labels[labelCount] = label;
+      weights[labelCount++] = weight;
+    }
+    else
+    {
+      weights[i] += weight;
+    }
+  }
+
+  return labels[std::max_element(weights, weights + labelCount) - weights];
+}
+
+/**Maps all given label frames with the sampling field. The slices of all frames (of all layers and time steps) are
+ * processed in parallel, so even a single frame is distributed over all threads.*/
+void mapLabelFramesWithSamplingField(const std::vector<LabelFrameMappingJob>& jobs, const unsigned int* inputFrameSize, const unsigned int numberOfResultSlices,
+  const ImageSamplingField& field, bool throwOnOutOfInputAreaError, double paddingValue, double errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+{
+  LabelFrameImageType::SizeType inputSize;
+  LabelFrameImageType::RegionType inputRegion;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    inputSize[d] = inputFrameSize[d];
+  }
+  inputRegion.SetSize(inputSize);
+
+  auto insideReference = LabelFrameImageType::New();
+  insideReference->SetRegions(inputRegion);
+  const auto isInside = checkSamplingFieldInsideInput(insideReference.GetPointer(), field, throwOnOutOfInputAreaError);
+
+  const bool useNearestNeighbor = interpolatorType == mitk::ImageMappingInterpolator::NearestNeighbor;
+  const auto resultPaddingValue = static_cast<LabelPixelType>(paddingValue);
+  const auto resultErrorValue = static_cast<LabelPixelType>(errorValue);
+
+  if (0 == numberOfResultSlices)
+  {
+    return;
+  }
+
+  const std::size_t resultSliceSize = field.Positions.size() / numberOfResultSlices;
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, jobs.size() * numberOfResultSlices, [&](itk::SizeValueType workID)
+  {
+    const auto& job = jobs[workID / numberOfResultSlices];
+    const std::size_t sliceBegin = (workID % numberOfResultSlices) * resultSliceSize;
+    const std::size_t sliceEnd = sliceBegin + resultSliceSize;
+
+    for (std::size_t pos = sliceBegin; pos < sliceEnd; ++pos)
+    {
+      if (!field.IsMapped[pos])
+      {
+        job.Result[pos] = resultErrorValue;
+      }
+      else if (!isInside[pos])
+      {
+        job.Result[pos] = resultPaddingValue;
+      }
+      else
+      {
+        job.Result[pos] = interpolateLabel(job.Input, inputSize, field.Positions[pos], useNearestNeighbor);
+      }
+    }
+  }, nullptr);
+}
+
 mitk::TimeGeometry::Pointer CreateResultTimeGeometry(const mitk::ImageMappingHelper::InputImageType* input, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry)
 {
   mitk::TimeGeometry::ConstPointer timeGeometry = input->GetTimeGeometry();
@@ -282,7 +618,16 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
       result = mitk::Image::New();
       result->Initialize(input->GetPixelType(), *mappedTimeGeometry, 1, input->GetTimeSteps());
 
-      doMapTimesteps(input, result, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+      if (canMapTimestepsWithSamplingField(input, registration, resultGeometry))
+      { //evaluate the registration only once and apply it to all time steps
+        const unsigned int resultSize[3] = { result->GetDimension(0), result->GetDimension(1), result->GetDimension(2) };
+        const auto field = generateSamplingField(dynamic_cast<const SamplingFieldRegistrationType*>(registration), input->GetGeometry(0), resultGeometry, resultSize, throwOnMappingError);
+        AccessFixedDimensionByItk_n(input, doMapTimestepsWithSamplingField, 4, (result, field, throwOnOutOfInputAreaError, paddingValue, errorValue, interpolatorType));
+      }
+      else
+      {
+        doMapTimesteps(input, result, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+      }
     }
   }
   else
@@ -296,26 +641,73 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
 
     resultLabelSetImage->Initialize(resultTemplate);
 
-    auto cloneInput = inputLabelSetImage->Clone();
-    //We need to clone the LabelSetImage due to its illposed design. It is state full
-    //and we have to iterate through all layers as active layers to ensure the content
-    //was really stored (directly working with the layer images does not work with the
-    //active layer). The clone wastes rescources but is the easiest and safest way to
-    //ensure 1) correct mapping 2) avoid race conditions with other parts of the
-    //application because we would change the state of the input.
-    //This whole code block should be reworked as soon as T28525 is done.
+    //The content of the active layer is only up to date in the image itself, the content of all other layers
+    //in their layer images. So every layer is read from its own buffer, without changing the state of the input.
+    const unsigned int activeLayer = inputLabelSetImage->GetActiveLayer();
+    const unsigned int numberOfLayers = inputLabelSetImage->GetNumberOfLayers();
 
-    for (unsigned int layerID = 0; layerID < inputLabelSetImage->GetNumberOfLayers(); ++layerID)
+    std::vector<const mitk::Image*> layerInputs;
+    std::vector<mitk::Image::Pointer> layerResults;
+    for (unsigned int layerID = 0; layerID < numberOfLayers; ++layerID)
     {
-      if (resultLabelSetImage->GetNumberOfLayers() <= layerID)
+      layerInputs.push_back(layerID == activeLayer ? input : inputLabelSetImage->GetLayerImage(layerID));
+
+      auto layerResult = mitk::Image::New();
+      layerResult->Initialize(resultLabelSetImage->GetPixelType(), *mappedTimeGeometry, 1, input->GetTimeSteps());
+      layerResults.push_back(layerResult);
+    }
+
+    if (canMapTimestepsWithSamplingField(input, registration, resultGeometry))
+    { //evaluate the registration only once and map all layers and time steps with it
+      const unsigned int resultSize[3] = { resultLabelSetImage->GetDimension(0), resultLabelSetImage->GetDimension(1), resultLabelSetImage->GetDimension(2) };
+      const auto field = generateSamplingField(dynamic_cast<const SamplingFieldRegistrationType*>(registration), input->GetGeometry(0), resultGeometry, resultSize, throwOnMappingError);
+
+      std::vector<std::unique_ptr<mitk::ImageReadAccessor> > readAccessors;
+      std::vector<std::unique_ptr<mitk::ImageWriteAccessor> > writeAccessors;
+      std::vector<LabelFrameMappingJob> jobs;
+
+      const unsigned int inputFrameSize[3] = { input->GetDimension(0), input->GetDimension(1), input->GetDimension(2) };
+      const std::size_t inputFramePixels = static_cast<std::size_t>(inputFrameSize[0]) * inputFrameSize[1] * inputFrameSize[2];
+      for (unsigned int layerID = 0; layerID < numberOfLayers; ++layerID)
       {
-        resultLabelSetImage->AddLayer();
+        readAccessors.emplace_back(new mitk::ImageReadAccessor(layerInputs[layerID]));
+        writeAccessors.emplace_back(new mitk::ImageWriteAccessor(layerResults[layerID]));
+
+        for (unsigned int timeStep = 0; timeStep < input->GetTimeSteps(); ++timeStep)
+        {
+          LabelFrameMappingJob job;
+          job.Input = static_cast<const LabelPixelType*>(readAccessors.back()->GetData()) + timeStep * inputFramePixels;
+          job.Result = static_cast<LabelPixelType*>(writeAccessors.back()->GetData()) + timeStep * field.Positions.size();
+          jobs.push_back(job);
+        }
       }
-      resultLabelSetImage->AddLabelSetToLayer(layerID, inputLabelSetImage->GetLabelSet(layerID)->Clone());
-      cloneInput->SetActiveLayer(layerID);
-      resultLabelSetImage->SetActiveLayer(layerID);
 
-      doMapTimesteps(cloneInput, resultLabelSetImage, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, mitk::ImageMappingInterpolator::Linear);
+      mapLabelFramesWithSamplingField(jobs, inputFrameSize, resultSize[2], field, throwOnOutOfInputAreaError, paddingValue, errorValue, interpolatorType);
+    }
+    else
+    {
+      const auto layerInterpolatorType = interpolatorType == mitk::ImageMappingInterpolator::NearestNeighbor ? mitk::ImageMappingInterpolator::NearestNeighbor : mitk::ImageMappingInterpolator::Linear;
+      for (unsigned int layerID = 0; layerID < numberOfLayers; ++layerID)
+      {
+        doMapTimesteps(layerInputs[layerID], layerResults[layerID], registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, layerInterpolatorType);
+      }
+    }
+
+    //Initialize() created layer 0 as active layer, so its content goes into the image itself. Adding the
+    //other layers stores it in the layer image of layer 0.
+    {
+      mitk::ImageReadAccessor layerAccess(layerResults[0]);
+      mitk::ImageWriteAccessor resultAccess(resultLabelSetImage);
+      std::memcpy(resultAccess.GetData(), layerAccess.GetData(), layerAccess.GetSize());
+    }
+
+    for (unsigned int layerID = 0; layerID < numberOfLayers; ++layerID)
+    {
+      if (resultLabelSetImage->GetNumberOfLayers() <= layerID)
+      {
+        resultLabelSetImage->AddLayer(layerResults[layerID]);
+      }
+      resultLabelSetImage->AddLabelSetToLayer(layerID, inputLabelSetImage->GetLabelSet(layerID));
     }
 
     resultLabelSetImage->SetActiveLayer(inputLabelSetImage->GetActiveLayer());
@@ -17,8 +17,25 @@ found in the LICENSE file.
 #include "itkImageIterator.h"
 #include "itkArray.h"
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
 namespace itk
 {
+/** Timing of one chunk of voxels processed by MultiOutputNaryFunctorImageFilter.*/
+struct MultiOutputNaryFunctorChunkStatistic
+{
+  /** Position of the first voxel of the chunk in the work list of the filter.*/
+  SizeValueType FirstVoxel;
+  SizeValueType NumberOfVoxels;
+  /** Work unit that processed the chunk.*/
+  ThreadIdType WorkUnit;
+  /** Wall clock time needed to process the chunk (in seconds).*/
+  double Duration;
+};
+
 /** \class MultiOutputNaryFunctorImageFilter
  * \brief Perform a generic pixel-wise operation on N images and produces m output images.
  *
@@ -32,7 +49,12 @@ namespace itk
  * operation to be applied.  A Functor style is used to represent the
  * function.\n
  *
- * All the input images must be of the same type.
+ * All the input images must be of the same type.\n
+ * Only voxels inside the mask are passed to the functor. The filter compacts them into a dense
+ * work list and the work units fetch chunks of ChunkSize voxels from this list until it is
+ * exhausted. Thus work units that get voxels which are cheap to evaluate (e.g. fast converging
+ * fits) simply process more chunks and no work unit idles on masked out areas. The timing of
+ * each chunk can be retrieved via GetChunkStatistics() after the update.
  *
  * \ingroup IntensityImageFilters MultiThreaded
  * \ingroup ITKImageIntensity
@@ -96,6 +118,19 @@ public:
   itkSetObjectMacro(Mask, MaskImageType);
   itkGetConstObjectMacro(Mask, MaskImageType);
 
+  /** Number of voxels a work unit fetches from the work list at once. Default is 16.*/
+  itkSetClampMacro(ChunkSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(ChunkSize, SizeValueType);
+
+  typedef MultiOutputNaryFunctorChunkStatistic ChunkStatisticType;
+  typedef std::vector<ChunkStatisticType> ChunkStatisticsType;
+
+  /** Timings of all chunks processed by the last update (ordered by FirstVoxel).*/
+  const ChunkStatisticsType& GetChunkStatistics() const
+  {
+    return m_ChunkStatistics;
+  }
+
   /** ImageDimension constants */
   itkStaticConstMacro(
     InputImageDimension, unsigned int, TInputImage::ImageDimension);
@@ -114,18 +149,9 @@ protected:
   MultiOutputNaryFunctorImageFilter();
   ~MultiOutputNaryFunctorImageFilter() override {}
 
-  /** MultiOutputNaryFunctorImageFilter can be implemented as a multi threaded filter.
-   * Therefore, this implementation provides a ThreadedGenerateData() routine
-   * which is called for each processing thread. The output image data is
-   * allocated automatically by the superclass prior to calling
-   * ThreadedGenerateData().  ThreadedGenerateData can only write to the
-   * portion of the output image specified by the parameter
-   * "outputRegionForThread"
-   *
-   * \sa ImageToImageFilter::ThreadedGenerateData(),
-   *     ImageToImageFilter::GenerateData()  */
-  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
-                            ThreadIdType threadId) override;
+  /** Compacts the voxels of the requested region that are inside the mask into a work list
+   * (voxels outside are set to 0) and processes the list in chunks with all work units. */
+  void GenerateData() override;
 
   /** Methods actualize the output settings of the filter according to the current functor*/
   void ActualizeOutputs();
@@ -134,8 +160,34 @@ private:
   MultiOutputNaryFunctorImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);         //purposely not implemented
 
+  typedef typename InputImageType::IndexType IndexType;
+  /** Offsets of the voxels to process in the buffer of the primary output.*/
+  typedef std::vector<OffsetValueType> WorkListType;
+
+  struct ThreadStruct
+  {
+    Self* Filter;
+    const WorkListType* WorkList;
+  };
+
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void* arg);
+
+  /** Fetches and processes chunks of the work list until it is exhausted or an other work unit failed.*/
+  void ProcessWorkList(const WorkListType& workList, ThreadIdType workUnit);
+
   FunctorType m_Functor;
   MaskImagePointer m_Mask;
+  SizeValueType m_ChunkSize;
+
+  ChunkStatisticsType m_ChunkStatistics;
+
+  /** State of the current update shared by the work units.*/
+  std::atomic<SizeValueType> m_NextVoxel;
+  std::atomic<SizeValueType> m_ProcessedVoxels;
+  std::atomic<bool> m_Abort;
+  std::mutex m_Mutex;
+  std::mutex m_ProgressMutex;
+  std::exception_ptr m_Exception;
 };
 } // end namespace itk
 
@@ -14,8 +14,11 @@ found in the LICENSE file.
 #define __itkMultiOutputNaryFunctorImageFilter_hxx
 
 #include "itkMultiOutputNaryFunctorImageFilter.h"
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <algorithm>
+#include <chrono>
 
 namespace itk
 {
@@ -26,7 +29,7 @@ namespace itk
   MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
     ::MultiOutputNaryFunctorImageFilter()
   {
-    this->DynamicMultiThreadingOff();
+    this->m_ChunkSize = 16;
 
     // This number will be incremented each time an image
     // is added over the two minimum required
@@ -53,180 +56,204 @@ namespace itk
     }
   };
 
-  /**
-  * ThreadedGenerateData Performs the pixel-wise addition
-  */
   template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
   void
     MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
-    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
-    ThreadIdType threadId)
+    ::GenerateData()
   {
-    ProgressReporter progress( this, threadId,
-      outputRegionForThread.GetNumberOfPixels() );
-
-    const unsigned int numberOfInputImages =
-      static_cast< unsigned int >( this->GetNumberOfIndexedInputs() );
-
-    const unsigned int numberOfOutputImages =
-      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+    this->AllocateOutputs();
+    this->m_ChunkStatistics.clear();
 
-    typedef ImageRegionConstIterator< TInputImage > ImageRegionConstIteratorType;
-    std::vector< ImageRegionConstIteratorType * > inputItrVector;
-    inputItrVector.reserve(numberOfInputImages);
+    const OutputImageRegionType outputRegion = this->GetOutput()->GetRequestedRegion();
 
-    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
-    std::vector< OutputImageRegionIteratorType * > outputItrVector;
-    outputItrVector.reserve(numberOfOutputImages);
+    if (m_Mask.IsNotNull() && !m_Mask->GetLargestPossibleRegion().IsInside(outputRegion))
+    {
+      itkExceptionMacro("Mask of filter is set but does not cover requested region. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Requested region: "<<outputRegion)
+    }
 
-    //check if mask image is set and generate iterator if mask is valid
-    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
-    MaskImageRegionIteratorType* pMaskIterator = nullptr;
+    // compact the offsets of the valid voxels into the work list and reset all other voxels
+    WorkListType workList;
+    if (m_Mask.IsNull())
+    {
+      workList.reserve(outputRegion.GetNumberOfPixels());
+    }
+    else
+    {
+      // count first, a sparse mask should not reserve the whole region
+      SizeValueType numberOfMaskedVoxels = 0;
+      for (ImageRegionConstIterator< MaskImageType > maskPos(m_Mask, outputRegion); !maskPos.IsAtEnd(); ++maskPos)
+      {
+        if (maskPos.Get() > 0)
+        {
+          ++numberOfMaskedVoxels;
+        }
+      }
+      workList.reserve(numberOfMaskedVoxels);
+    }
 
-    if (m_Mask.IsNotNull())
+    std::vector< TOutputImage * > outputs;
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
     {
-      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+      auto* outputPtr = dynamic_cast< TOutputImage * >(ProcessObject::GetOutput(i));
+      if (outputPtr)
       {
-        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+        outputs.push_back(outputPtr);
       }
-      pMaskIterator = new MaskImageRegionIteratorType(m_Mask,outputRegionForThread);
     }
 
-    // go through the inputs and add iterators for non-null inputs
-    for ( unsigned int i = 0; i < numberOfInputImages; ++i )
+    for (ImageRegionConstIteratorWithIndex< TOutputImage > pos(this->GetOutput(), outputRegion); !pos.IsAtEnd(); ++pos)
     {
-      InputImagePointer inputPtr =
-        dynamic_cast< TInputImage * >( ProcessObject::GetInput(i) );
+      const IndexType index = pos.GetIndex();
 
-      if ( inputPtr )
+      if (m_Mask.IsNull() || m_Mask->GetPixel(index) > 0)
+      {
+        workList.push_back(this->GetOutput()->ComputeOffset(index));
+      }
+      else
       {
-        inputItrVector.push_back( new ImageRegionConstIteratorType(inputPtr, outputRegionForThread) );
+        for (auto output : outputs)
+        {
+          output->SetPixel(index, NumericTraits< OutputImagePixelType >::ZeroValue());
+        }
       }
+    }
+
+    m_NextVoxel = 0;
+    m_ProcessedVoxels = 0;
+    m_Abort = false;
+    m_Exception = nullptr;
+
+    ThreadStruct str;
+    str.Filter = this;
+    str.WorkList = &workList;
 
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+
+    if (m_Exception)
+    {
+      std::rethrow_exception(m_Exception);
     }
 
-    // go through the outputs and add iterators for non-null outputs
-    for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
+    std::sort(m_ChunkStatistics.begin(), m_ChunkStatistics.end(),
+      [](const ChunkStatisticType& a, const ChunkStatisticType& b) { return a.FirstVoxel < b.FirstVoxel; });
+
+    this->UpdateProgress(1.0f);
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  ITK_THREAD_RETURN_TYPE
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ThreaderCallback(void* arg)
+  {
+    auto* info = static_cast<MultiThreaderBase::WorkUnitInfo*>(arg);
+    auto* str = static_cast<ThreadStruct*>(info->UserData);
+
+    str->Filter->ProcessWorkList(*(str->WorkList), info->WorkUnitID);
+
+    return ITK_THREAD_RETURN_DEFAULT_VALUE;
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ProcessWorkList(const WorkListType& workList, ThreadIdType workUnit)
+  {
+    std::vector< const TInputImage * > inputs;
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
     {
-      OutputImagePointer outputPtr =
-        dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+      auto* inputPtr = dynamic_cast< const TInputImage * >(ProcessObject::GetInput(i));
+      if (inputPtr)
+      {
+        inputs.push_back(inputPtr);
+      }
+    }
 
-      if ( outputPtr )
+    std::vector< TOutputImage * > outputs;
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
+    {
+      auto* outputPtr = dynamic_cast< TOutputImage * >(ProcessObject::GetOutput(i));
+      if (outputPtr)
       {
-        outputItrVector.push_back( new OutputImageRegionIteratorType(outputPtr, outputRegionForThread) );
+        outputs.push_back(outputPtr);
       }
     }
 
-    typename std::vector< ImageRegionConstIteratorType * >::iterator regionInputIterators;
-    const typename std::vector< ImageRegionConstIteratorType * >::const_iterator regionInputItEnd =
-      inputItrVector.end();
+    if (inputs.empty() || outputs.empty())
+    {
+      return;
+    }
 
-    typename std::vector< OutputImageRegionIteratorType * >::iterator regionOutputIterators;
-    const typename std::vector< OutputImageRegionIteratorType * >::const_iterator regionOutputItEnd =
-      outputItrVector.end();
+    const SizeValueType voxelCount = workList.size();
+    const float progressScale = voxelCount > 0 ? 1.0f / voxelCount : 0.0f;
 
-    const unsigned int numberOfValidInputImages = inputItrVector.size();
-    const unsigned int numberOfValidOutputImages = outputItrVector.size();
+    ChunkStatisticsType statistics;
+    NaryInputArrayType naryInputArray(inputs.size());
 
-    if ( (numberOfValidInputImages != 0) && ( numberOfValidOutputImages != 0))
+    try
     {
-      try
+      while (!m_Abort)
       {
-
-        while ( !(outputItrVector.front()->IsAtEnd()) )
+        const SizeValueType first = m_NextVoxel.fetch_add(m_ChunkSize);
+        if (first >= voxelCount)
         {
-          typename NaryInputArrayType::iterator arrayInIt;
-          typename NaryOutputArrayType::iterator arrayOutIt;
-          NaryInputArrayType naryInputArray(numberOfValidInputImages);
-          NaryOutputArrayType naryOutputArray(numberOfValidOutputImages);
-
-          bool isValid = true;
-
-          if (pMaskIterator)
-          {
-            isValid = pMaskIterator->Get() > 0;
-            ++(*pMaskIterator);
-          }
+          break;
+        }
+        const SizeValueType last = std::min(first + m_ChunkSize, voxelCount);
 
-          arrayInIt = naryInputArray.begin();
-          regionInputIterators = inputItrVector.begin();
+        const auto startTime = std::chrono::steady_clock::now();
 
-          typename ImageRegionConstIteratorType::IndexType currentIndex;
-          if(regionInputIterators != regionInputItEnd)
-          {
-            currentIndex = ( *regionInputIterators )->GetIndex();
-          }
+        for (SizeValueType pos = first; pos < last; ++pos)
+        {
+          const IndexType index = outputs.front()->ComputeIndex(workList[pos]);
 
-          while ( regionInputIterators != regionInputItEnd )
+          auto arrayInIt = naryInputArray.begin();
+          for (auto input : inputs)
           {
-            *arrayInIt++ = ( *regionInputIterators )->Get();
-            ++( *( *regionInputIterators ) );
-            ++regionInputIterators;
+            *arrayInIt++ = input->GetPixel(index);
           }
 
-          if (isValid)
-          {
-            naryOutputArray = m_Functor(naryInputArray, currentIndex);
+          const NaryOutputArrayType naryOutputArray = m_Functor(naryInputArray, index);
 
-            if (numberOfValidOutputImages != naryOutputArray.size())
-            {
-              itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< numberOfValidOutputImages << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
-            }
-          }
-          else
+          if (outputs.size() != naryOutputArray.size())
           {
-            for (typename NaryOutputArrayType::iterator pos = naryOutputArray.begin(); pos!= naryOutputArray.end(); ++pos)
-            {
-                *pos = 0.0;
-            }
+            itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< outputs.size() << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
           }
 
-          arrayOutIt = naryOutputArray.begin();
-          regionOutputIterators = outputItrVector.begin();
-          while ( regionOutputIterators != regionOutputItEnd )
+          auto arrayOutIt = naryOutputArray.begin();
+          for (auto output : outputs)
           {
-            ( *regionOutputIterators )->Set(*arrayOutIt++);
-            ++( *( *regionOutputIterators ) );
-            ++regionOutputIterators;
+            output->SetPixel(index, *arrayOutIt++);
           }
-
-          progress.CompletedPixel();
-        }
-      }
-      catch(...)
-      {
-        // Free memory in case of exceptions
-        regionInputIterators = inputItrVector.begin();
-        while ( regionInputIterators != regionInputItEnd )
-        {
-          delete ( *regionInputIterators++ );
         }
 
-        regionOutputIterators = outputItrVector.begin();
-        while ( regionOutputIterators != regionOutputItEnd )
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+        statistics.push_back({ first, last - first, workUnit, duration.count() });
+
+        const SizeValueType processed = m_ProcessedVoxels.fetch_add(last - first) + (last - first);
+
+        // only one work unit at a time reports the progress; the others just continue
+        std::unique_lock<std::mutex> progressLock(m_ProgressMutex, std::try_to_lock);
+        if (progressLock.owns_lock() && processed < voxelCount)
         {
-          delete ( *regionOutputIterators++ );
+          this->UpdateProgress(processed * progressScale);
         }
-
-        delete pMaskIterator;
-        throw;
       }
     }
-
-    // Free memory regulary
-    regionInputIterators = inputItrVector.begin();
-    while ( regionInputIterators != regionInputItEnd )
+    catch (...)
     {
-      delete ( *regionInputIterators++ );
-    }
+      m_Abort = true;
 
-    regionOutputIterators = outputItrVector.begin();
-    while ( regionOutputIterators != regionOutputItEnd )
-    {
-      delete ( *regionOutputIterators++ );
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (!m_Exception)
+      {
+        m_Exception = std::current_exception();
+      }
     }
 
-    delete pMaskIterator;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ChunkStatistics.insert(m_ChunkStatistics.end(), statistics.begin(), statistics.end());
   }
 } // end namespace itk
 
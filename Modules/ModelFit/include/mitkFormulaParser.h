@@ -13,8 +13,10 @@ found in the LICENSE file.
 #ifndef mitkFormulaParser_h
 #define mitkFormulaParser_h
 
+#include <cstddef>
 #include <string>
 #include <map>
+#include <vector>
 
 #include "mitkExceptionMacro.h"
 
@@ -102,6 +104,90 @@ namespace mitk
     /*! @brief Map that holds the values that will replace the variables during evaluation. */
     const VariableMapType* m_Variables;
   };
+
+
+  class FormulaCompiler;
+
+  /*!
+   *	@brief		This class parses a formula string once and evaluates it as often as needed
+   *				for changing variable values.
+   *	@details	The formula string is compiled into a postfix program, variables are
+   *				referenced by their index in the list of variable names passed to the
+   *				constructor. The language is the same as the one of @ref FormulaParser.
+   *
+   *				Use it instead of @ref FormulaParser if the same formula has to be evaluated
+   *				for many values (e.g. for every time point of a model function).
+   */
+  class MITKMODELFIT_EXPORT CompiledFormula
+  {
+  public:
+    using ValueType = FormulaParser::ValueType;
+    using VariableNamesType = std::vector<std::string>;
+
+    /*!
+     *	@brief						Compiles the @b input string.
+     *	@param[in] input			The string to be compiled.
+     *	@param[in] variableNames	The names of all variables the string may contain.
+     *	@throw FormulaParserException	If the string cannot be parsed or contains a variable
+     *								that is not in @b variableNames.
+     */
+    CompiledFormula(const std::string& input, const VariableNamesType& variableNames);
+
+    /*!
+     *	@brief				Evaluates the formula.
+     *	@param[in] values	The values of the variables, in the order of the variable names
+     *						passed to the constructor.
+     */
+    ValueType evaluate(const ValueType* values) const;
+
+    /*!
+     *	@brief						Evaluates the formula for @b count values of one variable
+     *								(e.g. all points of a time grid).
+     *	@details					Each instruction of the program is applied to all values
+     *								before the next one is executed, so the compiler can
+     *								vectorize the arithmetic.
+     *	@param[in] values			The values of the variables, in the order of the variable
+     *								names passed to the constructor. The value of the varying
+     *								variable is ignored.
+     *	@param[in] varyingVariable	Index of the variable that takes the @b varyingValues.
+     *	@param[in] varyingValues	@b count values of the varying variable.
+     *	@param[in] count			Number of values to evaluate.
+     *	@param[out] results			Receives the @b count results.
+     */
+    void evaluate(const ValueType* values,
+                  std::size_t varyingVariable,
+                  const ValueType* varyingValues,
+                  std::size_t count,
+                  ValueType* results) const;
+
+  private:
+    friend class FormulaCompiler;
+
+    enum class OpCode
+    {
+      Constant,
+      Variable,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Negate,
+      Function
+    };
+
+    struct Instruction
+    {
+      OpCode code;
+      ValueType constant;
+      std::size_t variable;
+      ValueType(*function)(ValueType);
+    };
+
+    std::vector<Instruction> m_Program;
+
+    /*! @brief Number of intermediate results the evaluation has to hold at the same time. */
+    std::size_t m_StackSize;
+  };
 }
 
 #endif
@@ -17,8 +17,12 @@ found in the LICENSE file.
 
 #include "MitkModelFitExports.h"
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
+  class CompiledFormula;
 
   /** Model that can parse a user specified function string and uses it as model function
   that is represented by the model instance.
@@ -98,6 +102,14 @@ namespace mitk
     /**Number of parameters the model should offer / the function string contains.*/
     ParametersSizeType m_NumberOfParameters;
 
+    /**The function string is compiled once and reused for all model function computations
+    until the function string or the parameters change. Guarded by m_CompiledFunctionMutex,
+    because a model may be evaluated by several threads.*/
+    mutable std::shared_ptr<const CompiledFormula> m_CompiledFunction;
+    mutable FunctionStringType m_CompiledFunctionString;
+    mutable std::vector<std::string> m_CompiledVariableNames;
+    mutable std::mutex m_CompiledFunctionMutex;
+
     //No copy constructor allowed
     GenericParamModel(const Self& source);
     void operator=(const Self&);  //purposely not implemented
@@ -43,6 +43,7 @@ namespace mitk
     itkSetMacro(GradientTolerance, double);
     itkSetMacro(ValueTolerance, double);
     itkSetMacro(DerivativeStepLength, double);
+    itkSetMacro(UseModelDerivatives, bool);
     itkSetMacro(Iterations, unsigned int);
     itkSetMacro(Scales, ::itk::LevenbergMarquardtOptimizer::ScalesType);
 
@@ -50,6 +51,8 @@ namespace mitk
     itkGetMacro(GradientTolerance, double);
     itkGetMacro(ValueTolerance, double);
     itkGetMacro(DerivativeStepLength, double);
+    itkGetMacro(UseModelDerivatives, bool);
+    itkBooleanMacro(UseModelDerivatives);
     itkGetMacro(Iterations, unsigned int);
     itkGetMacro(Scales, ::itk::LevenbergMarquardtOptimizer::ScalesType);
 
@@ -88,6 +91,9 @@ namespace mitk
     double m_ValueTolerance;
     unsigned int m_Iterations;
     double m_DerivativeStepLength;
+    /**If true (default), the signal derivatives of models that offer them (see ModelBase::HasSignalDerivatives())
+     are used by the optimizer instead of numerical derivatives.*/
+    bool m_UseModelDerivatives;
     ::itk::LevenbergMarquardtOptimizer::ScalesType m_Scales;
 
     /**Constraint checker. If set it will be used by the optimization strategies to add additional constraints to the
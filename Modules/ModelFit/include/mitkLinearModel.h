@@ -59,6 +59,8 @@ namespace mitk
 
     ParametersSizeType  GetNumberOfDerivedParameters() const override;
 
+    bool HasSignalDerivatives() const override;
+
   protected:
     LinearModel() {};
     ~LinearModel() override {};
@@ -70,6 +72,7 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+    ModelDerivativeType ComputeModelfunctionDerivatives(const ParametersType& parameters) const override;
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -81,6 +81,8 @@ protected:
     MVConstrainedCostFunctionDecorator() : m_FailureThreshold(1e15), m_ActivateFailureThreshold(true),
       m_EvaluationCount(0), m_PenaltyCount(0), m_FailureCount(0), m_LastFailedParameter(-1)
     {
+      //the penalties of the constraint checker have no analytic derivatives
+      this->SetUseModelDerivatives(false);
     }
 
     ~MVConstrainedCostFunctionDecorator() override{}
@@ -60,6 +60,9 @@ namespace mitk
     /** Type defining the time grid used be models.
      * @remark the model time grid has a resolution in sec and not like the time geometry which uses ms.*/
     typedef itk::Array<double> TimeGridType;
+    /** Type of the derivatives of the signal with respect to the parameters.
+     * Element [i][j] is the derivative of the signal at time point j with respect to parameter i.*/
+    typedef itk::Array2D<double> ModelDerivativeType;
     typedef ModelTraitsInterface::ParameterNameType ParameterNameType;
     typedef ModelTraitsInterface::ParameterNamesType ParameterNamesType;
     typedef ModelTraitsInterface::ParametersSizeType ParametersSizeType;
@@ -168,10 +171,25 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Indicates if the model can compute the derivatives of its signal with respect to its parameters
+     * in closed form (or by automatic differentiation); see GetSignalDerivatives(). Cost functions use them
+     * instead of finite differences if available.
+     * @remark Default implementation returns false. Reimplement together with ComputeModelfunctionDerivatives().*/
+    virtual bool HasSignalDerivatives() const;
+
+    /** Returns the derivatives of the signal with respect to the parameters (see ModelDerivativeType).
+     * @pre HasSignalDerivatives() returns true.*/
+    ModelDerivativeType GetSignalDerivatives(const ParametersType& parameters) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Helper function called by GetSignalDerivatives(). Implement in derived classes that return true
+     * in HasSignalDerivatives().
+     * @remark Default implementation throws an exception.*/
+    virtual ModelDerivativeType ComputeModelfunctionDerivatives(const ParametersType& parameters) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
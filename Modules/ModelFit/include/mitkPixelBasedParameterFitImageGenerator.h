@@ -17,6 +17,8 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 
+#include "itkMultiOutputNaryFunctorImageFilter.h"
+
 #include "mitkModelParameterizerBase.h"
 #include "mitkModelFitFunctorBase.h"
 #include "mitkParameterFitImageGeneratorBase.h"
@@ -36,6 +38,9 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * The voxels inside the mask are fitted in chunks that are handed out dynamically to all threads
+   * (see itk::MultiOutputNaryFunctorImageFilter). The timing of each chunk of the last fit can be
+   * retrieved via GetChunkStatistics().
    */
 class MITKMODELFIT_EXPORT PixelBasedParameterFitImageGenerator: public ParameterFitImageGeneratorBase
 {
@@ -71,6 +76,18 @@ public:
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
 
+    /** Number of voxels a thread fits before it fetches new voxels. Default is 16.*/
+    itkSetClampMacro(ChunkSize, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+    itkGetConstMacro(ChunkSize, unsigned int);
+
+    typedef std::vector<itk::MultiOutputNaryFunctorChunkStatistic> ChunkStatisticsType;
+
+    /** Timings of all voxel chunks of the last fit.*/
+    const ChunkStatisticsType& GetChunkStatistics() const
+    {
+      return m_ChunkStatistics;
+    };
+
     double GetProgress() const override;
 
     ParameterNamesType GetParameterNames() const override;
@@ -82,7 +99,7 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false), m_ChunkSize(16)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -123,6 +140,9 @@ private:
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
+
+    unsigned int m_ChunkSize;
+    ChunkStatisticsType m_ChunkStatistics;
 };
 
 }
@@ -50,11 +50,30 @@ public:
     itkSetMacro(DerivativeStepLength, double);
     itkGetConstMacro(DerivativeStepLength, double);
 
+    /**If true (default) and the model offers signal derivatives (see ModelBase::HasSignalDerivatives()),
+     GetDerivative() uses them instead of computing the derivatives numerically.*/
+    itkSetMacro(UseModelDerivatives, bool);
+    itkGetConstMacro(UseModelDerivatives, bool);
+    itkBooleanMacro(UseModelDerivatives);
+
 protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
-    SVModelFitCostFunction(): m_DerivativeStepLength(1e-5)
+    /**Indicates if CalcMeasureDerivative() is implemented. GetDerivative() only computes the model signal and
+     its derivatives for the analytic derivative if this returns true. The default implementation returns false.
+     Reimplement together with CalcMeasureDerivative().*/
+    virtual bool SupportsMeasureDerivative() const;
+
+    /**Computes the derivative of the measure by applying the chain rule to the passed derivatives of the model signal.
+     Used by GetDerivative() if the model offers signal derivatives and SupportsMeasureDerivative() returns true.
+     Reimplement in derived classes whose measure can be derived this way.
+     @return False if the cost function cannot compute the derivative from the signal derivatives. Then the
+     derivative is computed numerically. The default implementation always returns false.*/
+    virtual bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+      const ModelBase::ModelDerivativeType& signalDerivatives, DerivativeType& derivative) const;
+
+    SVModelFitCostFunction() : m_DerivativeStepLength(1e-5), m_UseModelDerivatives(true)
 	{
     }
 
@@ -67,6 +86,9 @@ private:
 
     /**value (delta of parameters) used to compute the derivatives numerically*/
     double m_DerivativeStepLength;
+
+    /**Indicates if the signal derivatives of the model should be used if available*/
+    bool m_UseModelDerivatives;
 };
 
 }
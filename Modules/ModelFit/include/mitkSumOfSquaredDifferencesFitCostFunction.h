@@ -40,6 +40,11 @@ protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
 
+    bool SupportsMeasureDerivative() const override;
+
+    bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+      const ModelBase::ModelDerivativeType& signalDerivatives, DerivativeType& derivative) const override;
+
     SumOfSquaredDifferencesFitCostFunction()
     {
     }
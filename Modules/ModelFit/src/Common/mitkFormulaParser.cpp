@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include "mitkFormulaParser.h"
 #include "mitkFresnel.h"
 
+#include <algorithm>
+#include <cctype>
+
 namespace qi = boost::spirit::qi;
 namespace ascii = boost::spirit::ascii;
 namespace phx = boost::phoenix;
@@ -107,6 +110,25 @@ namespace mitk
     return static_cast<T>(fresnel_c(x) / boost::math::constants::root_two_div_pi<T>());
   }
 
+  using UnaryFunctionType = FormulaParser::ValueType(*)(FormulaParser::ValueType);
+
+  /*!
+   *	@brief	The unary functions of the language, shared by the Grammar and the
+   *			FormulaCompiler.
+   */
+  const std::pair<const char*, UnaryFunctionType> UnaryFunctions[] = {
+    { "abs", static_cast<UnaryFunctionType>(&std::abs) },
+    { "exp", static_cast<UnaryFunctionType>(&std::exp) }, // @TODO: exp ignores division by zero
+    { "sin", static_cast<UnaryFunctionType>(&std::sin) },
+    { "cos", static_cast<UnaryFunctionType>(&std::cos) },
+    { "tan", static_cast<UnaryFunctionType>(&std::tan) },
+    { "sind", &sind<FormulaParser::ValueType> },
+    { "cosd", &cosd<FormulaParser::ValueType> },
+    { "tand", &tand<FormulaParser::ValueType> },
+    { "fresnelS", &fresnelS<FormulaParser::ValueType> },
+    { "fresnelC", &fresnelC<FormulaParser::ValueType> }
+  };
+
   /*!
    *	@brief		The grammar that defines the language (i.e. what is allowed) for the parser.
    */
@@ -168,17 +190,10 @@ namespace mitk
        */
       unaryFunction_()
       {
-        this->add
-        ("abs", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::abs))
-          ("exp", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::exp)) // @TODO: exp ignores division by zero
-          ("sin", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::sin))
-          ("cos", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::cos))
-          ("tan", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::tan))
-          ("sind", &sind)
-          ("cosd", &cosd)
-          ("tand", &tand)
-          ("fresnelS", &fresnelS)
-          ("fresnelC", &fresnelC);
+        for (const auto& function : UnaryFunctions)
+        {
+          this->add(function.first, function.second);
+        }
       }
     } unaryFunction;
 
@@ -285,4 +300,345 @@ namespace mitk
     }
   };
 
+
+  /*!
+   *	@brief	Recursive descent parser that compiles a formula string into the program of a
+   *			CompiledFormula. It follows the rules of the Grammar, so both accept the same
+   *			strings (e.g. numbers are parsed with @c qi::double_ and, like in the grammar,
+   *			whitespace is skipped everywhere except within numbers).
+   */
+  class FormulaCompiler
+  {
+  public:
+    FormulaCompiler(const std::string& input,
+                    const CompiledFormula::VariableNamesType& variableNames,
+                    CompiledFormula& formula)
+      : m_Input(input), m_Pos(input.begin()), m_VariableNames(variableNames), m_Formula(formula), m_StackDepth(0)
+    {
+    }
+
+    void compile()
+    {
+      m_Formula.m_Program.clear();
+      m_Formula.m_StackSize = 0;
+
+      skipSpaces();
+      if (m_Pos == m_Input.end())
+      {
+        mitkThrowException(FormulaParserException) << "Could not parse '" << m_Input <<
+          "': Grammar could not be applied to the input " << "at all.";
+      }
+
+      expression();
+
+      skipSpaces();
+      if (m_Pos != m_Input.end())
+      {
+        throwUnexpectedCharacter();
+      }
+    }
+
+  private:
+    using OpCode = CompiledFormula::OpCode;
+
+    void skipSpaces()
+    {
+      while (m_Pos != m_Input.end() && std::isspace(static_cast<unsigned char>(*m_Pos)))
+      {
+        ++m_Pos;
+      }
+    }
+
+    bool consume(char c)
+    {
+      skipSpaces();
+      if (m_Pos != m_Input.end() && *m_Pos == c)
+      {
+        ++m_Pos;
+        return true;
+      }
+      return false;
+    }
+
+    static bool isAlpha(char c)
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    static bool isAlnum(char c)
+    {
+      return isAlpha(c) || (c >= '0' && c <= '9');
+    }
+
+    [[noreturn]] void throwUnexpectedCharacter() const
+    {
+      if (m_Pos == m_Input.end())
+      {
+        mitkThrowException(FormulaParserException) << "Error while parsing '" << m_Input <<
+          "': Unexpected end of input";
+      }
+      mitkThrowException(FormulaParserException) << "Error while parsing '" << m_Input <<
+        "': Unexpected character '" << *m_Pos << "' after '" << std::string(m_Input.begin(), m_Pos) << "'";
+    }
+
+    void emit(OpCode code, FormulaParser::ValueType constant = 0, std::size_t variable = 0, UnaryFunctionType function = nullptr)
+    {
+      m_Formula.m_Program.push_back({ code, constant, variable, function });
+
+      if (code == OpCode::Constant || code == OpCode::Variable)
+      {
+        m_Formula.m_StackSize = std::max(m_Formula.m_StackSize, ++m_StackDepth);
+      }
+      else if (code != OpCode::Negate && code != OpCode::Function)
+      {
+        --m_StackDepth;
+      }
+    }
+
+    void expression()
+    {
+      term();
+      while (true)
+      {
+        if (consume('+'))
+        {
+          term();
+          emit(OpCode::Add);
+        }
+        else if (consume('-'))
+        {
+          term();
+          emit(OpCode::Subtract);
+        }
+        else
+        {
+          break;
+        }
+      }
+    }
+
+    void term()
+    {
+      primary();
+      while (true)
+      {
+        if (consume('*'))
+        {
+          primary();
+          emit(OpCode::Multiply);
+        }
+        else if (consume('/'))
+        {
+          primary();
+          emit(OpCode::Divide);
+        }
+        else
+        {
+          break;
+        }
+      }
+    }
+
+    void primary()
+    {
+      skipSpaces();
+      if (m_Pos == m_Input.end())
+      {
+        throwUnexpectedCharacter();
+      }
+
+      Iter numberEnd = m_Pos;
+      FormulaParser::ValueType number = 0;
+      if (qi::parse(numberEnd, m_Input.end(), qi::double_, number))
+      {
+        m_Pos = numberEnd;
+        emit(OpCode::Constant, number);
+        return;
+      }
+
+      if (consume('('))
+      {
+        expression();
+        if (!consume(')'))
+        {
+          throwUnexpectedCharacter();
+        }
+        return;
+      }
+
+      if (consume('-'))
+      {
+        primary();
+        emit(OpCode::Negate);
+        return;
+      }
+
+      if (consume('+'))
+      {
+        primary();
+        return;
+      }
+
+      // like qi::symbols, use the longest function name the input starts with
+      const std::pair<const char*, UnaryFunctionType>* function = nullptr;
+      std::size_t functionNameLength = 0;
+      for (const auto& candidate : UnaryFunctions)
+      {
+        const std::size_t length = std::char_traits<char>::length(candidate.first);
+        if (length > functionNameLength && static_cast<std::size_t>(m_Input.end() - m_Pos) >= length &&
+            std::equal(candidate.first, candidate.first + length, m_Pos))
+        {
+          function = &candidate;
+          functionNameLength = length;
+        }
+      }
+
+      if (function != nullptr)
+      {
+        const Iter functionStart = m_Pos;
+        m_Pos += functionNameLength;
+        if (consume('('))
+        {
+          expression();
+          if (!consume(')'))
+          {
+            throwUnexpectedCharacter();
+          }
+          emit(OpCode::Function, 0, 0, function->second);
+          return;
+        }
+        // not a function call, but a variable whose name starts with a function name
+        m_Pos = functionStart;
+      }
+
+      if (isAlpha(*m_Pos))
+      {
+        std::string name(1, *m_Pos++);
+        while (true)
+        {
+          const Iter nameEnd = m_Pos;
+          skipSpaces();
+          if (m_Pos != m_Input.end() && (isAlnum(*m_Pos) || *m_Pos == '_'))
+          {
+            name += *m_Pos++;
+          }
+          else
+          {
+            m_Pos = nameEnd;
+            break;
+          }
+        }
+
+        const auto variable = std::find(m_VariableNames.begin(), m_VariableNames.end(), name);
+        if (variable == m_VariableNames.end())
+        {
+          mitkThrowException(FormulaParserException) << "No variable '" << name << "' defined in lookup";
+        }
+        emit(OpCode::Variable, 0, static_cast<std::size_t>(variable - m_VariableNames.begin()));
+        return;
+      }
+
+      throwUnexpectedCharacter();
+    }
+
+    const std::string& m_Input;
+    Iter m_Pos;
+    const CompiledFormula::VariableNamesType& m_VariableNames;
+    CompiledFormula& m_Formula;
+    std::size_t m_StackDepth;
+  };
+
+  CompiledFormula::CompiledFormula(const std::string& input, const VariableNamesType& variableNames)
+    : m_StackSize(0)
+  {
+    FormulaCompiler(input, variableNames, *this).compile();
+  }
+
+  CompiledFormula::ValueType CompiledFormula::evaluate(const ValueType* values) const
+  {
+    ValueType result = 0;
+    this->evaluate(values, 0, values, 1, &result);
+    return result;
+  }
+
+  void CompiledFormula::evaluate(const ValueType* values,
+                                 std::size_t varyingVariable,
+                                 const ValueType* varyingValues,
+                                 std::size_t count,
+                                 ValueType* results) const
+  {
+    if (count == 0)
+    {
+      return;
+    }
+
+    // one row of count values per stack entry
+    std::vector<ValueType> stack(m_StackSize * count);
+    ValueType* top = stack.data() - count;
+
+    for (const auto& instruction : m_Program)
+    {
+      switch (instruction.code)
+      {
+        case OpCode::Constant:
+          top += count;
+          std::fill(top, top + count, instruction.constant);
+          break;
+        case OpCode::Variable:
+          top += count;
+          if (instruction.variable == varyingVariable)
+          {
+            std::copy(varyingValues, varyingValues + count, top);
+          }
+          else
+          {
+            std::fill(top, top + count, values[instruction.variable]);
+          }
+          break;
+        case OpCode::Add:
+          top -= count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] += top[count + i];
+          }
+          break;
+        case OpCode::Subtract:
+          top -= count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] -= top[count + i];
+          }
+          break;
+        case OpCode::Multiply:
+          top -= count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] *= top[count + i];
+          }
+          break;
+        case OpCode::Divide:
+          top -= count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] /= top[count + i];
+          }
+          break;
+        case OpCode::Negate:
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] = -top[i];
+          }
+          break;
+        case OpCode::Function:
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            top[i] = instruction.function(top[i]);
+          }
+          break;
+      }
+    }
+
+    std::copy(top, top + count, results);
+  }
+
 }
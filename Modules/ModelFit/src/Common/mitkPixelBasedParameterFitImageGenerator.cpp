@@ -10,6 +10,8 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <algorithm>
+
 #include "itkCommand.h"
 #include "itkMultiOutputNaryFunctorImageFilter.h"
 
@@ -127,6 +129,7 @@ void
   functor.SetModelFitFunctor(this->m_FitFunctor);
   functor.SetModelParameterizer(this->m_ModelParameterizer);
   fitFilter->SetFunctor(functor);
+  fitFilter->SetChunkSize(this->m_ChunkSize);
   if (this->m_InternalMask.IsNotNull())
   {
     fitFilter->SetMask(this->m_InternalMask);
@@ -135,6 +138,14 @@ void
   //generate the fits
   fitFilter->Update();
 
+  this->m_ChunkStatistics = fitFilter->GetChunkStatistics();
+  if (!this->m_ChunkStatistics.empty())
+  {
+    auto slowest = std::max_element(this->m_ChunkStatistics.begin(), this->m_ChunkStatistics.end(),
+      [](const itk::MultiOutputNaryFunctorChunkStatistic& a, const itk::MultiOutputNaryFunctorChunkStatistic& b) { return a.Duration < b.Duration; });
+    MITK_DEBUG << "Parameter Fit Generator. Fitted " << this->m_ChunkStatistics.size() << " chunks of up to " << this->m_ChunkSize << " voxels. Slowest chunk: " << slowest->Duration << " s (first voxel: " << slowest->FirstVoxel << ").";
+  }
+
   //convert the outputs into mitk images and fill the parameter image map
   ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
   ModelFitFunctorBase::ParameterNamesType paramNames = refModel->GetParameterNames();
@@ -31,6 +31,19 @@ mitk::MVModelFitCostFunction::MeasureType mitk::MVModelFitCostFunction::GetValue
 
 void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &parameters, DerivativeType &derivative) const
 {
+  if (m_UseModelDerivatives && this->SupportsMeasureDerivative() && m_Model->HasSignalDerivatives())
+  {
+    SignalType signal = m_Model->GetSignal(parameters);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+    if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+
+    if (CalcMeasureDerivative(parameters, signal, m_Model->GetSignalDerivatives(parameters), derivative))
+    {
+      return;
+    }
+  }
+
   ParametersType::SizeValueType paramCount = parameters.Size();
   MeasureType::SizeValueType measureCount = GetNumberOfValues();
 
@@ -57,6 +70,17 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
 };
 
+bool mitk::MVModelFitCostFunction::SupportsMeasureDerivative() const
+{
+  return false;
+}
+
+bool mitk::MVModelFitCostFunction::CalcMeasureDerivative(const ParametersType & /*parameters*/, const SignalType & /*signal*/,
+  const ModelBase::ModelDerivativeType & /*signalDerivatives*/, DerivativeType & /*derivative*/) const
+{
+  return false;
+}
+
 unsigned int mitk::MVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
@@ -32,6 +32,19 @@ mitk::SVModelFitCostFunction::MeasureType mitk::SVModelFitCostFunction::GetValue
 
 void mitk::SVModelFitCostFunction::GetDerivative (const ParametersType &parameters, DerivativeType &derivative) const
 {
+  if (m_UseModelDerivatives && this->SupportsMeasureDerivative() && m_Model->HasSignalDerivatives())
+  {
+    SignalType signal = m_Model->GetSignal(parameters);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+    if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+
+    if (CalcMeasureDerivative(parameters, signal, m_Model->GetSignalDerivatives(parameters), derivative))
+    {
+      return;
+    }
+  }
+
   ParametersType::SizeValueType paramCount = parameters.Size();
 
   derivative.SetSize(paramCount);
@@ -52,6 +65,17 @@ void mitk::SVModelFitCostFunction::GetDerivative (const ParametersType &paramete
   }
 };
 
+bool mitk::SVModelFitCostFunction::SupportsMeasureDerivative() const
+{
+  return false;
+}
+
+bool mitk::SVModelFitCostFunction::CalcMeasureDerivative(const ParametersType & /*parameters*/, const SignalType & /*signal*/,
+  const ModelBase::ModelDerivativeType & /*signalDerivatives*/, DerivativeType & /*derivative*/) const
+{
+  return false;
+}
+
 unsigned int mitk::SVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
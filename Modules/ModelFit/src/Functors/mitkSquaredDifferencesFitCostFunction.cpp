@@ -24,3 +24,24 @@ mitk::SquaredDifferencesFitCostFunction::MeasureType mitk::SquaredDifferencesFit
 
   return measure;
 }
+
+bool mitk::SquaredDifferencesFitCostFunction::SupportsMeasureDerivative() const
+{
+  return true;
+}
+
+bool mitk::SquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType & /*parameters*/, const SignalType &signal,
+  const ModelBase::ModelDerivativeType &signalDerivatives, DerivativeType &derivative) const
+{
+  derivative.SetSize(signalDerivatives.rows(), signal.GetSize());
+
+  for(unsigned int p=0; p<signalDerivatives.rows(); ++p)
+  {
+    for(SignalType::size_type i=0; i<signal.GetSize(); ++i)
+    {
+      derivative[p][i] = -2 * (m_Sample[i] - signal[i]) * signalDerivatives[p][i];
+    }
+  }
+
+  return true;
+}
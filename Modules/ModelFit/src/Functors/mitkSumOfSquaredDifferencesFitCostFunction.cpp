@@ -24,3 +24,25 @@ mitk::SumOfSquaredDifferencesFitCostFunction::MeasureType mitk::SumOfSquaredDiff
 
   return measure;
 }
+
+bool mitk::SumOfSquaredDifferencesFitCostFunction::SupportsMeasureDerivative() const
+{
+  return true;
+}
+
+bool mitk::SumOfSquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType & /*parameters*/, const SignalType &signal,
+  const ModelBase::ModelDerivativeType &signalDerivatives, DerivativeType &derivative) const
+{
+  derivative.SetSize(signalDerivatives.rows());
+  derivative.Fill(0.0);
+
+  for(unsigned int p=0; p<signalDerivatives.rows(); ++p)
+  {
+    for(SignalType::size_type i=0; i<signal.GetSize(); ++i)
+    {
+      derivative[p] += -2 * (m_Sample[i] - signal[i]) * signalDerivatives[p][i];
+    }
+  }
+
+  return true;
+}
@@ -97,27 +97,32 @@ mitk::GenericParamModel::ComputeModelfunction(const ParametersType& parameters)
   unsigned int timeSteps = m_TimeGrid.GetSize();
   ModelResultType signal(timeSteps);
 
-  std::map<std::string, double> parameterMap;
-  parameterMap.insert(std::make_pair(GetXName(), 0.0));
+  CompiledFormula::VariableNamesType variableNames;
+  variableNames.push_back(GetXName());
+  std::vector<CompiledFormula::ValueType> values(1, 0.0);
 
   auto paramNames = this->GetParameterNames();
   for (ParametersType::size_type i = 0; i < parameters.size(); ++i)
   {
-    parameterMap.insert(std::make_pair(paramNames[i], parameters[i]));
+    variableNames.push_back(paramNames[i]);
+    values.push_back(parameters[i]);
   }
 
-  FormulaParser formulaParser(&parameterMap);
-
-  TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
-  ModelResultType::iterator signalPos = signal.begin();
-
-  for (TimeGridType::const_iterator gridPos = m_TimeGrid.begin(); gridPos != timeGridEnd;
-       ++gridPos, ++signalPos)
+  std::shared_ptr<const CompiledFormula> formula;
   {
-    parameterMap[GetXName()] = *gridPos;
-    *signalPos = formulaParser.parse(m_FunctionString);
+    std::lock_guard<std::mutex> lock(m_CompiledFunctionMutex);
+    if (!m_CompiledFunction || m_CompiledFunctionString != m_FunctionString || m_CompiledVariableNames != variableNames)
+    {
+      m_CompiledFunction = std::make_shared<const CompiledFormula>(m_FunctionString, variableNames);
+      m_CompiledFunctionString = m_FunctionString;
+      m_CompiledVariableNames = variableNames;
+    }
+    formula = m_CompiledFunction;
   }
 
+  // the variable "x" (index 0) runs over the whole time grid
+  formula->evaluate(values.data(), 0, m_TimeGrid.data_block(), timeSteps, signal.data_block());
+
   return signal;
 };
 
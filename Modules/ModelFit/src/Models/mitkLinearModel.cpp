@@ -78,6 +78,25 @@ mitk::LinearModel::ComputeModelfunction(const ParametersType& parameters) const
   return signal;
 };
 
+bool mitk::LinearModel::HasSignalDerivatives() const
+{
+  return true;
+};
+
+mitk::LinearModel::ModelDerivativeType
+mitk::LinearModel::ComputeModelfunctionDerivatives(const ParametersType& /*parameters*/) const
+{
+  ModelDerivativeType derivatives(2, m_TimeGrid.GetSize());
+
+  for (TimeGridType::size_type i = 0; i < m_TimeGrid.GetSize(); ++i)
+  {
+    derivatives[0][i] = m_TimeGrid[i];
+    derivatives[1][i] = 1.0;
+  }
+
+  return derivatives;
+};
+
 mitk::LinearModel::ParameterNamesType mitk::LinearModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
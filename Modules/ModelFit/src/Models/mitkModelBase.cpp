@@ -146,6 +146,44 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+bool mitk::ModelBase::HasSignalDerivatives() const
+{
+  return false;
+};
+
+mitk::ModelBase::ModelDerivativeType mitk::ModelBase::GetSignalDerivatives(const ParametersType& parameters) const
+{
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model derivatives. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model derivatives. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  ModelDerivativeType derivatives = ComputeModelfunctionDerivatives(parameters);
+
+  if (derivatives.rows() != parameters.size() || derivatives.cols() != m_TimeGrid.GetSize())
+  {
+    itkExceptionMacro("Model derivatives have wrong size. Required size: " << parameters.size() << " x "
+                      << m_TimeGrid.GetSize() << "; computed size: " << derivatives.rows() << " x " << derivatives.cols());
+  }
+
+  return derivatives;
+}
+
+mitk::ModelBase::ModelDerivativeType mitk::ModelBase::ComputeModelfunctionDerivatives(
+  const ParametersType& /*parameters*/) const
+{
+  itkExceptionMacro("Model does not implement the computation of signal derivatives. Check HasSignalDerivatives() before calling GetSignalDerivatives().");
+};
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
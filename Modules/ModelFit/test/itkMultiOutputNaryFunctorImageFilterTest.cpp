@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
 
 #include "itkMultiOutputNaryFunctorImageFilter.h"
 
@@ -214,5 +215,34 @@ int itkMultiOutputNaryFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #4 (functor #2)",0 == out4->GetPixel(testIndex4));
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #5 (functor #2)",0 == out4->GetPixel(testIndex5));
 
+  //Test chunk statistics (only voxels inside the mask are scheduled)
+  itk::SizeValueType maskedVoxels = 0;
+  for (itk::ImageRegionConstIterator<mitk::TestMaskType> pos(mask, mask->GetLargestPossibleRegion()); !pos.IsAtEnd(); ++pos)
+  {
+    if (pos.Get() > 0)
+    {
+      ++maskedVoxels;
+    }
+  }
+
+  testFilter->SetChunkSize(1);
+  testFilter->Update();
+
+  const FilterType::ChunkStatisticsType& statistics = testFilter->GetChunkStatistics();
+  CPPUNIT_ASSERT_MESSAGE("Check number of chunks", maskedVoxels == statistics.size());
+
+  itk::SizeValueType expectedFirstVoxel = 0;
+  for (const auto& chunk : statistics)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Check chunks cover the work list", expectedFirstVoxel == chunk.FirstVoxel);
+    CPPUNIT_ASSERT_MESSAGE("Check chunk size", 1 == chunk.NumberOfVoxels);
+    CPPUNIT_ASSERT_MESSAGE("Check chunk duration", chunk.Duration >= 0.0);
+    expectedFirstVoxel += chunk.NumberOfVoxels;
+  }
+
+  out1 = testFilter->GetOutput(0);
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #2 (chunk size 1)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #4 (chunk size 1)",0 == out1->GetPixel(testIndex4));
+
   MITK_TEST_END()
 }
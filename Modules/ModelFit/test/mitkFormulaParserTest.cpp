@@ -211,6 +211,54 @@ public:
 
     delete parser;
   }
+
+  static void TestCompiledFormula()
+  {
+    CompiledFormula::VariableNamesType names;
+    names.push_back("x");
+    names.push_back("test");
+
+    // same errors as the parser
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("_", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("5=", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("(1+2", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("a", names));
+
+    // compiled formulas have to evaluate to the result of the parser
+    std::map<std::string, double> varMap;
+    varMap["x"] = 0.75;
+    varMap["test"] = 17;
+    FormulaParser parser(&varMap);
+    const double values[] = { 0.75, 17 };
+
+    const char* formulas[] = { "1+2", "-7 + +1 - -1", "(1+2)*(4-2)", "2*test-test", "28/4/2",
+      "3.5 + test * x * sin(x) - 1 / 2", "abs(-x)*exp(1)", "cosd(90) + sind(145) - tand(15)",
+      "fresnelS(x) + fresnelC(-x)", "-(x + test) * -2e-1", "t e s t * x" };
+
+    for (const auto formula : formulas)
+    {
+      double d = 0;
+      TEST_NOTHROW(d = CompiledFormula(formula, names).evaluate(values),
+        "Testing if compiling and evaluating \"" << formula << "\" throws an unwanted exception");
+      MITK_TEST_CONDITION_REQUIRED(d == parser.parse(formula),
+        "Testing if the compiled formula \"" << formula << "\" produces the result of the parser");
+    }
+
+    // evaluation of a whole grid of the variable x
+    const CompiledFormula compiled("test * x * x - x", names);
+    const double grid[] = { -2, -1, 0, 0.5, 3 };
+    double results[5];
+    compiled.evaluate(values, 0, grid, 5, results);
+
+    bool gridIsCorrect = true;
+    for (int i = 0; i < 5; ++i)
+    {
+      gridIsCorrect = gridIsCorrect && results[i] == 17 * grid[i] * grid[i] - grid[i];
+    }
+    MITK_TEST_CONDITION_REQUIRED(gridIsCorrect,
+      "Testing if the evaluation of a grid produces the correct results");
+  }
 };
 
 int mitkFormulaParserTest(int, char *[])
@@ -220,6 +268,7 @@ int mitkFormulaParserTest(int, char *[])
   FormulaParserTests::TestConstructor();
   FormulaParserTests::TestLookupVariable();
   FormulaParserTests::TestParse();
+  FormulaParserTests::TestCompiledFormula();
 
   MITK_TEST_END();
 }
@@ -81,5 +81,15 @@ int mitkLevenbergMarquardtModelFitFunctorTest(int  /*argc*/, char*[] /*argv[]*/)
   MITK_TEST_CONDITION_REQUIRED(mitk::Equal(-5, output[2], 1e-6, true) == true,
                                "Check derived parameter 1 (x-intercept) for sample 2.");
 
+  //Test functor for sample2 with numerical derivatives instead of the derivatives of the linear model
+  CPPUNIT_ASSERT_MESSAGE("Check if model derivatives are used by default.", testFunctor->GetUseModelDerivatives());
+  testFunctor->SetUseModelDerivatives(false);
+  output = testFunctor->Compute(sample2, model, initParams);
+
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2, output[0], 1e-6, true) == true,
+                               "Check fitted parameter 1 (slope) for sample 2 with numerical derivatives.");
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10, output[1], 1e-6, true) == true,
+                               "Check fitted parameter 2 (offset) for sample 2 with numerical derivatives.");
+
   MITK_TEST_END()
 }
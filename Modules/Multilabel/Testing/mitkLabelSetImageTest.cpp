@@ -11,6 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
@@ -37,12 +39,36 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestEraseLabels);
   MITK_TEST(TestMergeLabels);
+  MITK_TEST(TestMergeLabelsOfInactiveLayer);
+  MITK_TEST(TestMergeAndEraseMaximumLabelValue);
   MITK_TEST(TestCreateLabelMask);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
+  void AddLabel(unsigned int layer, mitk::Label::PixelType value)
+  {
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetName("Label" + std::to_string(value));
+    label->SetValue(value);
+    m_LabelSetImage->GetLabelSet(layer)->AddLabel(label);
+  }
+
+  static void SetPixel(mitk::Image *image, itk::IndexValueType x, mitk::Label::PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    itk::Index<3> index = { { x, 0, 0 } };
+    accessor.SetPixelByIndex(index, value);
+  }
+
+  static mitk::Label::PixelType GetPixel(const mitk::Image *image, itk::IndexValueType x)
+  {
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(image);
+    itk::Index<3> index = { { x, 0, 0 } };
+    return accessor.GetPixelByIndex(index);
+  }
+
 public:
   void setUp() override
   {
@@ -488,6 +514,44 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Labels were not correctly merged", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 5366);
   }
 
+  void TestMergeLabelsOfInactiveLayer()
+  {
+    this->AddLabel(0, 5);
+    this->AddLabel(0, 6);
+    SetPixel(m_LabelSetImage, 0, 5);
+    SetPixel(m_LabelSetImage, 1, 6);
+
+    // the new layer gets active, layer 0 is only kept in the layer container
+    m_LabelSetImage->AddLayer();
+    CPPUNIT_ASSERT_MESSAGE("Wrong active layer", m_LabelSetImage->GetActiveLayer() == 1);
+    SetPixel(m_LabelSetImage, 1, 6);
+
+    m_LabelSetImage->MergeLabels(5, { 6 }, 0);
+
+    CPPUNIT_ASSERT_MESSAGE("Label of the passed layer was not merged", GetPixel(m_LabelSetImage->GetLayerImage(0), 1) == 5);
+    CPPUNIT_ASSERT_MESSAGE("Target label of the passed layer was changed", GetPixel(m_LabelSetImage->GetLayerImage(0), 0) == 5);
+    CPPUNIT_ASSERT_MESSAGE("Active layer was changed by merging another layer", GetPixel(m_LabelSetImage, 1) == 6);
+  }
+
+  void TestMergeAndEraseMaximumLabelValue()
+  {
+    const auto maxValue = mitk::Label::MAX_LABEL_VALUE;
+    this->AddLabel(0, 1);
+    this->AddLabel(0, maxValue);
+    CPPUNIT_ASSERT_MESSAGE("Label with the maximum value does not exist", m_LabelSetImage->ExistLabel(maxValue) == true);
+
+    SetPixel(m_LabelSetImage, 0, maxValue);
+    SetPixel(m_LabelSetImage, 1, 1);
+    m_LabelSetImage->MergeLabel(1, maxValue);
+    CPPUNIT_ASSERT_MESSAGE("Label with the maximum value was not merged", GetPixel(m_LabelSetImage, 0) == 1);
+    CPPUNIT_ASSERT_MESSAGE("Target label was changed", GetPixel(m_LabelSetImage, 1) == 1);
+
+    SetPixel(m_LabelSetImage, 0, maxValue);
+    m_LabelSetImage->EraseLabel(maxValue);
+    CPPUNIT_ASSERT_MESSAGE("Label with the maximum value was not erased", GetPixel(m_LabelSetImage, 0) == 0);
+    CPPUNIT_ASSERT_MESSAGE("Other label was erased", GetPixel(m_LabelSetImage, 1) == 1);
+  }
+
   void TestCreateLabelMask()
   {
     mitk::Image::Pointer image =
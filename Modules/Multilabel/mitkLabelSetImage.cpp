@@ -28,6 +28,7 @@ found in the LICENSE file.
 #include <vtkTransformPolyDataFilter.h>
 
 #include <itkImageRegionIterator.h>
+#include <itkMultiThreaderBase.h>
 #include <itkQuadEdgeMesh.h>
 #include <itkTriangleMeshToBinaryImageFilter.h>
 #include <itkLabelGeometryImageFilter.h>
@@ -37,6 +38,10 @@ found in the LICENSE file.
 
 #include <itkBinaryFunctorImageFilter.h>
 
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+
 
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
@@ -470,35 +475,24 @@ bool mitk::LabelSetImage::ExistLabelSet(unsigned int layer) const
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue, unsigned int layer)
 {
-  try
-  {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
-  GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  this->m_LabelModifiedMessage.Send(sourcePixelValue);
-  this->m_LabelModifiedMessage.Send(pixelValue);
-  this->m_LabelsChangedMessage.Send({ sourcePixelValue, pixelValue });
-  Modified();
+  this->MergeLabels(pixelValue, { sourcePixelValue }, layer);
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, const std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
-  try
+  LabelValueMappingType mapping;
+  for (const auto sourcePixelValue : vectorOfSourcePixelValues)
   {
-    for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
-    {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
-      this->m_LabelModifiedMessage.Send(vectorOfSourcePixelValues[idx]);
-    }
+    mapping.emplace(sourcePixelValue, pixelValue);
   }
-  catch (itk::ExceptionObject &e)
+
+  this->RemapLabelValues(layer, mapping);
+
+  for (const auto sourcePixelValue : vectorOfSourcePixelValues)
   {
-    mitkThrow() << e.GetDescription();
+    this->m_LabelModifiedMessage.Send(sourcePixelValue);
   }
+
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   this->m_LabelModifiedMessage.Send(pixelValue);
   auto modifiedValues = vectorOfSourcePixelValues;
@@ -532,39 +526,65 @@ void mitk::LabelSetImage::RemoveLabels(const std::vector<PixelType>& VectorOfLab
 
 void mitk::LabelSetImage::EraseLabel(PixelType pixelValue)
 {
-  try
+  this->EraseLabels({ pixelValue });
+}
+
+void mitk::LabelSetImage::EraseLabels(const std::vector<PixelType>& VectorOfLabelPixelValues)
+{
+  // erase all labels of a group in one pass over the group image
+  std::map<GroupIndexType, LabelValueMappingType> mappingPerGroup;
+  for (const auto pixelValue : VectorOfLabelPixelValues)
+  {
+    mappingPerGroup[this->GetGroupIndexOfLabel(pixelValue)].emplace(pixelValue, 0);
+  }
+
+  for (const auto& groupMapping : mappingPerGroup)
+  {
+    this->RemapLabelValues(groupMapping.first, groupMapping.second);
+  }
+
+  for (const auto pixelValue : VectorOfLabelPixelValues)
+  {
+    this->m_LabelModifiedMessage.Send(pixelValue);
+  }
+  this->m_LabelsChangedMessage.Send(VectorOfLabelPixelValues);
+  Modified();
+}
+
+void mitk::LabelSetImage::RemapLabelValues(unsigned int layer, const LabelValueMappingType& mapping)
+{
+  if (mapping.empty())
+    return;
+
+  // dense lookup table covering all remapped values; values beyond it stay untouched
+  std::vector<PixelType> lookupTable(static_cast<std::size_t>(mapping.rbegin()->first) + 1);
+  std::iota(lookupTable.begin(), lookupTable.end(), PixelType(0));
+  for (const auto& entry : mapping)
   {
-    auto groupID = this->GetGroupIndexOfLabel(pixelValue);
+    lookupTable[entry.first] = entry.second;
+  }
 
-    mitk::Image* groupImage = this->GetActiveLayer() != groupID
-       ? this->GetLayerImage(groupID)
-       : this;
+  mitk::Image* groupImage = this->GetActiveLayer() != layer
+    ? this->GetLayerImage(layer)
+    : this;
 
+  try
+  {
+    // label values are integral, floating point pixel values would be truncated by the lookup
     if (4 == this->GetDimension())
     {
-      AccessFixedDimensionByItk_1(groupImage, EraseLabelProcessing, 4, pixelValue);
+      AccessFixedTypeByItk_1(
+        groupImage, RemapLabelValuesProcessing, MITK_ACCESSBYITK_INTEGRAL_PIXEL_TYPES_SEQ, (4), lookupTable);
     }
     else
     {
-      AccessByItk_1(groupImage, EraseLabelProcessing, pixelValue);
+      AccessIntegralPixelTypeByItk_n(groupImage, RemapLabelValuesProcessing, (lookupTable));
     }
   }
   catch (const itk::ExceptionObject& e)
   {
     mitkThrow() << e.GetDescription();
   }
-
-  this->m_LabelModifiedMessage.Send(pixelValue);
-  this->m_LabelsChangedMessage.Send({ pixelValue });
-  Modified();
-}
-
-void mitk::LabelSetImage::EraseLabels(const std::vector<PixelType>& VectorOfLabelPixelValues)
-{
-  for (unsigned int idx = 0; idx < VectorOfLabelPixelValues.size(); idx++)
-  {
-    this->EraseLabel(VectorOfLabelPixelValues[idx]);
-  }
 }
 
 mitk::Label *mitk::LabelSetImage::GetActiveLabel(unsigned int layer)
@@ -938,41 +958,45 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VIm
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue)
+void mitk::LabelSetImage::RemapLabelValuesProcessing(ImageType *itkImage, const std::vector<PixelType>& lookupTable)
 {
   typedef itk::ImageRegionIterator<ImageType> IteratorType;
+  typedef typename ImageType::PixelType ImagePixelType;
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
+  static_assert(std::is_integral<ImagePixelType>::value, "Label values can only be remapped in integral images");
 
-  while (!iter.IsAtEnd())
-  {
-    PixelType value = iter.Get();
+  // compared in 64 bit, the size exceeds the range of the pixel type if the table contains its maximum value
+  const std::uint64_t lookupTableSize = lookupTable.size();
 
-    if (value == pixelValue)
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->template ParallelizeImageRegion<ImageType::ImageDimension>(
+    itkImage->GetLargestPossibleRegion(),
+    [itkImage, &lookupTable, lookupTableSize](const typename ImageType::RegionType& region)
     {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
+      IteratorType iter(itkImage, region);
 
-template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
+      for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+      {
+        const ImagePixelType value = iter.Get();
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
+        if constexpr (std::is_signed<ImagePixelType>::value)
+        {
+          if (value < 0)
+            continue;
+        }
 
-  while (!iter.IsAtEnd())
-  {
-    if (iter.Get() == index)
-    {
-      iter.Set(pixelValue);
-    }
-    ++iter;
-  }
+        if (static_cast<std::uint64_t>(value) < lookupTableSize)
+        {
+          const auto mappedValue = static_cast<ImagePixelType>(lookupTable[static_cast<std::size_t>(value)]);
+
+          if (mappedValue != value)
+          {
+            iter.Set(mappedValue);
+          }
+        }
+      }
+    },
+    nullptr);
 }
 
 
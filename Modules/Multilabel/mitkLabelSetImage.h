@@ -509,11 +509,14 @@ namespace mitk
     template <typename ImageType>
     void ClearBufferProcessing(ImageType *input);
 
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index);
+    /** Maps the pixel values of all keys to their respective values.*/
+    using LabelValueMappingType = std::map<PixelType, PixelType>;
+
+    /** Applies the mapping to the image of the passed layer (all time steps) in one multi-threaded pass.*/
+    void RemapLabelValues(unsigned int layer, const LabelValueMappingType& mapping);
 
     template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
+    void RemapLabelValuesProcessing(ImageType *input, const std::vector<PixelType>& lookupTable);
 
     template <typename ImageType>
     void MaskStampProcessing(ImageType *input, mitk::Image *mask, bool forceOverwrite);
@@ -15,8 +15,12 @@ found in the LICENSE file.
 
 #include "MitkPharmacokineticsExports.h"
 #include "mitkModelBase.h"
+#include "mitkAIFConvolution.h"
 #include "itkArray2D.h"
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
 
@@ -74,6 +78,17 @@ namespace mitk
      * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
+    /** Returns the convolution engine for the AIF matching the time grid of the model
+     * (see GetAterialInputFunction()). It is created on first use and recreated if the model was modified
+     * since then (e.g. new AIF or time grid). Models should use it instead of convoluteAIFWithExponential(),
+     * because the AIF dependent terms are only computed once.*/
+    std::shared_ptr<const AIFConvolution> GetAIFConvolution() const;
+
+    /** Lets the model use a convolution engine that was created for the same AIF and time grid, e.g. by
+     * another instance of the model. AIFBasedModelParameterizerBase uses it to share one engine between
+     * all models it generates for a fit. The engine is dropped as soon as the model is modified.*/
+    void SetAIFConvolution(std::shared_ptr<const AIFConvolution> convolution);
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
@@ -100,8 +115,11 @@ namespace mitk
     TimeGridType m_AterialInputFunctionTimeGrid;
     AterialInputFunctionType m_AterialInputFunctionValues;
 
-
   private:
+    mutable std::shared_ptr<const AIFConvolution> m_AIFConvolution;
+    /** Modification time of the model the convolution engine is valid for.*/
+    mutable itk::ModifiedTimeType m_AIFConvolutionTime;
+    mutable std::mutex m_AIFConvolutionMutex;
 
 
     //No copy constructor allowed
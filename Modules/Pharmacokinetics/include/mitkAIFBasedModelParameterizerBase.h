@@ -16,6 +16,9 @@ found in the LICENSE file.
 #include "mitkAIFParametrizerHelper.h"
 #include "mitkAIFBasedModelBase.h"
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
   /** Base class for model parameterizers for Models using an Aterial Input Function
@@ -67,12 +70,66 @@ namespace mitk
       return result;
     };
 
+    /** Generates the model like the superclass. If the AIF is a global static parameter (which is the default),
+     * all generated models share the AIF convolution engine (see AIFBasedModelBase::GetAIFConvolution()),
+     * so the AIF dependent terms are only computed once for all voxels of a fit.*/
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override
+    {
+      ModelBasePointer model = Superclass::GenerateParameterizedModel(currentPosition);
+
+      StaticParameterMapType locals = this->GetLocalStaticParameters(currentPosition);
+      if (locals.find(ModelType::NAME_STATIC_PARAMETER_AIF) == locals.end() &&
+          locals.find(ModelType::NAME_STATIC_PARAMETER_AIFTimeGrid) == locals.end())
+      {
+        this->ShareAIFConvolution(model);
+      }
+
+      return model;
+    };
+
+    ModelBasePointer GenerateParameterizedModel() const override
+    {
+      ModelBasePointer model = Superclass::GenerateParameterizedModel();
+      this->ShareAIFConvolution(model);
+      return model;
+    };
+
 
   protected:
 
-    AIFBasedModelParameterizerBase()
+    AIFBasedModelParameterizerBase() : m_AIFConvolutionTime(0)
     {};
 
+    /** Sets the AIF convolution engine of the parameterizer to the passed model. The engine is created
+     * by the first model and recreated if the parameterizer was modified since then.*/
+    void ShareAIFConvolution(ModelBaseType* model) const
+    {
+      auto aifModel = dynamic_cast<AIFBasedModelBase*>(model);
+      if (!aifModel)
+      {
+        return;
+      }
+
+      std::shared_ptr<const AIFConvolution> convolution;
+      try
+      {
+        std::lock_guard<std::mutex> lock(m_AIFConvolutionMutex);
+        if (!m_AIFConvolution || this->GetMTime() > m_AIFConvolutionTime)
+        {
+          m_AIFConvolution = aifModel->GetAIFConvolution();
+          m_AIFConvolutionTime = this->GetMTime();
+        }
+        convolution = m_AIFConvolution;
+      }
+      catch (const std::exception&)
+      {
+        //the AIF settings are invalid; the model reports that when it is evaluated
+        return;
+      }
+
+      aifModel->SetAIFConvolution(convolution);
+    };
+
     ~AIFBasedModelParameterizerBase() override
     {};
 
@@ -82,6 +139,10 @@ namespace mitk
 
 
   private:
+    mutable std::shared_ptr<const AIFConvolution> m_AIFConvolution;
+    /** Modification time of the parameterizer the convolution engine is valid for.*/
+    mutable itk::ModifiedTimeType m_AIFConvolutionTime;
+    mutable std::mutex m_AIFConvolutionMutex;
 
     //No copy constructor allowed
     AIFBasedModelParameterizerBase(const Self& source);
@@ -0,0 +1,69 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAIFConvolution_h
+#define mitkAIFConvolution_h
+
+#include <cstddef>
+#include <vector>
+
+#include "mitkModelBase.h"
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** @class AIFConvolution
+   * @brief Convolves an aterial input function (AIF) with exponential residue functions R(t) = exp(-lambda*t).
+   * It uses the same iterative formula as convoluteAIFWithExponential() (linear interpolation of the AIF
+   * between the sampling points), but precomputes all terms that only depend on the AIF and the time grid
+   * once in the constructor. The convolution for many values of lambda can then be computed with one call
+   * into a contiguous buffer without any allocation.\n
+   * Instances are immutable and can be shared between models and threads (see AIFBasedModelBase::GetAIFConvolution()).*/
+  class MITKPHARMACOKINETICS_EXPORT AIFConvolution
+  {
+  public:
+    typedef ModelBase::TimeGridType TimeGridType;
+    typedef itk::Array<double> AterialInputFunctionType;
+
+    /** @param timeGrid The time grid of the convolution.
+     * @param aif The AIF sampled at the time points of timeGrid.
+     * @pre aif must have the same size as timeGrid.*/
+    AIFConvolution(const TimeGridType& timeGrid, const AterialInputFunctionType& aif);
+
+    const TimeGridType& GetTimeGrid() const { return m_TimeGrid; }
+    const AterialInputFunctionType& GetAterialInputFunction() const { return m_AterialInputFunction; }
+    std::size_t GetNumberOfTimePoints() const { return m_TimeGrid.GetSize(); }
+
+    /** Convolves the AIF with exp(-lambda*t) for each of the count values in lambdas.
+     * The buffers are time point major: the result for lambdas[k] at time point i is stored at
+     * [i * count + k], so the inner loop over the lambdas runs over contiguous memory.
+     * @param lambdas count values of lambda. Must not be 0.
+     * @param count Number of values in lambdas.
+     * @param [out] convolutions Buffer for GetNumberOfTimePoints() * count results.
+     * @param [out] derivatives Optional buffer for GetNumberOfTimePoints() * count derivatives of the
+     * convolutions with respect to lambda. They are the exact derivatives of the iterative formula.*/
+    void ConvoluteWithExponential(const double* lambdas, std::size_t count, double* convolutions,
+                                  double* derivatives = nullptr) const;
+
+  private:
+    TimeGridType m_TimeGrid;
+    AterialInputFunctionType m_AterialInputFunction;
+
+    /** Per interval [t_i, t_i+1]: its length, the slope of the AIF and the AIF extrapolated to t = 0.*/
+    std::vector<double> m_IntervalLengths;
+    std::vector<double> m_Slopes;
+    std::vector<double> m_Intercepts;
+  };
+}
+
+#endif
@@ -32,7 +32,7 @@ namespace  mitk {
 
 
     /** @brief Function that wraps the kernel */
-inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
+inline    itk::Array<double> wrap1d(const itk::Array<double>& kernel)
         {
             int dim = kernel.GetNumberOfElements();
             itk::Array<double> wrappedKernel(dim);
@@ -51,7 +51,7 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
      * \remark dim = Dimensions of padded image --> PaddedDimension
      * \remark m dimensions of larger image
      * \remark n dimensions of image to be padded --> InitialDimension*/
-   inline  itk::Array<double> zeropadding1d(itk::Array<double> unpaddedSpectrum, int paddedDimension)
+   inline  itk::Array<double> zeropadding1d(const itk::Array<double>& unpaddedSpectrum, int paddedDimension)
         {
 
             int initialDimension = unpaddedSpectrum.GetNumberOfElements();
@@ -73,7 +73,7 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
 
      /** @brief Follow up function after back transformation from fourier space bwd_transform.
       * removes padding and scales (transformed values have to be divided by transformation dimensions) */
-  inline  itk::Array<double> unpadAndScale(itk::Array<double> convolutionResult, int initialDimension)
+  inline  itk::Array<double> unpadAndScale(const itk::Array<double>& convolutionResult, int initialDimension)
         {
             int transformationDimension = convolutionResult.size();
             unsigned int padding = transformationDimension - initialDimension;
@@ -105,7 +105,7 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
 
     }
 
-  inline itk::Array<double> convoluteAIFWithExponential(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double lambda)
+  inline itk::Array<double> convoluteAIFWithExponential(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda)
   {
       /** @brief Iterative Formula to Convolve aif(t) with an exponential Residuefunction R(t) = exp(lambda*t)
        **/
@@ -129,7 +129,7 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
   }
 
 
-  inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
+  inline itk::Array<double> convoluteAIFWithConstant(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double constant)
   {
       /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
        **/
@@ -71,6 +71,8 @@ namespace mitk
     ParametersSizeType  GetNumberOfDerivedParameters() const override;
     ParamterUnitMapType GetDerivedParameterUnits() const override;
 
+    bool HasSignalDerivatives() const override;
+
 
   protected:
     ExtendedToftsModel();
@@ -84,6 +86,10 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Derivatives of the signal with respect to the parameters. They are computed from the exact
+     * derivative of the convolution with respect to kep (see AIFConvolution).*/
+    ModelDerivativeType ComputeModelfunctionDerivatives(const ParametersType& parameters) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAIFConvolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <mitkExceptionMacro.h>
+
+mitk::AIFConvolution::AIFConvolution(const TimeGridType& timeGrid, const AterialInputFunctionType& aif)
+  : m_TimeGrid(timeGrid), m_AterialInputFunction(aif)
+{
+  if (timeGrid.GetSize() != aif.GetSize())
+  {
+    mitkThrow() << "Cannot convolve AIF. Size of AIF and time grid differ. AIF size: " << aif.GetSize()
+                << "; time grid size: " << timeGrid.GetSize();
+  }
+
+  const std::size_t intervals = timeGrid.GetSize() > 0 ? timeGrid.GetSize() - 1 : 0;
+  m_IntervalLengths.resize(intervals);
+  m_Slopes.resize(intervals);
+  m_Intercepts.resize(intervals);
+
+  for (std::size_t i = 0; i < intervals; ++i)
+  {
+    m_IntervalLengths[i] = timeGrid(i + 1) - timeGrid(i);
+    m_Slopes[i] = (aif(i + 1) - aif(i)) / m_IntervalLengths[i];
+    m_Intercepts[i] = aif(i) - m_Slopes[i] * timeGrid(i);
+  }
+}
+
+void mitk::AIFConvolution::ConvoluteWithExponential(const double* lambdas,
+                                                    std::size_t count,
+                                                    double* convolutions,
+                                                    double* derivatives) const
+{
+  const std::size_t timeSteps = m_TimeGrid.GetSize();
+
+  if (0 == timeSteps || 0 == count)
+  {
+    return;
+  }
+
+  std::fill(convolutions, convolutions + count, 0.0);
+
+  if (nullptr != derivatives)
+  {
+    std::fill(derivatives, derivatives + count, 0.0);
+  }
+
+  for (std::size_t i = 0; i + 1 < timeSteps; ++i)
+  {
+    const double dt = m_IntervalLengths[i];
+    const double m = m_Slopes[i];
+    const double a = m_Intercepts[i];
+    const double t0 = m_TimeGrid(i);
+    const double t1 = m_TimeGrid(i + 1);
+
+    const double* previous = convolutions + i * count;
+    double* current = convolutions + (i + 1) * count;
+
+    if (nullptr == derivatives)
+    {
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        const double lambda = lambdas[k];
+        const double edt = std::exp(-lambda * dt);
+
+        current[k] = edt * previous[k] + a / lambda * (1 - edt) +
+                     m / (lambda * lambda) * ((lambda * t1 - 1) - edt * (lambda * t0 - 1));
+      }
+    }
+    else
+    {
+      const double* previousDerivative = derivatives + i * count;
+      double* currentDerivative = derivatives + (i + 1) * count;
+
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        const double lambda = lambdas[k];
+        const double lambda2 = lambda * lambda;
+        const double lambda3 = lambda2 * lambda;
+        const double edt = std::exp(-lambda * dt);
+
+        current[k] = edt * previous[k] + a / lambda * (1 - edt) +
+                     m / lambda2 * ((lambda * t1 - 1) - edt * (lambda * t0 - 1));
+
+        // d edt / d lambda = -dt * edt
+        currentDerivative[k] = edt * previousDerivative[k] - dt * edt * previous[k] +
+                               a * (dt * edt / lambda - (1 - edt) / lambda2) - m * t1 / lambda2 + 2 * m / lambda3 +
+                               m * t0 * edt * (dt / lambda + 1 / lambda2) - m * edt * (dt / lambda2 + 2 / lambda3);
+      }
+    }
+  }
+}
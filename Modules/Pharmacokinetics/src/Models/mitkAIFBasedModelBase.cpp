@@ -46,7 +46,7 @@ std::string mitk::AIFBasedModelBase::GetYAxisUnit() const
   return "";
 }
 
-mitk::AIFBasedModelBase::AIFBasedModelBase()
+mitk::AIFBasedModelBase::AIFBasedModelBase() : m_AIFConvolutionTime(0)
 {
 }
 
@@ -81,6 +81,32 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+std::shared_ptr<const mitk::AIFConvolution> mitk::AIFBasedModelBase::GetAIFConvolution() const
+{
+  std::lock_guard<std::mutex> lock(m_AIFConvolutionMutex);
+
+  if (!m_AIFConvolution || this->GetMTime() > m_AIFConvolutionTime)
+  {
+    m_AIFConvolution = std::make_shared<const AIFConvolution>(m_TimeGrid, GetAterialInputFunction(m_TimeGrid));
+    m_AIFConvolutionTime = this->GetMTime();
+  }
+
+  return m_AIFConvolution;
+}
+
+void mitk::AIFBasedModelBase::SetAIFConvolution(std::shared_ptr<const AIFConvolution> convolution)
+{
+  if (convolution && convolution->GetNumberOfTimePoints() != m_TimeGrid.GetSize())
+  {
+    itkExceptionMacro("AIF convolution does not match the time grid of the model. Number of time points: "
+                      << convolution->GetNumberOfTimePoints() << "; time grid size: " << m_TimeGrid.GetSize());
+  }
+
+  std::lock_guard<std::mutex> lock(m_AIFConvolutionMutex);
+  m_AIFConvolution = convolution;
+  m_AIFConvolutionTime = this->GetMTime();
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -11,7 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkExtendedOneTissueCompartmentModel.h"
-#include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
 #include <fstream>
 
@@ -88,11 +87,6 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
-
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
   //Model Parameters
@@ -100,23 +94,19 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
   double     k2 = (double) parameters[POSITION_PARAMETER_k2] / 60.0;
   double     VB = parameters[POSITION_PARAMETER_VB];
 
-
-
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  std::shared_ptr<const AIFConvolution> convolution = this->GetAIFConvolution();
+  const AterialInputFunctionType& aterialInputFunction = convolution->GetAterialInputFunction();
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
+  convolution->ConvoluteWithExponential(&k2, 1, signal.data_block());
 
   AterialInputFunctionType::const_iterator aifPos = aterialInputFunction.begin();
 
-
-  for (mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin(); res != convolution.end(); ++res, ++signalPos, ++aifPos)
+  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos != signal.end(); ++signalPos, ++aifPos)
   {
-    *signalPos = VB * (*aifPos) + (1 - VB) * K1 * (*res);
+    *signalPos = VB * (*aifPos) + (1 - VB) * K1 * (*signalPos);
   }
 
   return signal;
@@ -11,7 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkExtendedToftsModel.h"
-#include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
 #include <fstream>
 
@@ -113,11 +112,6 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
-
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
   //Model Parameters
@@ -133,21 +127,20 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  std::shared_ptr<const AIFConvolution> convolution = this->GetAIFConvolution();
+  const AterialInputFunctionType& aterialInputFunction = convolution->GetAterialInputFunction();
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
+  convolution->ConvoluteWithExponential(&lambda, 1, signal.data_block());
 
+  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
-       Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
+       Cp != aterialInputFunction.end(); ++signalPos, ++Cp)
   {
-    *signalPos = (*Cp) * vp + ktrans * (*res);
+    *signalPos = (*Cp) * vp + ktrans * (*signalPos);
   }
 
   return signal;
@@ -155,6 +148,52 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 }
 
 
+bool mitk::ExtendedToftsModel::HasSignalDerivatives() const
+{
+  return true;
+};
+
+mitk::ExtendedToftsModel::ModelDerivativeType mitk::ExtendedToftsModel::ComputeModelfunctionDerivatives(
+  const ParametersType& parameters) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal Derivatives");
+  }
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  //Model Parameters
+  double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  double     ve = parameters[POSITION_PARAMETER_ve];
+
+  if (ve == 0.0)
+  {
+    itkExceptionMacro("ve is 0! Cannot calculate signal derivatives");
+  }
+
+  double lambda =  ktrans / ve;
+
+  std::shared_ptr<const AIFConvolution> aifConvolution = this->GetAIFConvolution();
+  const AterialInputFunctionType& aterialInputFunction = aifConvolution->GetAterialInputFunction();
+
+  mitk::ModelBase::ModelResultType convolution(timeSteps);
+  mitk::ModelBase::ModelResultType convolutionDerivative(timeSteps);
+  aifConvolution->ConvoluteWithExponential(&lambda, 1, convolution.data_block(), convolutionDerivative.data_block());
+
+  //signal = ktrans * convolution(lambda) + vp * Cp with lambda = ktrans / ve
+  ModelDerivativeType derivatives(NUMBER_OF_PARAMETERS, timeSteps);
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    derivatives[POSITION_PARAMETER_Ktrans][i] = (convolution[i] + lambda * convolutionDerivative[i]) / 6000.0;
+    derivatives[POSITION_PARAMETER_ve][i] = -ktrans * lambda / ve * convolutionDerivative[i];
+    derivatives[POSITION_PARAMETER_vp][i] = aterialInputFunction[i];
+  }
+
+  return derivatives;
+};
+
 mitk::ModelBase::DerivedParameterMapType mitk::ExtendedToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
@@ -11,7 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkOneTissueCompartmentModel.h"
-#include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
 #include <fstream>
 
@@ -84,33 +83,20 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
-
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
   //Model Parameters
   double     K1 = (double) parameters[POSITION_PARAMETER_k1] / 60.0;
   double     k2 = (double) parameters[POSITION_PARAMETER_k2] / 60.0;
 
-
-
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
-
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-
 
+  this->GetAIFConvolution()->ConvoluteWithExponential(&k2, 1, signal.data_block());
 
-  for (mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin(); res != convolution.end(); ++res, ++signalPos)
+  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos != signal.end(); ++signalPos)
   {
-    *signalPos = K1 * (*res);
+    *signalPos *= K1;
   }
 
   return signal;
@@ -11,7 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkStandardToftsModel.h"
-#include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
 #include <fstream>
 
@@ -105,11 +104,6 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
-
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
   //Model Parameters
@@ -119,21 +113,14 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
-
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
+  this->GetAIFConvolution()->ConvoluteWithExponential(&lambda, 1, signal.data_block());
 
-
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
-       Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
+  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos != signal.end(); ++signalPos)
   {
-    *signalPos = ktrans * (*res);
+    *signalPos *= ktrans;
   }
 
   return signal;
@@ -141,6 +128,44 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 }
 
 
+bool mitk::StandardToftsModel::HasSignalDerivatives() const
+{
+  return true;
+};
+
+mitk::StandardToftsModel::ModelDerivativeType mitk::StandardToftsModel::ComputeModelfunctionDerivatives(
+  const ParametersType& parameters) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal Derivatives");
+  }
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  //Model Parameters
+  double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  double     ve = parameters[POSITION_PARAMETER_ve];
+
+  double lambda =  ktrans / ve;
+
+  mitk::ModelBase::ModelResultType convolution(timeSteps);
+  mitk::ModelBase::ModelResultType convolutionDerivative(timeSteps);
+  this->GetAIFConvolution()->ConvoluteWithExponential(&lambda, 1, convolution.data_block(),
+    convolutionDerivative.data_block());
+
+  //signal = ktrans * convolution(lambda) with lambda = ktrans / ve
+  ModelDerivativeType derivatives(NUMBER_OF_PARAMETERS, timeSteps);
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    derivatives[POSITION_PARAMETER_Ktrans][i] = (convolution[i] + lambda * convolutionDerivative[i]) / 6000.0;
+    derivatives[POSITION_PARAMETER_ve][i] = -ktrans * lambda / ve * convolutionDerivative[i];
+  }
+
+  return derivatives;
+};
+
 mitk::ModelBase::DerivedParameterMapType mitk::StandardToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
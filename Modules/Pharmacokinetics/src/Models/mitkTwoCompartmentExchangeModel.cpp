@@ -11,8 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkTwoCompartmentExchangeModel.h"
-#include "mitkConvolutionHelper.h"
 #include <fstream>
+#include <vector>
 
 const std::string mitk::TwoCompartmentExchangeModel::MODEL_DISPLAY_NAME =
  "Two Compartment Exchange Model";
@@ -96,15 +96,12 @@ mitk::TwoCompartmentExchangeModel::GetParameterUnits() const
 mitk::TwoCompartmentExchangeModel::ModelResultType
 mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& parameters) const
 {
-    typedef mitk::ModelBase::ModelResultType ConvolutionResultType;
-
     if (this->m_TimeGrid.GetSize() == 0)
     {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
     }
 
-    AterialInputFunctionType aterialInputFunction;
-    aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+    std::shared_ptr<const AIFConvolution> convolution = this->GetAIFConvolution();
 
     unsigned int timeSteps = this->m_TimeGrid.GetSize();
     mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -129,17 +126,16 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
 
 
 
-        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Km);
+        //both convolutions in one pass; exps[2*i] and exps[2*i+1] are the convolutions with Kp and Km at time point i
+        const double lambdas[2] = { Kp, Km };
+        std::vector<double> exps(2 * timeSteps);
+        convolution->ConvoluteWithExponential(lambdas, 2, exps.data());
 
         //Signal that will be returned by ComputeModelFunction
 
-        mitk::ModelBase::ModelResultType::const_iterator exppPos = expp.begin();
-        mitk::ModelBase::ModelResultType::const_iterator expmPos = expm.begin();
-
-        for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++exppPos,++expmPos, ++signalPos)
+        for (unsigned int i = 0; i < timeSteps; ++i)
         {
-            *signalPos = F * ( *exppPos + E*(*expmPos - *exppPos) );
+            signal[i] = F * ( exps[2 * i] + E*(exps[2 * i + 1] - exps[2 * i]) );
         }
     }
 
@@ -147,12 +143,11 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     else
     {
         double Kp = F/vp;
-        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        mitk::ModelBase::ModelResultType::const_iterator expPos = exp.begin();
+        convolution->ConvoluteWithExponential(&Kp, 1, signal.data_block());
 
-        for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++expPos, ++signalPos)
+        for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++signalPos)
         {
-            *signalPos = F * ( *expPos );
+            *signalPos *= F;
         }
 
     }
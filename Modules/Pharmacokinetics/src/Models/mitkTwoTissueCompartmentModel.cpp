@@ -11,8 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkTwoTissueCompartmentModel.h"
-#include "mitkConvolutionHelper.h"
 #include <fstream>
+#include <vector>
 const std::string mitk::TwoTissueCompartmentModel::MODEL_DISPLAY_NAME = "Two Tissue Compartment Model";
 
 const std::string mitk::TwoTissueCompartmentModel::NAME_PARAMETER_K1 = "K1";
@@ -103,9 +103,8 @@ mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& para
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
+  std::shared_ptr<const AIFConvolution> convolution = this->GetAIFConvolution();
+  const AterialInputFunctionType& aterialInputFunction = convolution->GetAterialInputFunction();
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
@@ -121,28 +120,20 @@ mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& para
   double alpha1 = 0.5 * ((k2 + k3 + k4) - sqrt(square(k2 + k3 + k4) - 4 * k2 * k4));
   double alpha2 = 0.5 * ((k2 + k3 + k4) + sqrt(square(k2 + k3 + k4) - 4 * k2 * k4));
 
-  //double lambda1 = -alpha1;
-  //double lambda2 = -alpha2;
-  mitk::ModelBase::ModelResultType exp1 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha1);
-  mitk::ModelBase::ModelResultType exp2 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha2);
+  //both convolutions in one pass; exps[2*i] and exps[2*i+1] are the convolutions with alpha1 and alpha2 at time point i
+  const double alphas[2] = { alpha1, alpha2 };
+  std::vector<double> exps(2 * timeSteps);
+  convolution->ConvoluteWithExponential(alphas, 2, exps.data());
 
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::const_iterator exp1Pos = exp1.begin();
-  mitk::ModelBase::ModelResultType::const_iterator exp2Pos = exp2.begin();
-  AterialInputFunctionType::const_iterator aifPos = aterialInputFunction.begin();
 
-  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-       signalPos != signal.end(); ++exp1Pos, ++exp2Pos, ++signalPos, ++aifPos)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    double Ci = k1 / (alpha2 - alpha1) * ((k4 - alpha1 + k3) * (*exp1Pos) + (alpha2 - k4 - k3) *
-                                          (*exp2Pos));
-    *signalPos = VB * (*aifPos) + (1 - VB) * Ci;
+    double Ci = k1 / (alpha2 - alpha1) * ((k4 - alpha1 + k3) * exps[2 * i] + (alpha2 - k4 - k3) *
+                                          exps[2 * i + 1]);
+    signal[i] = VB * aterialInputFunction[i] + (1 - VB) * Ci;
   }
 
   return signal;
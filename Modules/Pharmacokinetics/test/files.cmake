@@ -4,4 +4,5 @@ SET(MODULE_TESTS
   #ConvertToConcentrationTest.cpp
   mitkTwoCompartmentExchangeModelTest.cpp
   mitkExtendedToftsModelTest.cpp
+  mitkAIFConvolutionTest.cpp
 )
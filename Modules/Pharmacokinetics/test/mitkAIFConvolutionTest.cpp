@@ -0,0 +1,145 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkVector.h"
+#include "mitkAIFConvolution.h"
+#include "mitkConvolutionHelper.h"
+#include "mitkStandardToftsModel.h"
+#include "mitkStandardToftsModelParameterizer.h"
+
+class mitkAIFConvolutionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAIFConvolutionTestSuite);
+  MITK_TEST(ConvoluteWithExponentialTest);
+  MITK_TEST(ConvoluteWithExponentialDerivativeTest);
+  MITK_TEST(ModelConvolutionTest);
+  MITK_TEST(ParameterizerSharesConvolutionTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_grid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_arterialInputFunction;
+  std::vector<double> m_lambdas;
+
+public:
+  void setUp() override
+  {
+    m_grid.SetSize(22);
+    m_arterialInputFunction.SetSize(22);
+
+    for (int i = 0; i < 22; ++i)
+    {
+      // time grid in seconds, 14s between frames
+      m_grid[i] = (double)14 * i;
+      m_arterialInputFunction[i] = i < 5 ? 0 : 3.99 * exp(-0.144 * m_grid[i]) + 4.78 * exp(-0.0111 * m_grid[i]);
+    }
+
+    m_lambdas = { 0.001, 0.0117, 0.05, 0.3, 1.5 };
+  }
+
+  void tearDown() override
+  {
+    m_lambdas.clear();
+  }
+
+  void ConvoluteWithExponentialTest()
+  {
+    mitk::AIFConvolution convolution(m_grid, m_arterialInputFunction);
+
+    const std::size_t count = m_lambdas.size();
+    std::vector<double> results(m_grid.GetSize() * count);
+    convolution.ConvoluteWithExponential(m_lambdas.data(), count, results.data());
+
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      itk::Array<double> reference = mitk::convoluteAIFWithExponential(m_grid, m_arterialInputFunction, m_lambdas[k]);
+
+      for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Checking batched convolution.",
+          mitk::Equal(reference[i], results[i * count + k], 1e-10, true) == true);
+      }
+    }
+  }
+
+  void ConvoluteWithExponentialDerivativeTest()
+  {
+    mitk::AIFConvolution convolution(m_grid, m_arterialInputFunction);
+
+    const std::size_t count = m_lambdas.size();
+    std::vector<double> results(m_grid.GetSize() * count);
+    std::vector<double> derivatives(m_grid.GetSize() * count);
+    convolution.ConvoluteWithExponential(m_lambdas.data(), count, results.data(), derivatives.data());
+
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      // compare with central differences
+      const double stepLength = 1e-6 * m_lambdas[k];
+      itk::Array<double> lower = mitk::convoluteAIFWithExponential(m_grid, m_arterialInputFunction, m_lambdas[k] - stepLength);
+      itk::Array<double> upper = mitk::convoluteAIFWithExponential(m_grid, m_arterialInputFunction, m_lambdas[k] + stepLength);
+
+      for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+      {
+        const double numericDerivative = (upper[i] - lower[i]) / (2 * stepLength);
+        CPPUNIT_ASSERT_MESSAGE("Checking convolution derivatives.",
+          mitk::Equal(numericDerivative, derivatives[i * count + k], 1e-6 + 1e-4 * std::abs(numericDerivative), true) == true);
+      }
+    }
+  }
+
+  void ModelConvolutionTest()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_grid);
+    model->SetAterialInputFunctionValues(m_arterialInputFunction);
+    model->SetAterialInputFunctionTimeGrid(m_grid);
+
+    auto convolution = model->GetAIFConvolution();
+    CPPUNIT_ASSERT_MESSAGE("Checking if the convolution is reused.", convolution == model->GetAIFConvolution());
+
+    mitk::AIFBasedModelBase::AterialInputFunctionType otherFunction = m_arterialInputFunction;
+    otherFunction *= 2.0;
+    model->SetAterialInputFunctionValues(otherFunction);
+    auto otherConvolution = model->GetAIFConvolution();
+    CPPUNIT_ASSERT_MESSAGE("Checking if the convolution is recreated for a new AIF.", convolution != otherConvolution);
+    CPPUNIT_ASSERT_MESSAGE("Checking AIF of recreated convolution.",
+      otherConvolution->GetAterialInputFunction() == otherFunction);
+  }
+
+  void ParameterizerSharesConvolutionTest()
+  {
+    mitk::StandardToftsModelParameterizer::Pointer parameterizer = mitk::StandardToftsModelParameterizer::New();
+    parameterizer->SetDefaultTimeGrid(m_grid);
+    parameterizer->SetAIF(m_arterialInputFunction);
+    parameterizer->SetAIFTimeGrid(m_grid);
+
+    mitk::ModelParameterizerBase::IndexType index;
+    index.Fill(0);
+    mitk::ModelParameterizerBase::ModelBasePointer modelBase1 = parameterizer->GenerateParameterizedModel(index);
+    index.Fill(1);
+    mitk::ModelParameterizerBase::ModelBasePointer modelBase2 = parameterizer->GenerateParameterizedModel(index);
+
+    auto model1 = dynamic_cast<mitk::AIFBasedModelBase*>(modelBase1.GetPointer());
+    auto model2 = dynamic_cast<mitk::AIFBasedModelBase*>(modelBase2.GetPointer());
+
+    CPPUNIT_ASSERT(model1 != nullptr && model2 != nullptr);
+    CPPUNIT_ASSERT_MESSAGE("Checking if generated models share the convolution.",
+      model1->GetAIFConvolution() == model2->GetAIFConvolution());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAIFConvolution)
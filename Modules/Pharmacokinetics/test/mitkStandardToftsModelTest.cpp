@@ -32,6 +32,7 @@ class mitkStandardToftsModelTestSuite : public mitk::TestFixture
   MITK_TEST(GetDerivedParameterUnitsTest);
   MITK_TEST(ComputeModelfunctionTest);
   MITK_TEST(ComputeDerivedParametersTest);
+  MITK_TEST(ComputeModelfunctionDerivativesTest);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -157,6 +158,36 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Checking kep.", mitk::Equal(70.0, m_derivedParameters["kep"], 1e-6, true) == true);
   }
 
+
+  void ComputeModelfunctionDerivativesTest()
+  {
+    mitk::ModelBase::ParametersType parameters(2);
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans] = 35.0;
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_ve] = 0.5;
+
+    CPPUNIT_ASSERT_MESSAGE("Checking if model offers signal derivatives.", m_testmodel->HasSignalDerivatives());
+    mitk::ModelBase::ModelDerivativeType derivatives = m_testmodel->GetSignalDerivatives(parameters);
+
+    // compare with central differences
+    for (unsigned int p = 0; p < parameters.size(); ++p)
+    {
+      const double stepLength = 1e-6 * parameters[p];
+      mitk::ModelBase::ParametersType lowerParameters = parameters;
+      lowerParameters[p] -= stepLength;
+      mitk::ModelBase::ParametersType upperParameters = parameters;
+      upperParameters[p] += stepLength;
+
+      mitk::ModelBase::ModelResultType lowerSignal = m_testmodel->GetSignal(lowerParameters);
+      mitk::ModelBase::ModelResultType upperSignal = m_testmodel->GetSignal(upperParameters);
+
+      for (unsigned int i = 0; i < m_output.size(); ++i)
+      {
+        const double numericDerivative = (upperSignal[i] - lowerSignal[i]) / (2 * stepLength);
+        CPPUNIT_ASSERT_MESSAGE("Checking signal derivatives.",
+          mitk::Equal(numericDerivative, derivatives[p][i], 1e-6 + 1e-4 * std::abs(numericDerivative), true) == true);
+      }
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkStandardToftsModel)
@@ -17,8 +17,7 @@ found in the LICENSE file.
 
 #include "mitkDataStorage.h"
 #include "mitkNodePredicateBase.h"
-
-#include <Poco/Zip/ZipLocalFileHeader.h>
+#include "mitkSceneReader.h"
 
 namespace tinyxml2
 {
@@ -94,6 +93,25 @@ namespace mitk
                            const DataStorage *storage,
                            const std::string &filename);
 
+    /**
+     * \brief Reuse the files of unchanged data when a scene is saved again.
+     *
+     * If enabled, SaveScene() copies the files of a BaseData object from the scene file it wrote last time to
+     * the same filename (if that file was not changed meanwhile), instead of serializing the object again.
+     * An object is considered unchanged if its modification time (GetMTime()) did not change. So this option
+     * must only be enabled if all modifications of the data (e.g. of the pixels of an image) call Modified().
+     * Disabled by default.
+     */
+    itkSetMacro(ReuseUnchangedData, bool);
+    itkGetConstMacro(ReuseUnchangedData, bool);
+    itkBooleanMacro(ReuseUnchangedData);
+
+    /**
+     * \brief Number of BaseData objects whose files the last call to SaveScene() copied from the previous scene file
+     * instead of serializing them again (see ReuseUnchangedData).
+     */
+    itkGetConstMacro(NumberOfReusedData, unsigned int);
+
     /**
      * \brief Get a list of nodes (BaseData containers) that failed to be read/written.
      *
@@ -121,17 +139,24 @@ namespace mitk
 
     std::string CreateEmptyTempDirectory();
 
-    tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
     tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
 
-    void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
-    void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
+    /**
+     * \brief Loads the scene described by indexfilename. If fileSource is given, the files of the scene
+     * (including the index file) are requested from it instead of expecting them in the working directory.
+     */
+    DataStorage::Pointer LoadSceneFromIndexFile(const std::string &indexfilename,
+                                                DataStorage *storage,
+                                                bool clearStorageFirst,
+                                                SceneReader::FileSource *fileSource);
 
     FailedBaseDataListType::Pointer m_FailedNodes;
     PropertyList::Pointer m_FailedProperties;
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+    bool m_ReuseUnchangedData;
+    unsigned int m_NumberOfReusedData;
   };
 }
 
@@ -33,7 +33,38 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
+    /**
+      \brief Provides the files of a scene in the working directory on demand.
+
+      Scene readers request each file (given relative to the working directory) before they read it and release it
+      afterwards. This allows to extract the files of a scene archive one by one instead of unpacking the whole
+      archive first. Request() and Release() may be called concurrently.
+    */
+    class MITKSCENESERIALIZATION_EXPORT FileSource
+    {
+    public:
+      virtual ~FileSource() = default;
+
+      /** \brief Makes filename (and files belonging to it) available in the working directory.*/
+      virtual bool Request(const std::string &filename) = 0;
+      /** \brief Called when filename is not needed anymore.*/
+      virtual void Release(const std::string &filename) = 0;
+    };
+
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /** \brief Sets the source of the scene files. Without a source, all files are expected in the working directory.*/
+    void SetFileSource(FileSource *fileSource) { m_FileSource = fileSource; }
+    FileSource *GetFileSource() const { return m_FileSource; }
+
+  protected:
+    /** \brief Requests filename from the file source (if there is one).*/
+    bool RequestFile(const std::string &filename) const;
+    /** \brief Releases filename from the file source (if there is one).*/
+    void ReleaseFile(const std::string &filename) const;
+
+  private:
+    FileSource *m_FileSource = nullptr;
   };
 }
 
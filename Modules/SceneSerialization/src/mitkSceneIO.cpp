@@ -10,11 +10,16 @@ found in the LICENSE file.
 
 ============================================================================*/
 
-#include <Poco/Delegate.h>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
+#include <Poco/FileStream.h>
 #include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
 #include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
-#include <Poco/Zip/Decompress.h>
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipCommon.h>
+#include <Poco/Zip/ZipStream.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
@@ -30,15 +35,290 @@ found in the LICENSE file.
 
 #include <itkObjectFactoryBase.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <mitkIOUtil.h>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "itksys/SystemTools.hxx"
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  /**
+    Provides the files of a scene archive in the working directory. Instead of unpacking the whole
+    archive first, each requested file (and all entries sharing its name up to the extension, e.g. a
+    detached header and its data) is extracted when a reader asks for it and deleted again once the reader
+    released it. Each extraction opens its own stream on the archive, so files can be extracted concurrently.
+  */
+  class SceneArchiveFileSource : public mitk::SceneReader::FileSource
+  {
+  public:
+    SceneArchiveFileSource(const std::string &archiveFilename, const std::string &workingDirectory)
+      : m_ArchiveFilename(archiveFilename), m_WorkingDirectory(workingDirectory), m_NumberOfErrors(0)
+    {
+    }
+
+    /** Reads the directory of the archive. Returns false if this is not possible.*/
+    bool Open()
+    {
+      try
+      {
+        std::ifstream file(m_ArchiveFilename.c_str(), std::ios::binary);
+        Poco::Zip::ZipArchive archive(file);
+
+        for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+        {
+          if (iter->second.isFile())
+            m_Entries[iter->first] = std::make_shared<Entry>(iter->second);
+        }
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Cannot read the contents of '" << m_ArchiveFilename << "': " << e.what();
+        return false;
+      }
+
+      return true;
+    }
+
+    bool Request(const std::string &filename) override
+    {
+      const auto entries = this->GetEntries(filename);
+      bool found = false;
+
+      for (const auto &entry : entries)
+      {
+        std::lock_guard<std::mutex> lock(entry->Mutex);
+
+        // a failed extraction is not counted as use, so the next request tries again
+        if (0 == entry->UseCount && !this->Extract(*entry))
+        {
+          ++m_NumberOfErrors;
+          continue;
+        }
+
+        ++entry->UseCount;
+        found |= entry->Header.getFileName() == filename;
+      }
+
+      return found;
+    }
+
+    void Release(const std::string &filename) override
+    {
+      for (const auto &entry : this->GetEntries(filename))
+      {
+        std::lock_guard<std::mutex> lock(entry->Mutex);
+
+        if (0 == entry->UseCount || 0 != --entry->UseCount)
+          continue;
+
+        try
+        {
+          Poco::File(this->GetPath(*entry)).remove();
+        }
+        catch (...)
+        {
+          // still in use (e.g. mapped into memory), removed with the working directory
+        }
+      }
+    }
+
+    unsigned int GetNumberOfErrors() const { return m_NumberOfErrors; }
+
+  private:
+    struct Entry
+    {
+      explicit Entry(const Poco::Zip::ZipLocalFileHeader &header) : Header(header), UseCount(0) {}
+
+      Poco::Zip::ZipLocalFileHeader Header;
+      std::mutex Mutex;
+      unsigned int UseCount;
+    };
+
+    /** Entries that belong to filename: the entry itself and all entries with the same name up to the extension.*/
+    std::vector<std::shared_ptr<Entry>> GetEntries(const std::string &filename) const
+    {
+      std::vector<std::shared_ptr<Entry>> entries;
+
+      auto stem = filename;
+      const auto extension = stem.find_last_of('.');
+      if (extension != std::string::npos && extension > stem.find_last_of("/\\") + 1)
+        stem.erase(extension);
+      stem += '.';
+
+      for (auto iter = m_Entries.lower_bound(stem);
+           iter != m_Entries.end() && 0 == iter->first.compare(0, stem.size(), stem);
+           ++iter)
+      {
+        entries.push_back(iter->second);
+      }
+
+      auto iter = m_Entries.find(filename);
+      if (iter != m_Entries.end() && 0 != filename.compare(0, stem.size(), stem))
+        entries.push_back(iter->second);
+
+      return entries;
+    }
+
+    std::string GetPath(const Entry &entry) const
+    {
+      Poco::Path path(m_WorkingDirectory);
+      path.makeDirectory();
+      return path.append(Poco::Path(entry.Header.getFileName(), Poco::Path::PATH_UNIX)).toString();
+    }
+
+    bool Extract(const Entry &entry) const
+    {
+      const auto &name = entry.Header.getFileName();
+
+      if (!Poco::Zip::ZipCommon::isValidPath(name))
+      {
+        MITK_ERROR << "Error while unzipping: illegal path " << name;
+        return false;
+      }
+
+      try
+      {
+        const Poco::Path path(this->GetPath(entry));
+        Poco::File(path.parent()).createDirectories();
+
+        std::ifstream file(m_ArchiveFilename.c_str(), std::ios::binary);
+        Poco::Zip::ZipInputStream input(file, entry.Header);
+        Poco::FileOutputStream output(path.toString(), std::ios::binary);
+        Poco::StreamCopier::copyStream(input, output);
+
+        if (!output.good())
+        {
+          MITK_ERROR << "Error while unzipping: cannot write " << path.toString();
+          return false;
+        }
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Error while unzipping: " << name << ": " << e.what();
+        return false;
+      }
+
+      return true;
+    }
+
+    std::string m_ArchiveFilename;
+    std::string m_WorkingDirectory;
+    std::map<std::string, std::shared_ptr<Entry>> m_Entries;
+    std::atomic<unsigned int> m_NumberOfErrors;
+  };
+
+  /** Entries that SaveScene() wrote for a base data object into a scene archive.*/
+  struct SavedBaseDataEntries
+  {
+    itk::ModifiedTimeType MTime;
+    std::string File;
+    std::vector<std::string> Entries;
+  };
+
+  /**
+    A scene archive written by SaveScene(). It is only used again if its size and modification time did not change.
+    The base data objects are identified by their address and their modification time. Objects created after the save
+    have a larger modification time, so an object at the address of a deleted one never matches.
+  */
+  struct SavedSceneArchive
+  {
+    Poco::File::FileSize Size = 0;
+    Poco::Timestamp LastModified;
+    std::map<const mitk::BaseData *, SavedBaseDataEntries> BaseData;
+    unsigned long SaveCount = 0;
+  };
+
+  /** The scene archives written last, at most MaxSavedSceneArchives. The one saved least recently is forgotten first.*/
+  const std::size_t MaxSavedSceneArchives = 8;
+  std::mutex savedSceneArchivesMutex;
+  std::map<std::string, SavedSceneArchive> savedSceneArchives;
+  unsigned long savedSceneArchivesCount = 0;
+
+  void RememberSavedSceneArchive(const std::string &filename, SavedSceneArchive &savedArchive)
+  {
+    std::lock_guard<std::mutex> lock(savedSceneArchivesMutex);
+    savedArchive.SaveCount = ++savedSceneArchivesCount;
+    savedSceneArchives[filename] = savedArchive;
+
+    if (savedSceneArchives.size() > MaxSavedSceneArchives)
+    {
+      savedSceneArchives.erase(std::min_element(savedSceneArchives.begin(),
+                                                savedSceneArchives.end(),
+                                                [](const auto &lhs, const auto &rhs) {
+                                                  return lhs.second.SaveCount < rhs.second.SaveCount;
+                                                }));
+    }
+  }
+
+  /** Removes a file when going out of scope, unless Keep() was called before.*/
+  class TemporaryFileRemover
+  {
+  public:
+    explicit TemporaryFileRemover(const std::string &filename) : m_Filename(filename), m_Keep(false) {}
+
+    ~TemporaryFileRemover()
+    {
+      if (m_Keep)
+        return;
+
+      try
+      {
+        Poco::File file(m_Filename);
+        if (file.exists())
+          file.remove();
+      }
+      catch (...)
+      {
+        MITK_ERROR << "Could not delete temporary file " << m_Filename;
+      }
+    }
+
+    void Keep() { m_Keep = true; }
+
+  private:
+    std::string m_Filename;
+    bool m_Keep;
+  };
+
+  mitk::BaseDataSerializer::Pointer CreateBaseDataSerializer(const mitk::BaseData *data)
+  {
+    // construct name of serializer class
+    std::string serializername(data->GetNameOfClass());
+    serializername += "Serializer";
+
+    std::list<itk::LightObject::Pointer> thingsThatCanSerializeThis =
+      itk::ObjectFactoryBase::CreateAllInstance(serializername.c_str());
+    if (thingsThatCanSerializeThis.size() < 1)
+    {
+      MITK_ERROR << "No serializer found for " << data->GetNameOfClass() << ". Skipping object";
+    }
+
+    for (auto iter = thingsThatCanSerializeThis.begin();
+         iter != thingsThatCanSerializeThis.end();
+         ++iter)
+    {
+      if (auto *serializer = dynamic_cast<mitk::BaseDataSerializer *>(iter->GetPointer()))
+        return serializer;
+    }
+
+    return nullptr;
+  }
+}
+
+mitk::SceneIO::SceneIO()
+  : m_WorkingDirectory(""), m_UnzipErrors(0), m_ReuseUnchangedData(false), m_NumberOfReusedData(0)
 {
 }
 
@@ -117,18 +397,17 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
-  // unzip all filenames contents to temp dir
-  m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
+  // the files of the scene are extracted on demand while the scene is read
+  SceneArchiveFileSource archive(filename, m_WorkingDirectory);
+
+  // transcode locale-dependent string
+  m_WorkingDirectory = Poco::Path::transcode (m_WorkingDirectory);
+
+  m_UnzipErrors = archive.Open() ? 0 : 1;
+
+  auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
+  storage = this->LoadSceneFromIndexFile(indexFile, storage, clearStorageFirst, &archive);
+  m_UnzipErrors += archive.GetNumberOfErrors();
 
   if (m_UnzipErrors)
   {
@@ -136,12 +415,6 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
                << "'. Will attempt to read whatever could be unzipped.";
   }
 
-  // transcode locale-dependent string
-  m_WorkingDirectory = Poco::Path::transcode (m_WorkingDirectory);
-
-  auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
-  storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
-
   // delete temp directory
   try
   {
@@ -160,6 +433,14 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
 mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &indexfilename,
   DataStorage *pStorage,
   bool clearStorageFirst)
+{
+  return this->LoadSceneFromIndexFile(indexfilename, pStorage, clearStorageFirst, nullptr);
+}
+
+mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneFromIndexFile(const std::string &indexfilename,
+                                                                 DataStorage *pStorage,
+                                                                 bool clearStorageFirst,
+                                                                 SceneReader::FileSource *fileSource)
 {
   mitk::LocaleSwitch localeSwitch("C");
 
@@ -197,7 +478,14 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   // test if index.xml exists
   // parse index.xml with TinyXML
   tinyxml2::XMLDocument document;
-  if (tinyxml2::XML_SUCCESS != document.LoadFile(indexfilename.c_str()))
+  const bool indexFileAvailable = nullptr == fileSource || fileSource->Request(tempfilename);
+  const auto parseResult =
+    indexFileAvailable ? document.LoadFile(indexfilename.c_str()) : tinyxml2::XML_ERROR_FILE_NOT_FOUND;
+
+  if (nullptr != fileSource)
+    fileSource->Release(tempfilename);
+
+  if (tinyxml2::XML_SUCCESS != parseResult)
   {
     MITK_ERROR << "Could not open/read/parse " << workingDir << mitk::IOUtil::GetDirectorySeparator()
       << "index.xml\nTinyXML reports: " << document.ErrorStr() << std::endl;
@@ -205,6 +493,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
+  reader->SetFileSource(fileSource);
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
@@ -238,10 +527,46 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
   mitk::LocaleSwitch localeSwitch("C");
 
+  // The base data of the nodes is serialized concurrently by worker threads, each into a directory of its own.
+  // The worker also compresses these files into a small archive, whose entries are copied without recompression
+  // into the scene archive by this thread as soon as the worker is finished.
+  struct BaseDataSaveJob
+  {
+    DataNode *Node = nullptr;
+    const BaseData *Data = nullptr;
+    BaseDataSerializer::Pointer Serializer;
+    tinyxml2::XMLElement *Element = nullptr;
+    itk::ModifiedTimeType MTime = 0;
+    std::string Directory;
+    std::string File;
+    std::vector<std::string> Entries;
+    bool Reuse = false;
+    bool Error = true;
+  };
+
+  std::vector<BaseDataSaveJob> jobs;
+  std::mutex mutex;
+  std::condition_variable jobFinished;
+  std::deque<std::size_t> finishedJobs;
+  std::atomic<std::size_t> nextJob(0);
+  std::vector<std::thread> threads;
+
+  // the workers never wait for this thread, so they can always be joined (also if an exception leaves this method)
+  struct ThreadJoiner
+  {
+    std::vector<std::thread> &Threads;
+    ~ThreadJoiner()
+    {
+      for (auto &thread : Threads)
+        thread.join();
+    }
+  } threadJoiner{threads};
+
   try
   {
     m_FailedNodes = DataStorage::SetOfObjects::New();
     m_FailedProperties = PropertyList::New();
+    m_NumberOfReusedData = 0;
 
     // start XML DOM
     tinyxml2::XMLDocument document;
@@ -253,6 +578,42 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     version->SetAttribute("FileVersion", 1);
     document.InsertEndChild(version);
 
+    // entries of unchanged base data can be copied from the archive written by the last save to filename
+    SavedSceneArchive previousSave;
+    std::ifstream previousArchiveFile;
+    std::unique_ptr<Poco::Zip::ZipArchive> previousArchive;
+
+    if (m_ReuseUnchangedData)
+    {
+      std::lock_guard<std::mutex> lock(savedSceneArchivesMutex);
+      auto iter = savedSceneArchives.find(filename);
+
+      if (iter != savedSceneArchives.end())
+      {
+        Poco::File file(filename);
+
+        if (file.exists() && file.getSize() == iter->second.Size &&
+            file.getLastModified() == iter->second.LastModified)
+        {
+          previousSave = iter->second;
+        }
+      }
+    }
+
+    if (!previousSave.BaseData.empty())
+    {
+      try
+      {
+        previousArchiveFile.open(filename.c_str(), std::ios::binary);
+        previousArchive.reset(new Poco::Zip::ZipArchive(previousArchiveFile));
+      }
+      catch (const std::exception &e)
+      {
+        MITK_WARN << "Cannot reuse the contents of '" << filename << "': " << e.what();
+        previousSave.BaseData.clear();
+      }
+    }
+
     // DataStorage::SetOfObjects::ConstPointer sceneNodes = storage->GetSubset( predicate );
 
     if (sceneNodes.IsNull())
@@ -351,17 +712,50 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             }
           }
 
-          // store basedata
+          // store basedata (the file is written by the workers)
           if (BaseData *data = node->GetData())
           {
-            // std::string filenameHint( node->GetName() );
-            bool error(false);
-            auto *dataElement = SaveBaseData(document, data, filenameHint, error); // returns a reference to a file
-            if (error)
+            auto *dataElement = document.NewElement("data");
+            dataElement->SetAttribute("type", data->GetNameOfClass());
+            dataElement->SetAttribute("UID", data->GetUID().c_str());
+
+            BaseDataSaveJob job;
+            job.Node = node;
+            job.Data = data;
+            job.Element = dataElement;
+            job.MTime = data->GetMTime();
+            job.Directory = m_WorkingDirectory + Poco::Path::separator() + "data" + Poco::Path::separator() +
+                            std::to_string(jobs.size());
+
+            auto savedIter = previousSave.BaseData.find(data);
+            if (savedIter != previousSave.BaseData.end() && savedIter->second.MTime == job.MTime)
             {
-              m_FailedNodes->push_back(node);
+              job.Reuse = true;
+              for (const auto &entry : savedIter->second.Entries)
+                job.Reuse &= previousArchive->findHeader(entry) != previousArchive->headerEnd();
+
+              if (job.Reuse)
+              {
+                job.File = savedIter->second.File;
+                job.Entries = savedIter->second.Entries;
+                job.Error = false;
+              }
             }
 
+            if (!job.Reuse)
+            {
+              job.Serializer = CreateBaseDataSerializer(data);
+
+              if (job.Serializer.IsNotNull())
+              {
+                job.Serializer->SetData(data);
+                job.Serializer->SetFilenameHint(filenameHint);
+                job.Serializer->SetWorkingDirectory(Poco::Path::transcode(job.Directory));
+              }
+            }
+
+            jobs.push_back(job);
+
             // store basedata properties
             PropertyList *propertyList = data->GetPropertyList();
             if (propertyList && !propertyList->IsEmpty())
@@ -397,16 +791,127 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             nodeElement->InsertEndChild(propertiesElement);
           }
           document.InsertEndChild(nodeElement);
+
+          if (nullptr == node->GetData())
+            ProgressBar::GetInstance()->Progress();
         }
         else
         {
           MITK_WARN << "Ignoring nullptr node during scene serialization.";
+          ProgressBar::GetInstance()->Progress();
         }
-
-        ProgressBar::GetInstance()->Progress();
       } // end for all nodes
     }   // end if sceneNodes
 
+    auto saveBaseData = [&]() {
+      for (auto i = nextJob++; i < jobs.size(); i = nextJob++)
+      {
+        auto &job = jobs[i];
+
+        if (!job.Reuse && job.Serializer.IsNotNull())
+        {
+          try
+          {
+            Poco::File(job.Directory).createDirectories();
+            job.File = job.Serializer->Serialize();
+            job.Error = job.File.empty();
+          }
+          catch (std::exception &e)
+          {
+            MITK_ERROR << "Serializer " << job.Serializer->GetNameOfClass() << " failed: " << e.what();
+          }
+
+          try
+          {
+            // compress the files of this node while the other nodes are still serialized
+            {
+              Poco::FileOutputStream archive(job.Directory + ".zip", std::ios::binary);
+              Poco::Zip::Compress zipper(archive, true);
+              Poco::Path directory(job.Directory);
+              directory.makeDirectory();
+              zipper.addRecursive(directory);
+              zipper.close();
+            }
+
+            Poco::File(job.Directory).remove(true);
+          }
+          catch (std::exception &e)
+          {
+            MITK_ERROR << "Could not compress the files of " << job.File << ": " << e.what();
+            job.Error = true;
+          }
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          finishedJobs.push_back(i);
+        }
+        jobFinished.notify_one();
+      }
+    };
+
+    const auto numberOfThreads =
+      std::min<std::size_t>(jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t i = 0; i < numberOfThreads; ++i)
+      threads.emplace_back(saveBaseData);
+
+    // the scene is written next to filename and only replaces it once it is complete
+    const std::string temporaryFilename = filename + ".tmp";
+    TemporaryFileRemover temporaryFileRemover(temporaryFilename); // declared before file, so it is closed first
+    std::ofstream file(temporaryFilename.c_str(), std::ios::binary | std::ios::out);
+    if (!file.good())
+    {
+      MITK_ERROR << "Could not open a zip file for writing: '" << temporaryFilename << "'";
+      return false;
+    }
+
+    Poco::Zip::Compress zipper(file, true);
+
+    for (std::size_t finishedCount = 0; finishedCount < jobs.size(); ++finishedCount)
+    {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobFinished.wait(lock, [&finishedJobs]() { return !finishedJobs.empty(); });
+        i = finishedJobs.front();
+        finishedJobs.pop_front();
+      }
+
+      auto &job = jobs[i];
+
+      if (job.Reuse)
+      {
+        for (const auto &entry : job.Entries)
+        {
+          zipper.addFileRaw(
+            previousArchiveFile, previousArchive->findHeader(entry)->second, Poco::Path(entry, Poco::Path::PATH_UNIX));
+        }
+
+        ++m_NumberOfReusedData;
+      }
+      else if (!job.Error)
+      {
+        std::ifstream partFile((job.Directory + ".zip").c_str(), std::ios::binary);
+        Poco::Zip::ZipArchive part(partFile);
+
+        for (auto iter = part.headerBegin(); iter != part.headerEnd(); ++iter)
+        {
+          if (!iter->second.isFile())
+            continue;
+
+          zipper.addFileRaw(partFile, iter->second, Poco::Path(iter->first, Poco::Path::PATH_UNIX));
+          job.Entries.push_back(iter->first);
+        }
+      }
+
+      job.Element->SetAttribute("file", job.File.c_str());
+
+      if (job.Error)
+        m_FailedNodes->push_back(job.Node);
+
+      ProgressBar::GetInstance()->Progress();
+    }
+
     std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
 
     auto xmlFilename = defaultLocale_WorkingDirectory + Poco::Path::separator() + "index.xml";
@@ -420,26 +925,36 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     {
       try
       {
-        Poco::File deleteFile(filename.c_str());
-        if (deleteFile.exists())
+        // add index.xml and the property lists
+        for (Poco::DirectoryIterator iter(m_WorkingDirectory), end; iter != end; ++iter)
         {
-          deleteFile.remove();
+          if (iter->isFile())
+            zipper.addFile(iter.path(), Poco::Path(iter.name()));
         }
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
-        }
-        else
+        zipper.close();
+        file.close();
+
+        previousArchive.reset();
+        previousArchiveFile.close();
+
+        Poco::File(temporaryFilename).renameTo(filename);
+        temporaryFileRemover.Keep();
+
+        // remember the entries of the base data for the next save
+        SavedSceneArchive savedArchive;
+        Poco::File savedFile(filename);
+        savedArchive.Size = savedFile.getSize();
+        savedArchive.LastModified = savedFile.getLastModified();
+
+        for (const auto &job : jobs)
         {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
+          if (!job.Error)
+            savedArchive.BaseData[job.Data] = {job.MTime, job.File, job.Entries};
         }
+
+        RememberSavedSceneArchive(filename, savedArchive);
+
         try
         {
           Poco::File deleteDir(m_WorkingDirectory);
@@ -466,60 +981,6 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
   }
 }
 
-tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error)
-{
-  assert(data);
-  error = true;
-
-  // find correct serializer
-  // the serializer must
-  //  - create a file containing all information to recreate the BaseData object --> needs to know where to put this
-  //  file (and a filename?)
-  //  - TODO what to do about writers that creates one file per timestep?
-  auto *element = doc.NewElement("data");
-  element->SetAttribute("type", data->GetNameOfClass());
-
-  // construct name of serializer class
-  std::string serializername(data->GetNameOfClass());
-  serializername += "Serializer";
-
-  std::list<itk::LightObject::Pointer> thingsThatCanSerializeThis =
-    itk::ObjectFactoryBase::CreateAllInstance(serializername.c_str());
-  if (thingsThatCanSerializeThis.size() < 1)
-  {
-    MITK_ERROR << "No serializer found for " << data->GetNameOfClass() << ". Skipping object";
-  }
-
-  for (auto iter = thingsThatCanSerializeThis.begin();
-       iter != thingsThatCanSerializeThis.end();
-       ++iter)
-  {
-    if (auto *serializer = dynamic_cast<BaseDataSerializer *>(iter->GetPointer()))
-    {
-      serializer->SetData(data);
-      serializer->SetFilenameHint(filenamehint);
-      std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
-      serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
-      try
-      {
-        std::string writtenfilename = serializer->Serialize();
-        element->SetAttribute("file", writtenfilename.c_str());
-
-        if (!writtenfilename.empty())
-          error = false;
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
-      }
-      break;
-    }
-  }
-  element->SetAttribute("UID", data->GetUID().c_str());
-
-  return element;
-}
-
 tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint)
 {
   assert(propertyList);
@@ -562,16 +1023,3 @@ const mitk::PropertyList *mitk::SceneIO::GetFailedProperties()
 {
   return m_FailedProperties;
 }
-
-void mitk::SceneIO::OnUnzipError(const void * /*pSender*/,
-                                 std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info)
-{
-  ++m_UnzipErrors;
-  MITK_ERROR << "Error while unzipping: " << info.second;
-}
-
-void mitk::SceneIO::OnUnzipOk(const void * /*pSender*/,
-                              std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> & /*info*/)
-{
-  // MITK_INFO << "Unzipped ok: " << info.second.toString();
-}
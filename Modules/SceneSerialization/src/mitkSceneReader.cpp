@@ -46,6 +46,8 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetFileSource(m_FileSource);
+
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
@@ -60,3 +62,14 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   }
   return false;
 }
+
+bool mitk::SceneReader::RequestFile(const std::string &filename) const
+{
+  return nullptr == m_FileSource || m_FileSource->Request(filename);
+}
+
+void mitk::SceneReader::ReleaseFile(const std::string &filename) const
+{
+  if (nullptr != m_FileSource)
+    m_FileSource->Release(filename);
+}
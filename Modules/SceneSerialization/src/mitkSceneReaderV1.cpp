@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkSceneReaderV1.h"
 #include "Poco/Path.h"
 #include "mitkBaseRenderer.h"
+#include "mitkExceptionMacro.h"
 #include "mitkIOUtil.h"
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
@@ -21,8 +22,15 @@ found in the LICENSE file.
 #include <mitkRenderingModeProperty.h>
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -111,25 +119,25 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
   //        - try to instantiate this serializer via itk object factory
   //        - if serializer could be created, use it to read the file into a BaseData object
   //        - if successful, call the new node's SetData(..)
-
-  // create a node for the tag "data" and test if node was created
-  typedef std::vector<mitk::DataNode::Pointer> DataNodeVector;
-  DataNodeVector DataNodes;
-  unsigned int listSize = 0;
+  std::vector<const tinyxml2::XMLElement *> nodeElements;
+  std::set<std::string> knownUIDs;
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    ++listSize;
+    nodeElements.push_back(element);
+
+    if (const auto *uid = element->Attribute("UID"))
+      knownUIDs.insert(uid);
   }
 
+  const auto listSize = nodeElements.size();
   ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
 
   // Deserialize base data properties before reading the actual data to be
   // able to provide them as read-only meta data to the data reader.
   std::map<std::string, PropertyList::Pointer> baseDataPropertyLists;
 
-  for (auto *nodeElement = document.FirstChildElement("node"); nodeElement != nullptr;
-       nodeElement = nodeElement->NextSiblingElement("node"))
+  for (const auto *nodeElement : nodeElements)
   {
     const auto *uid = nodeElement->Attribute("UID");
 
@@ -140,53 +148,121 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
 
     if (dataElement != nullptr)
     {
-      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
+      const auto *propertiesElement = dataElement->FirstChildElement("properties");
+      const auto *propertiesFile = propertiesElement != nullptr ? propertiesElement->Attribute("file") : nullptr;
+
+      if (propertiesFile != nullptr && !this->RequestFile(propertiesFile))
+      {
+        MITK_ERROR << "Could not provide property file '" << propertiesFile << "'.";
+        error = true;
+        continue;
+      }
+
+      auto properties = DeserializeProperties(propertiesElement, workingDirectory);
+
+      if (propertiesFile != nullptr)
+        this->ReleaseFile(propertiesFile);
 
       if (properties.IsNotNull())
         baseDataPropertyLists[uid] = properties;
     }
   }
 
-  for (auto *element = document.FirstChildElement("node"); element != nullptr;
-       element = element->NextSiblingElement("node"))
+  // The base data of the nodes is read concurrently by worker threads. Each node is passed
+  // back to this thread as soon as it is finished, decorated with its properties and added
+  // to the DataStorage once all of its parents are there. So the DataStorage (and its
+  // observers) is only touched by this thread and the first nodes are available before
+  // the whole scene is read.
+  struct NodeLoadJob
   {
-    mitk::PropertyList* properties = nullptr;
-    const auto *uid = element->Attribute("UID");
+    PropertyList::Pointer Properties;
+    DataNode::Pointer Node;
+    bool Error = false;
+  };
+
+  std::vector<NodeLoadJob> jobs(listSize);
 
-    if (uid != nullptr)
+  for (std::size_t i = 0; i < listSize; ++i)
+  {
+    if (const auto *uid = nodeElements[i]->Attribute("UID"))
     {
       auto iter = baseDataPropertyLists.find(uid);
 
       if (iter != baseDataPropertyLists.end())
-        properties = iter->second;
+        jobs[i].Properties = iter->second;
     }
+  }
 
-    const auto *dataElement = element->FirstChildElement("data");
-    auto dataNode = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
+  std::mutex mutex;
+  std::condition_variable jobFinished;
+  std::deque<std::size_t> finishedJobs;
+  std::atomic<std::size_t> nextJob(0);
 
-    if (dataNode.IsNull())
-      continue;
+  auto loadNodes = [&]() {
+    for (auto i = nextJob++; i < listSize; i = nextJob++)
+    {
+      auto &job = jobs[i];
 
-    auto* baseData = dataNode->GetData();
+      try
+      {
+        job.Node = this->LoadBaseDataFromDataTag(
+          nodeElements[i]->FirstChildElement("data"), job.Properties, workingDirectory, job.Error);
+      }
+      catch (...)
+      {
+        MITK_ERROR << "Unexpected error while loading the data of a node.";
+        job.Node = DataNode::New();
+        job.Error = true;
+      }
 
-    if (baseData != nullptr && properties != nullptr)
-    {
-      baseData->SetPropertyList(properties);
-      ApplyProportionalTimeGeometryProperties(baseData);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishedJobs.push_back(i);
+      }
+      jobFinished.notify_one();
     }
+  };
 
-    DataNodes.push_back(dataNode);
+  const auto numberOfThreads = std::min<std::size_t>(listSize, std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
 
-    ProgressBar::GetInstance()->Progress();
-  }
+  // the workers never wait for this thread, so they can always be joined (also if an exception leaves this method)
+  struct ThreadJoiner
+  {
+    std::vector<std::thread> &Threads;
+    ~ThreadJoiner()
+    {
+      for (auto &thread : Threads)
+        thread.join();
+    }
+  } threadJoiner{threads};
+
+  for (std::size_t i = 0; i < numberOfThreads; ++i)
+    threads.emplace_back(loadNodes);
 
-  // iterate all nodes
-  // first level nodes should be <node> elements
-  auto nit = DataNodes.begin();
-  for (auto *element = document.FirstChildElement("node"); element != nullptr || nit != DataNodes.end();
-       element = element->NextSiblingElement("node"), ++nit)
+  for (std::size_t finishedCount = 0; finishedCount < listSize; ++finishedCount)
   {
-    mitk::DataNode::Pointer node = *nit;
+    std::size_t i;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobFinished.wait(lock, [&finishedJobs]() { return !finishedJobs.empty(); });
+      i = finishedJobs.front();
+      finishedJobs.pop_front();
+    }
+
+    const auto *element = nodeElements[i];
+    mitk::DataNode::Pointer node = jobs[i].Node;
+    error |= jobs[i].Error;
+
+    auto* baseData = node->GetData();
+
+    if (baseData != nullptr && jobs[i].Properties.IsNotNull())
+    {
+      baseData->SetPropertyList(jobs[i].Properties);
+      ApplyProportionalTimeGeometryProperties(baseData);
+    }
+
+    ProgressBar::GetInstance()->Progress();
 
     //   1. check child nodes
     const char *uida = element->Attribute("UID");
@@ -219,105 +295,97 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     m_OrderedNodePairs.push_back(std::make_pair(node, std::list<std::string>()));
 
     //   3. if there are <source> elements, remember parent objects
+    //      (all unknown parent UIDs are skipped)
     for (auto *source = element->FirstChildElement("source"); source != nullptr;
          source = source->NextSiblingElement("source"))
     {
       const char *sourceUID = source->Attribute("UID");
       if (sourceUID)
       {
-        m_OrderedNodePairs.back().second.push_back(std::string(sourceUID));
+        if (knownUIDs.find(sourceUID) == knownUIDs.end())
+        {
+          MITK_WARN << "Found a DataNode with unknown parents. Will add it to DataStorage without any parent objects.";
+          error = true;
+        }
+        else
+        {
+          m_OrderedNodePairs.back().second.push_back(std::string(sourceUID));
+        }
       }
     }
 
+    this->AddNodesWithParentsInStorage(storage);
+
     ProgressBar::GetInstance()->Progress();
   } // end for all <node>
 
-  // sort our nodes by their "layer" property
-  // (to be inserted in that order)
+  // All nodes that are still in m_OrderedNodePairs at this point are not part of a proper directed graph structure.
+  // We'll add such nodes without any parent information.
   m_OrderedNodePairs.sort(&NodeSortByLayerIsLessThan);
 
-  // remove all unknown parent UIDs
   for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();
        ++nodesIter)
   {
-    for (auto parentsIter = nodesIter->second.begin();
-         parentsIter != nodesIter->second.end();)
-    {
-      if (m_NodeForID.find(*parentsIter) == m_NodeForID.end())
-      {
-        parentsIter = nodesIter->second.erase(parentsIter);
-        MITK_WARN << "Found a DataNode with unknown parents. Will add it to DataStorage without any parent objects.";
-        error = true;
-      }
-      else
-      {
-        ++parentsIter;
-      }
-    }
+    storage->Add(nodesIter->first);
+    MITK_WARN << "Encountered node that is not part of a directed graph structure. Will be added to DataStorage "
+                 "without parents.";
+    error = true;
   }
 
-  // repeat the following loop ...
-  //   ... for all created nodes
-  unsigned int lastMapSize(0);
-  while (lastMapSize !=
-         m_OrderedNodePairs
-           .size()) // this is to prevent infinite loops; each iteration must at least add one node to DataStorage
+  m_OrderedNodePairs.clear();
+
+  return !error;
+}
+
+void mitk::SceneReaderV1::AddNodesWithParentsInStorage(DataStorage *storage)
+{
+  // sort our nodes by their "layer" property
+  // (to be inserted in that order)
+  m_OrderedNodePairs.sort(&NodeSortByLayerIsLessThan);
+
+  // repeat the following loop until no node can be added anymore, because
+  // adding a node may allow to add its (already loaded) children
+  bool nodeAdded(true);
+  while (nodeAdded)
   {
-    lastMapSize = m_OrderedNodePairs.size();
+    nodeAdded = false;
 
-    // iterate (layer) ordered nodes backwards
-    // we insert the highest layers first
-    for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();
-         ++nodesIter)
+    for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();)
     {
       bool addThisNode(true);
+      DataStorage::SetOfObjects::Pointer parents = DataStorage::SetOfObjects::New();
 
       // if any parent node is not yet in DataStorage, skip node for now and check later
       for (auto parentsIter = nodesIter->second.begin();
            parentsIter != nodesIter->second.end();
            ++parentsIter)
       {
-        if (!storage->Exists(m_NodeForID[*parentsIter]))
+        auto parentIter = m_NodeForID.find(*parentsIter);
+
+        if (parentIter == m_NodeForID.end() || !storage->Exists(parentIter->second))
         {
           addThisNode = false;
           break;
         }
+
+        parents->push_back(parentIter->second);
       }
 
       if (addThisNode)
       {
-        DataStorage::SetOfObjects::Pointer parents = DataStorage::SetOfObjects::New();
-        for (auto parentsIter = nodesIter->second.begin();
-             parentsIter != nodesIter->second.end();
-             ++parentsIter)
-        {
-          parents->push_back(m_NodeForID[*parentsIter]);
-        }
-
-        // if all parents are found in datastorage (or are unknown), add node to DataStorage
+        // if all parents are found in datastorage, add node to DataStorage
         storage->Add(nodesIter->first, parents);
 
         // remove this node from m_OrderedNodePairs
-        m_OrderedNodePairs.erase(nodesIter);
-
-        // break this for loop because iterators are probably invalid
-        break;
+        nodesIter = m_OrderedNodePairs.erase(nodesIter);
+        nodeAdded = true;
+      }
+      else
+      {
+        ++nodesIter;
       }
     }
   }
-
-  // All nodes that are still in m_OrderedNodePairs at this point are not part of a proper directed graph structure.
-  // We'll add such nodes without any parent information.
-  for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();
-       ++nodesIter)
-  {
-    storage->Add(nodesIter->first);
-    MITK_WARN << "Encountered node that is not part of a directed graph structure. Will be added to DataStorage "
-                 "without parents.";
-    error = true;
-  }
-
-  return !error;
 }
 
 mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
@@ -334,6 +402,9 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
     {
       try
       {
+        if (!this->RequestFile(filename))
+          mitkThrow() << "File is not contained in the scene.";
+
         auto baseData = IOUtil::Load(workingDirectory + Poco::Path::separator() + filename, properties);
 
         node = DataNode::New();
@@ -345,6 +416,8 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
         error = true;
       }
 
+      this->ReleaseFile(filename);
+
       if (node.IsNull())
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
@@ -448,7 +521,8 @@ bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
     PropertyListDeserializer::Pointer deserializer = PropertyListDeserializer::New();
 
     deserializer->SetFilename(workingDirectory + Poco::Path::separator() + propertiesfile);
-    bool success = deserializer->Deserialize();
+    bool success = this->RequestFile(propertiesfile) && deserializer->Deserialize();
+    this->ReleaseFile(propertiesfile);
     error |= !success;
     PropertyList::Pointer readProperties = deserializer->GetOutput();
 
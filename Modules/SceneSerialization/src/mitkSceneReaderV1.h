@@ -60,6 +60,12 @@ namespace mitk
     */
     void ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList);
 
+    /**
+      \brief Adds all nodes of m_OrderedNodePairs whose parents are in storage (in the order of their "layer" property)
+      and removes them from the list.
+    */
+    void AddNodesWithParentsInStorage(DataStorage *storage);
+
     typedef std::pair<DataNode::Pointer, std::list<std::string>> NodesAndParentsPair;
     typedef std::list<NodesAndParentsPair> OrderedNodesList;
     typedef std::map<std::string, DataNode *> IDToNodeMappingType;
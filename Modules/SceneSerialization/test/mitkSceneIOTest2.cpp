@@ -16,9 +16,14 @@ found in the LICENSE file.
 
 #include "mitkDataStorageCompare.h"
 #include "mitkIOUtil.h"
+#include "mitkImageGenerator.h"
+#include "mitkPointSet.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
 
+#include <map>
+#include <set>
+
 /**
   \brief Test cases for SceneIO.
 
@@ -78,6 +83,8 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ReconstructionOfScenesSavedAgain);
+  MITK_TEST(Test_LoadSceneWithManyDataNodes);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +132,142 @@ public:
     }
   }
 
+  void Test_ReconstructionOfScenesSavedAgain()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    mitk::SceneIOTestScenarioProvider::ScenarioList scenarios = m_TestCaseProvider.GetAllScenarios();
+    for (const auto& scenario : scenarios)
+    {
+      if (!scenario.serializable)
+        continue;
+
+      MITK_TEST_OUTPUT(<< "\n===== Test_ReconstructionOfScenesSavedAgain, scenario '" << scenario.key << "' =====");
+
+      // the second save copies the (unchanged) data from the first one
+      std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+      mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+      writer->ReuseUnchangedDataOn();
+      mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+      CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+      CPPUNIT_ASSERT_EQUAL(0u, writer->GetNumberOfReusedData());
+
+      unsigned int numberOfData = 0;
+      mitk::BaseData *modifiedData = nullptr;
+      for (const auto &node : *originalStorage->GetAll())
+      {
+        if (nullptr != node->GetData())
+        {
+          ++numberOfData;
+          modifiedData = node->GetData();
+        }
+      }
+
+      CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Data copied from the first save", numberOfData, writer->GetNumberOfReusedData());
+
+      // modified data is serialized again
+      if (nullptr != modifiedData)
+      {
+        modifiedData->Modified();
+        CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(
+          "Data copied from the second save", numberOfData - 1, writer->GetNumberOfReusedData());
+      }
+
+      mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+      mitk::DataStorage::Pointer restoredStorage;
+      CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+      CPPUNIT_ASSERT_MESSAGE(
+        std::string("Comparing restored test scenario '") + scenario.key + "'",
+        mitk::DataStorageCompare(originalStorage,
+                                 restoredStorage,
+                                 mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+                                   mitk::DataStorageCompare::CMP_Properties | mitk::DataStorageCompare::CMP_Mappers,
+                                 scenario.comparisonPrecision)
+          .CompareVerbose());
+    }
+  }
+
+  void Test_LoadSceneWithManyDataNodes()
+  {
+    // enough nodes with data for several reader threads, arranged such that
+    // children are listed before their parents in the scene file
+    mitk::DataStorage::Pointer originalStorage = mitk::StandaloneDataStorage::New().GetPointer();
+    std::map<std::string, std::set<std::string>> expectedParents;
+
+    mitk::DataStorage::SetOfObjects::Pointer roots = mitk::DataStorage::SetOfObjects::New();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      node->SetName("image " + std::to_string(i));
+      node->SetData(mitk::ImageGenerator::GenerateRandomImage<short>(8 + i, 9, 10, 1, 1, 1, 1, 100, 0));
+      originalStorage->Add(node);
+      roots->push_back(node);
+      expectedParents[node->GetName()];
+    }
+
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      node->SetName("point set " + std::to_string(i));
+
+      auto pointSet = mitk::PointSet::New();
+      mitk::PointSet::PointType point;
+      mitk::FillVector3D(point, i, 2.0 * i, -1.0 * i);
+      pointSet->InsertPoint(0, point);
+      node->SetData(pointSet);
+
+      mitk::DataStorage::SetOfObjects::Pointer parents = mitk::DataStorage::SetOfObjects::New();
+      parents->push_back(roots->ElementAt(i % roots->size()));
+      if (0 == i % 4)
+        parents->push_back(roots->ElementAt((i + 1) % roots->size()));
+      if (i >= roots->size())
+        parents->push_back(originalStorage->GetNamedNode("point set " + std::to_string(i - roots->size())));
+
+      originalStorage->Add(node, parents);
+      for (const auto &parent : *parents)
+        expectedParents[node->GetName()].insert(parent->GetName());
+    }
+
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    // reversed order, so the reader has to wait for the parents
+    mitk::DataStorage::SetOfObjects::Pointer nodes = mitk::DataStorage::SetOfObjects::New();
+    auto allNodes = originalStorage->GetAll();
+    for (auto iter = allNodes->rbegin(); iter != allNodes->rend(); ++iter)
+      nodes->push_back(*iter);
+
+    mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+    CPPUNIT_ASSERT(writer->SaveScene(nodes.GetPointer(), originalStorage, archiveFilename));
+
+    mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+    mitk::DataStorage::Pointer restoredStorage;
+    CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+    CPPUNIT_ASSERT_EQUAL(expectedParents.size(), static_cast<std::size_t>(restoredStorage->GetAll()->size()));
+
+    for (const auto &expected : expectedParents)
+    {
+      auto node = restoredStorage->GetNamedNode(expected.first);
+      CPPUNIT_ASSERT_MESSAGE("Restored node '" + expected.first + "'", nullptr != node);
+      CPPUNIT_ASSERT_MESSAGE("Data of restored node '" + expected.first + "'", nullptr != node->GetData());
+
+      std::set<std::string> parents;
+      for (const auto &parent : *restoredStorage->GetSources(node))
+        parents.insert(parent->GetName());
+
+      CPPUNIT_ASSERT_MESSAGE("Parents of restored node '" + expected.first + "'", expected.second == parents);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Comparing restored scene",
+                           mitk::DataStorageCompare(originalStorage,
+                                                    restoredStorage,
+                                                    mitk::DataStorageCompare::CMP_Hierarchy |
+                                                      mitk::DataStorageCompare::CMP_Data)
+                             .CompareVerbose());
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <itksys/SystemTools.hxx>
 #include <tinyxml2.h>
 
+#include <atomic>
+
 mitk::PropertyListSerializer::PropertyListSerializer() : m_FilenameHint("unnamed"), m_WorkingDirectory("")
 {
 }
@@ -35,7 +37,7 @@ std::string mitk::PropertyListSerializer::Serialize()
   }
 
   // tmpname
-  static unsigned long count = 1;
+  static std::atomic<unsigned long> count(1);
   unsigned long n = count++;
   std::ostringstream name;
   for (int i = 0; i < 6; ++i)
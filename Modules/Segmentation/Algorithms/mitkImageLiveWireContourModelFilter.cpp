@@ -25,9 +25,9 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   this->SetNumberOfIndexedOutputs(1);
   this->SetNthOutput(0, output.GetPointer());
   m_CostFunction = CostFunctionType::New();
-  m_ShortestPathFilter = ShortestPathImageFilterType::New();
-  m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  m_ShortestPathTreeUsesDynamicCostMap = false;
   m_UseDynamicCostMap = false;
+  m_UseCostFunction = true;
   m_TimeStep = 0;
 }
 
@@ -125,16 +125,23 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
   castFilter->Update();
   m_InternalImage = castFilter->GetOutput();
   m_CostFunction->SetImage(m_InternalImage);
-  m_ShortestPathFilter->SetInput(m_InternalImage);
+  m_ShortestPathTree.Invalidate();
 }
 
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
   m_CostFunction->ClearRepulsivePoints();
+  m_ShortestPathTree.Invalidate();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
+  // the costs only change if the point was not repulsive yet
+  if (m_CostFunction->GetMaskImage()->GetPixel(idx) == 0)
+  {
+    m_ShortestPathTree.Invalidate();
+  }
+
   m_CostFunction->AddRepulsivePoint(idx);
 }
 
@@ -148,12 +155,18 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
+  if (m_CostFunction->GetMaskImage()->GetPixel(idx) != 0)
+  {
+    m_ShortestPathTree.Invalidate();
+  }
+
   m_CostFunction->RemoveRepulsivePoint(idx);
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
 {
   m_CostFunction->ClearRepulsivePoints();
+  m_ShortestPathTree.Invalidate();
 
   auto iter = points.begin();
   for (; iter != points.end(); iter++)
@@ -197,19 +210,27 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
 
   // calculate shortest path between start and end point
-  m_ShortestPathFilter->SetFullNeighborsMode(true);
-  // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
-  m_ShortestPathFilter->SetMakeOutputImage(false);
-
-  // m_ShortestPathFilter->SetCalcAllDistances(true);
-  m_ShortestPathFilter->SetStartIndex(startPoint);
-  m_ShortestPathFilter->SetEndIndex(endPoint);
+  ShortestPathType shortestPath;
 
-  m_ShortestPathFilter->Update();
+  if (m_UseCostFunction)
+  {
+    // the costs do not depend on the end point, so the tree of the start point can be reused
+    if (!m_ShortestPathTree.IsValid() || m_ShortestPathTree.GetSeed() != startPoint ||
+        m_ShortestPathTreeUsesDynamicCostMap != m_UseDynamicCostMap)
+    {
+      m_CostFunction->Initialize();
+      m_ShortestPathTree.Initialize(m_InternalImage->GetLargestPossibleRegion(), startPoint);
+      m_ShortestPathTreeUsesDynamicCostMap = m_UseDynamicCostMap;
+    }
 
-  // construct contour from path image
-  // get the shortest path as vector
-  ShortestPathType shortestPath = m_ShortestPathFilter->GetVectorPath();
+    shortestPath = m_ShortestPathTree.GetPath(
+      endPoint, [this](const itk::Index<2> &p1, const itk::Index<2> &p2) { return m_CostFunction->GetCost(p1, p2); });
+  }
+  else
+  {
+    shortestPath.push_back(startPoint);
+    shortestPath.push_back(endPoint);
+  }
 
   // fill the output contour with control points from the path
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
@@ -433,4 +454,5 @@ void mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMapByITK(
 
   this->m_CostFunction->SetDynamicCostMap(histogram);
   this->m_CostFunction->SetCostMapMaximum(max);
+  m_ShortestPathTree.Invalidate();
 }
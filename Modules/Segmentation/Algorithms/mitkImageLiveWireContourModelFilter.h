@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include "mitkContourModel.h"
 #include "mitkContourModelSource.h"
+#include "mitkLiveWireShortestPathTree.h"
 #include <MitkSegmentationExports.h>
 
 #include <mitkImage.h>
@@ -39,6 +40,10 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   The shortest paths from the start point are kept in a LiveWireShortestPathTree. As long as the start point,
+   the cost map and the repulsive points do not change, an update for a new end point only expands this tree
+   as far as needed (or just traces the path back if the end point was already reached before).
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -108,7 +113,8 @@ namespace mitk
     /** \brief Create dynamic cost tranfer map - on the fly training*/
     bool CreateDynamicCostMap(mitk::ContourModel *path = nullptr);
 
-    void SetUseCostFunction(bool doUseCostFunction) { m_ShortestPathFilter->SetUseCostFunction(doUseCostFunction); };
+    void SetUseCostFunction(bool doUseCostFunction) { m_UseCostFunction = doUseCostFunction; };
+    bool GetUseCostFunction() const { return m_UseCostFunction; };
 
   protected:
     ImageLiveWireContourModelFilter();
@@ -136,12 +142,18 @@ namespace mitk
     /** \brief The cost function to compute costs between two pixels*/
     CostFunctionType::Pointer m_CostFunction;
 
-    /** \brief Shortest path filter according to cost function m_CostFunction*/
-    ShortestPathImageFilterType::Pointer m_ShortestPathFilter;
+    /** \brief Shortest paths from the start point according to cost function m_CostFunction*/
+    LiveWireShortestPathTree m_ShortestPathTree;
+
+    /** \brief Value of m_UseDynamicCostMap the shortest path tree was computed with*/
+    bool m_ShortestPathTreeUsesDynamicCostMap;
 
     /** \brief Flag to use a dynmic cost map or not*/
     bool m_UseDynamicCostMap;
 
+    /** \brief Flag to compute the path with the cost function. Otherwise the path is the straight connection of start and end point.*/
+    bool m_UseCostFunction;
+
     unsigned int m_TimeStep;
 
     template <typename TPixel, unsigned int VImageDimension>
@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLiveWireShortestPathTree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  /** Number of significant bits of value.*/
+  unsigned int BitLength(std::uint64_t value)
+  {
+    unsigned int length = 0;
+    for (unsigned int shift = 32; shift > 0; shift /= 2)
+    {
+      if (value >> shift)
+      {
+        length += shift;
+        value >>= shift;
+      }
+    }
+    return length + static_cast<unsigned int>(value);
+  }
+}
+
+mitk::LiveWireShortestPathTree::LiveWireShortestPathTree()
+  : m_Valid(false), m_NumberOfSettledNodes(0), m_LastKey(0), m_QueueSize(0)
+{
+  m_Seed.Fill(0);
+}
+
+void mitk::LiveWireShortestPathTree::Initialize(const RegionType &region, const IndexType &seed)
+{
+  this->Invalidate();
+
+  if (!region.IsInside(seed))
+    return;
+
+  const auto numberOfNodes = region.GetNumberOfPixels();
+  m_Region = region;
+  m_Seed = seed;
+  m_Distances.assign(numberOfNodes, std::numeric_limits<double>::infinity());
+  m_Predecessors.assign(numberOfNodes, 0);
+  m_States.assign(numberOfNodes, Unvisited);
+
+  const auto seedNode = static_cast<NodeType>(region.ComputeOffset(seed));
+  m_Distances[seedNode] = 0.0;
+  m_Predecessors[seedNode] = seedNode;
+  m_States[seedNode] = Queued;
+  this->Push(0.0, seedNode);
+
+  m_Valid = true;
+}
+
+void mitk::LiveWireShortestPathTree::Invalidate()
+{
+  m_Valid = false;
+  m_NumberOfSettledNodes = 0;
+
+  for (auto &bucket : m_Buckets)
+    bucket.clear();
+
+  m_LastKey = 0;
+  m_QueueSize = 0;
+}
+
+mitk::LiveWireShortestPathTree::PathType mitk::LiveWireShortestPathTree::GetPath(const IndexType &target,
+                                                                                   const CostFunctionType &costFunction)
+{
+  PathType path;
+
+  if (!m_Valid || !m_Region.IsInside(target))
+    return path;
+
+  const auto targetNode = static_cast<NodeType>(m_Region.ComputeOffset(target));
+  this->Expand(targetNode, costFunction);
+
+  if (m_States[targetNode] != Settled)
+    return path;
+
+  // go backwards from the target to the seed (the only node that is its own predecessor)
+  auto node = targetNode;
+  path.push_back(this->ToIndex(node));
+  while (m_Predecessors[node] != node)
+  {
+    node = m_Predecessors[node];
+    path.push_back(this->ToIndex(node));
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void mitk::LiveWireShortestPathTree::Expand(NodeType target, const CostFunctionType &costFunction)
+{
+  const auto sizeX = static_cast<NodeType>(m_Region.GetSize(0));
+  const auto numberOfNodes = static_cast<NodeType>(m_States.size());
+
+  while (m_States[target] != Settled && m_QueueSize > 0)
+  {
+    const auto entry = this->Pop();
+    const auto node = entry.Node;
+
+    // nodes are queued again when their distance decreases, older entries are skipped
+    if (m_States[node] == Settled || entry.Key != ToKey(m_Distances[node]))
+      continue;
+
+    m_States[node] = Settled;
+    ++m_NumberOfSettledNodes;
+
+    const auto index = this->ToIndex(node);
+    const auto x = node % sizeX;
+
+    // same order of the neighbors as itk::ShortestPathImageFilter: up, right, down, left
+    const bool hasNeighbor[4] = {node >= sizeX, x + 1 < sizeX, node + sizeX < numberOfNodes, x > 0};
+    const NodeType neighbors[4] = {node - sizeX, node + 1, node + sizeX, node - 1};
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      const auto neighbor = neighbors[i];
+
+      if (!hasNeighbor[i] || m_States[neighbor] == Settled)
+        continue;
+
+      double cost = costFunction(index, this->ToIndex(neighbor));
+
+      // Dijkstra needs non-negative costs. The live wire costs can get negative with a dynamic cost map
+      // or NaN in homogeneous regions (no gradient direction).
+      if (!(cost > 0.0))
+        cost = 0.0;
+
+      const double distance = m_Distances[node] + cost;
+      if (distance < m_Distances[neighbor])
+      {
+        m_Distances[neighbor] = distance;
+        m_Predecessors[neighbor] = node;
+        m_States[neighbor] = Queued;
+        this->Push(distance, neighbor);
+      }
+    }
+  }
+}
+
+void mitk::LiveWireShortestPathTree::Push(double distance, NodeType node)
+{
+  const auto key = ToKey(distance);
+  m_Buckets[this->GetBucket(key)].push_back({key, node});
+  ++m_QueueSize;
+}
+
+mitk::LiveWireShortestPathTree::QueueEntry mitk::LiveWireShortestPathTree::Pop()
+{
+  if (m_Buckets[0].empty())
+  {
+    // the smallest key is in the first non empty bucket. Make it the new reference, this
+    // distributes the other entries of the bucket over the lower buckets.
+    unsigned int i = 1;
+    while (m_Buckets[i].empty())
+      ++i;
+
+    auto &bucket = m_Buckets[i];
+    m_LastKey = std::min_element(bucket.begin(), bucket.end(), [](const QueueEntry &a, const QueueEntry &b) {
+                  return a.Key < b.Key;
+                })->Key;
+
+    for (const auto &entry : bucket)
+      m_Buckets[this->GetBucket(entry.Key)].push_back(entry);
+
+    bucket.clear();
+  }
+
+  const auto entry = m_Buckets[0].back();
+  m_Buckets[0].pop_back();
+  --m_QueueSize;
+  return entry;
+}
+
+unsigned int mitk::LiveWireShortestPathTree::GetBucket(std::uint64_t key) const
+{
+  return BitLength(key ^ m_LastKey);
+}
+
+std::uint64_t mitk::LiveWireShortestPathTree::ToKey(double distance)
+{
+  // for non-negative doubles the order of the bit patterns equals the order of the values
+  std::uint64_t key;
+  std::memcpy(&key, &distance, sizeof(key));
+  return key;
+}
+
+mitk::LiveWireShortestPathTree::IndexType mitk::LiveWireShortestPathTree::ToIndex(NodeType node) const
+{
+  const auto sizeX = static_cast<NodeType>(m_Region.GetSize(0));
+
+  IndexType index;
+  index[0] = m_Region.GetIndex(0) + static_cast<IndexType::IndexValueType>(node % sizeX);
+  index[1] = m_Region.GetIndex(1) + static_cast<IndexType::IndexValueType>(node / sizeX);
+  return index;
+}
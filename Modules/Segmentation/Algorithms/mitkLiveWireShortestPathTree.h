@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLiveWireShortestPathTree_h
+#define mitkLiveWireShortestPathTree_h
+
+#include <MitkSegmentationExports.h>
+
+#include <itkImageRegion.h>
+#include <itkIndex.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   \brief Single source shortest path tree on the pixel grid of a 2D image.
+
+   The tree holds the shortest paths from one seed to the pixels of a region (4-neighborhood, like
+   itk::ShortestPathImageFilter uses it for the live wire). It is computed with Dijkstra's algorithm, but only expanded
+   until the requested target is reached. The state of the search is kept, so further targets are either answered by a
+   backtrace through the tree or by continuing the search where it stopped.
+
+   The queue of the search is a monotone radix heap over the bit patterns of the (non-negative) path costs. It only
+   touches a few small buckets instead of the nodes of a balanced tree.
+
+   The tree does not know the costs itself. They are passed to GetPath() and have to stay the same until Initialize()
+   or Invalidate() is called.
+
+   \sa ImageLiveWireContourModelFilter
+  */
+  class MITKSEGMENTATION_EXPORT LiveWireShortestPathTree
+  {
+  public:
+    typedef itk::Index<2> IndexType;
+    typedef itk::ImageRegion<2> RegionType;
+    typedef std::vector<IndexType> PathType;
+    /** Costs to go from the first to the second (neighboring) index.*/
+    typedef std::function<double(const IndexType &, const IndexType &)> CostFunctionType;
+
+    LiveWireShortestPathTree();
+
+    /** \brief Discards the current tree and starts a new one for seed in region.*/
+    void Initialize(const RegionType &region, const IndexType &seed);
+
+    /** \brief Discards the current tree (e.g. because the costs changed).*/
+    void Invalidate();
+
+    bool IsValid() const { return m_Valid; }
+
+    const IndexType &GetSeed() const { return m_Seed; }
+
+    /** \brief Returns the shortest path from the seed to target (both included).
+    The tree is expanded with costFunction as far as needed. An empty path is returned if the tree
+    is not valid or the target is not inside the region.*/
+    PathType GetPath(const IndexType &target, const CostFunctionType &costFunction);
+
+    /** \brief Number of pixels whose shortest path is known.*/
+    std::size_t GetNumberOfSettledNodes() const { return m_NumberOfSettledNodes; }
+
+  private:
+    typedef std::uint32_t NodeType;
+
+    struct QueueEntry
+    {
+      std::uint64_t Key;
+      NodeType Node;
+    };
+
+    enum NodeState : unsigned char
+    {
+      Unvisited = 0,
+      Queued = 1,
+      Settled = 2
+    };
+
+    void Expand(NodeType target, const CostFunctionType &costFunction);
+
+    void Push(double distance, NodeType node);
+    QueueEntry Pop();
+    unsigned int GetBucket(std::uint64_t key) const;
+    static std::uint64_t ToKey(double distance);
+
+    IndexType ToIndex(NodeType node) const;
+
+    bool m_Valid;
+    RegionType m_Region;
+    IndexType m_Seed;
+
+    std::vector<double> m_Distances;
+    std::vector<NodeType> m_Predecessors;
+    std::vector<unsigned char> m_States;
+    std::size_t m_NumberOfSettledNodes;
+
+    /** Bucket i holds keys that differ from m_LastKey first in bit i-1 (bucket 0 holds m_LastKey).*/
+    std::array<std::vector<QueueEntry>, 65> m_Buckets;
+    std::uint64_t m_LastKey;
+    std::size_t m_QueueSize;
+  };
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkLiveWireShortestPathTree.h>
+#include <mitkTestFixture.h>
+
+#include <itkShortestPathCostFunctionLiveWire.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkShortestPathImageFilter.h>
+
+#include <cmath>
+#include <random>
+
+class mitkLiveWireShortestPathTreeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLiveWireShortestPathTreeTestSuite);
+  MITK_TEST(GetPath_EqualsShortestPathImageFilter);
+  MITK_TEST(GetPath_ReusedTree);
+  MITK_TEST(GetPath_InvalidTree);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<float, 2> ImageType;
+  typedef itk::ShortestPathCostFunctionLiveWire<ImageType> CostFunctionType;
+
+  ImageType::Pointer m_Image;
+  CostFunctionType::Pointer m_CostFunction;
+  mitk::LiveWireShortestPathTree::IndexType m_Seed;
+
+  mitk::LiveWireShortestPathTree::CostFunctionType GetCostFunction()
+  {
+    return [this](const itk::Index<2> &p1, const itk::Index<2> &p2) { return m_CostFunction->GetCost(p1, p2); };
+  }
+
+  double GetPathCosts(const mitk::LiveWireShortestPathTree::PathType &path)
+  {
+    double costs = 0.0;
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      costs += m_CostFunction->GetCost(path[i - 1], path[i]);
+    }
+    return costs;
+  }
+
+  void CheckPath(const mitk::LiveWireShortestPathTree::PathType &path, const itk::Index<2> &target)
+  {
+    CPPUNIT_ASSERT(!path.empty());
+    CPPUNIT_ASSERT_EQUAL(m_Seed, path.front());
+    CPPUNIT_ASSERT_EQUAL(target, path.back());
+
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(1), std::abs(path[i][0] - path[i - 1][0]) + std::abs(path[i][1] - path[i - 1][1]));
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    // smooth random gradients, so no pixel is in a completely homogeneous region
+    m_Image = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize(0, 64);
+    region.SetSize(1, 48);
+    m_Image->SetRegions(region);
+    m_Image->Allocate();
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> noise(0.0f, 10.0f);
+    for (itk::ImageRegionIteratorWithIndex<ImageType> iter(m_Image, region); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      iter.Set(100.0f * std::sin(0.2f * index[0]) * std::cos(0.15f * index[1]) + noise(generator));
+    }
+
+    m_CostFunction = CostFunctionType::New();
+    m_CostFunction->SetImage(m_Image);
+    m_Seed[0] = 5;
+    m_Seed[1] = 7;
+    m_CostFunction->SetStartIndex(m_Seed);
+    m_CostFunction->SetEndIndex(m_Seed);
+    m_CostFunction->Initialize();
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_CostFunction = nullptr;
+  }
+
+  void GetPath_EqualsShortestPathImageFilter()
+  {
+    itk::Index<2> target;
+    target[0] = 50;
+    target[1] = 40;
+
+    typedef itk::ShortestPathImageFilter<ImageType, ImageType> ShortestPathImageFilterType;
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetCostFunction(m_CostFunction);
+    filter->SetMakeOutputImage(false);
+    filter->SetStartIndex(m_Seed);
+    filter->SetEndIndex(target);
+    filter->Update();
+
+    mitk::LiveWireShortestPathTree tree;
+    tree.Initialize(m_Image->GetLargestPossibleRegion(), m_Seed);
+    const auto path = tree.GetPath(target, this->GetCostFunction());
+
+    this->CheckPath(path, target);
+    // paths with equal costs may differ, so only the costs are compared
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(this->GetPathCosts(filter->GetVectorPath()), this->GetPathCosts(path), 1e-6);
+  }
+
+  void GetPath_ReusedTree()
+  {
+    mitk::LiveWireShortestPathTree tree;
+    tree.Initialize(m_Image->GetLargestPossibleRegion(), m_Seed);
+
+    itk::Index<2> nearTarget;
+    nearTarget[0] = 12;
+    nearTarget[1] = 9;
+    itk::Index<2> farTarget;
+    farTarget[0] = 60;
+    farTarget[1] = 45;
+
+    const auto farPath = tree.GetPath(farTarget, this->GetCostFunction());
+    const auto settledNodes = tree.GetNumberOfSettledNodes();
+
+    // the near target is already part of the tree, so the tree must not grow
+    const auto nearPath = tree.GetPath(nearTarget, this->GetCostFunction());
+    CPPUNIT_ASSERT_EQUAL(settledNodes, tree.GetNumberOfSettledNodes());
+    this->CheckPath(nearPath, nearTarget);
+
+    mitk::LiveWireShortestPathTree newTree;
+    newTree.Initialize(m_Image->GetLargestPossibleRegion(), m_Seed);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      this->GetPathCosts(newTree.GetPath(nearTarget, this->GetCostFunction())), this->GetPathCosts(nearPath), 1e-6);
+    CPPUNIT_ASSERT(newTree.GetNumberOfSettledNodes() < settledNodes);
+
+    CPPUNIT_ASSERT(farPath == tree.GetPath(farTarget, this->GetCostFunction()));
+  }
+
+  void GetPath_InvalidTree()
+  {
+    itk::Index<2> target;
+    target[0] = 10;
+    target[1] = 10;
+
+    mitk::LiveWireShortestPathTree tree;
+    CPPUNIT_ASSERT(tree.GetPath(target, this->GetCostFunction()).empty());
+
+    tree.Initialize(m_Image->GetLargestPossibleRegion(), m_Seed);
+    CPPUNIT_ASSERT(tree.IsValid());
+
+    itk::Index<2> outside;
+    outside[0] = 64;
+    outside[1] = 10;
+    CPPUNIT_ASSERT(tree.GetPath(outside, this->GetCostFunction()).empty());
+
+    tree.Invalidate();
+    CPPUNIT_ASSERT(!tree.IsValid());
+    CPPUNIT_ASSERT(tree.GetPath(target, this->GetCostFunction()).empty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLiveWireShortestPathTree)
@@ -14,10 +14,18 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
+#include <itkMath.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,6 +34,8 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestCreateDistanceImageWithCompactlySupportedSolver);
+  MITK_TEST(TestCompactlySupportedSolverMatchesDenseSolver);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -33,6 +43,83 @@ private:
 
 public:
   void setUp() override {}
+
+  // Creates a circular contour in the plane z with outward pointing normals
+  mitk::Surface::Pointer CreateCircleContour(double z)
+  {
+    const int numberOfPoints = 36;
+    const double radius = 10.0;
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(numberOfPoints);
+
+    for (int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(30.0 + radius * std::cos(angle), 30.0 + radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0.0);
+      polys->InsertCellPoint(i);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+  /** Interpolates a tube of radius 10 around (30, 30) from circle contours at z = 20, 25 and 30.*/
+  mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::Pointer CreateTubeDistanceImage(
+    mitk::CreateDistanceImageFromSurfaceFilter::InterpolationSolver solver)
+  {
+    typedef itk::Image<unsigned char, 3> ReferenceImageType;
+    ReferenceImageType::RegionType region;
+    region.SetSize(0, 60);
+    region.SetSize(1, 60);
+    region.SetSize(2, 60);
+    ReferenceImageType::Pointer referenceImage = ReferenceImageType::New();
+    referenceImage->SetRegions(region);
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+    interpolateSurfaceFilter->SetReferenceImage(referenceImage.GetPointer());
+    interpolateSurfaceFilter->SetInterpolationSolver(solver);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      interpolateSurfaceFilter->SetInput(i, this->CreateCircleContour(20.0 + 5.0 * i));
+    }
+
+    interpolateSurfaceFilter->Update();
+
+    mitk::Image::Pointer distanceImage = interpolateSurfaceFilter->GetOutput();
+    CPPUNIT_ASSERT(distanceImage.IsNotNull());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::Pointer itkDistanceImage;
+    mitk::CastToItkImage(distanceImage, itkDistanceImage);
+    return itkDistanceImage;
+  }
+
+  static double GetDistance(const mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType *distanceImage,
+                            double x,
+                            double y,
+                            double z)
+  {
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::PointType point;
+    point[0] = x;
+    point[1] = y;
+    point[2] = z;
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::IndexType index;
+    CPPUNIT_ASSERT_MESSAGE("Test point is not inside of the distance image!",
+                           distanceImage->TransformPhysicalPointToIndex(point, index));
+    return distanceImage->GetPixel(index);
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
   void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result)
   {
@@ -128,6 +215,115 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestCreateDistanceImageWithCompactlySupportedSolver()
+  {
+    typedef itk::Image<unsigned char, 3> ReferenceImageType;
+    ReferenceImageType::RegionType region;
+    region.SetSize(0, 60);
+    region.SetSize(1, 60);
+    region.SetSize(2, 60);
+    ReferenceImageType::Pointer referenceImage = ReferenceImageType::New();
+    referenceImage->SetRegions(region);
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+    interpolateSurfaceFilter->SetReferenceImage(referenceImage.GetPointer());
+    interpolateSurfaceFilter->SetInterpolationSolver(
+      mitk::CreateDistanceImageFromSurfaceFilter::InterpolationSolver::CompactlySupported);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      interpolateSurfaceFilter->SetInput(i, this->CreateCircleContour(20.0 + 5.0 * i));
+    }
+
+    interpolateSurfaceFilter->Update();
+
+    mitk::Image::Pointer distanceImage = interpolateSurfaceFilter->GetOutput();
+    CPPUNIT_ASSERT(distanceImage.IsNotNull());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::Pointer itkDistanceImage;
+    mitk::CastToItkImage(distanceImage, itkDistanceImage);
+
+    auto getDistance = [&itkDistanceImage](double x, double y, double z) {
+      mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::PointType point;
+      point[0] = x;
+      point[1] = y;
+      point[2] = z;
+      mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::IndexType index;
+      itkDistanceImage->TransformPhysicalPointToIndex(point, index);
+      return itkDistanceImage->GetPixel(index);
+    };
+
+    CPPUNIT_ASSERT_MESSAGE("Center of the tube is not inside the interpolated surface!",
+                           getDistance(30.0, 30.0, 25.0) < 0);
+    CPPUNIT_ASSERT_MESSAGE("Point inside of the middle contour is not inside the interpolated surface!",
+                           getDistance(36.0, 30.0, 25.0) < 0);
+    CPPUNIT_ASSERT_MESSAGE("Point outside of the middle contour is not outside the interpolated surface!",
+                           getDistance(43.0, 30.0, 25.0) > 0);
+    CPPUNIT_ASSERT_MESSAGE("Point between the contours is not inside the interpolated surface!",
+                           getDistance(30.0, 36.0, 22.5) < 0);
+  }
+
+  void TestCompactlySupportedSolverMatchesDenseSolver()
+  {
+    auto denseImage = this->CreateTubeDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter::InterpolationSolver::Dense);
+    auto sparseImage =
+      this->CreateTubeDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter::InterpolationSolver::CompactlySupported);
+
+    // Points of the known tube: inside near the axis and close to the wall, outside close to the wall and in the
+    // corners of the image. Inside points away from the wall are not covered by any support of the sparse solution
+    // and only classified by the inside fill of the image, so they are checked as well.
+    const double insideRadii[] = {0.0, 4.0, 7.0};
+    const double heights[] = {21.0, 22.5, 25.0, 27.5, 29.0};
+
+    // the distance image only covers the contours and a small margin, so outside points are placed diagonally
+    const auto region = sparseImage->GetLargestPossibleRegion();
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::IndexType firstIndex = region.GetIndex();
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::IndexType lastIndex = region.GetUpperIndex();
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      ++firstIndex[dim];
+      --lastIndex[dim];
+    }
+    mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType::PointType firstCorner, lastCorner;
+    sparseImage->TransformIndexToPhysicalPoint(firstIndex, firstCorner);
+    sparseImage->TransformIndexToPhysicalPoint(lastIndex, lastCorner);
+
+    for (const auto z : heights)
+    {
+      for (int i = 0; i < 8; ++i)
+      {
+        const double angle = 2.0 * itk::Math::pi * i / 8;
+
+        for (const auto radius : insideRadii)
+        {
+          const double x = 30.0 + radius * std::cos(angle);
+          const double y = 30.0 + radius * std::sin(angle);
+          CPPUNIT_ASSERT_MESSAGE("Point inside of the tube is not inside the dense interpolation!",
+                                 GetDistance(denseImage, x, y, z) < 0);
+          CPPUNIT_ASSERT_MESSAGE("Point inside of the tube is not inside the sparse interpolation!",
+                                 GetDistance(sparseImage, x, y, z) < 0);
+        }
+      }
+
+      const double diagonal = 12.0 / std::sqrt(2.0);
+      const double outsidePoints[][2] = {{30.0 + diagonal, 30.0 + diagonal},
+                                         {30.0 - diagonal, 30.0 - diagonal},
+                                         {firstCorner[0], firstCorner[1]},
+                                         {lastCorner[0], firstCorner[1]},
+                                         {firstCorner[0], lastCorner[1]},
+                                         {lastCorner[0], lastCorner[1]}};
+
+      for (const auto &point : outsidePoints)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Point outside of the tube is not outside the dense interpolation!",
+                               GetDistance(denseImage, point[0], point[1], z) > 0);
+        CPPUNIT_ASSERT_MESSAGE("Point outside of the tube is not outside the sparse interpolation!",
+                               GetDistance(sparseImage, point[0], point[1], z) > 0);
+      }
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -20,9 +20,28 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
+#include "itkMultiThreaderBase.h"
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <set>
+
+namespace
+{
+  /** Wendland's C2 function for r = distance / support radius.*/
+  inline double WendlandFunction(double r)
+  {
+    if (r >= 1.0)
+      return 0.0;
+
+    const double t = 1.0 - r;
+    const double t2 = t * t;
+    return t2 * t2 * (4.0 * r + 1.0);
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,7 +124,11 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_InterpolationSolver(InterpolationSolver::Dense),
+    m_CompactSupportRadius(0.0),
+    m_UsedSupportRadius(0.0),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -130,7 +153,20 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_InterpolationSolver == InterpolationSolver::CompactlySupported)
+  {
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(m_SparseSolutionMatrix);
+    if (solver.info() != Eigen::Success)
+    {
+      itkExceptionMacro("Cannot factorize the sparse interpolation system. Number of centers: "
+                        << m_Centers.size() << "; support radius: " << m_UsedSupportRadius);
+    }
+    m_Weights = solver.solve(m_FunctionValues);
+  }
+  else
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -143,6 +179,10 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_CenterContours.clear();
+  m_CenterGrid.clear();
+  m_CenterCoordinates.resize(0, 3);
+  m_SparseSolutionMatrix.resize(0, 0);
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -168,6 +208,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  std::set<std::array<double, 3>> existingCenters;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -199,9 +241,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (existingCenters.insert({{p[0], p[1], p[2]}}).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -211,6 +251,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
           m_Normals.push_back(normal);
 
           m_Centers.push_back(currentPoint);
+          m_CenterContours.push_back(i);
         }
 
       } // end for all points
@@ -262,6 +303,12 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   }
 
   // Now we have created all centers and all function values. Next step is to create the solution matrix
+  if (m_InterpolationSolver == InterpolationSolver::CompactlySupported)
+  {
+    this->CreateSparseSolutionMatrix();
+    return;
+  }
+
   numberOfCenters = m_Centers.size();
 
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
@@ -292,17 +339,26 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   * Now we must calculate the distance for each pixel. But instead of calculating the distance value
   * for all of the image's pixels we proceed similar to the region growing algorithm:
   *
-  * 1. Take the first pixel from the narrowband_point_list and calculate the distance for each neighbor (6er)
-  * 2. If the current index's distance value is below a certain threshold push it into the list
-  * 3. Next iteration take the next index from the list and originAsIndex with 1. again
+  * 1. Take the pixels of the current front and calculate the distance for each unvisited neighbor (6er)
+  * 2. If the neighbor's distance value is below a certain threshold add it to the next front
+  * 3. Next iteration proceed with the next front and start with 1. again
   *
-  * This is done until the narrowband_point_list is empty.
+  * This is done until the front is empty.
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
+  typedef std::vector<DistanceImageType::IndexType> BandType;
+
+  // Store the centers column wise, so the dense distance function can be evaluated vectorized
+  const auto numberOfCenters = static_cast<Eigen::Index>(m_Centers.size());
+  m_CenterCoordinates.resize(numberOfCenters, 3);
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+  {
+    m_CenterCoordinates(i, 0) = m_Centers[i][0];
+    m_CenterCoordinates(i, 1) = m_Centers[i][1];
+    m_CenterCoordinates(i, 2) = m_Centers[i][2];
+  }
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
   double distance = this->CalculateDistanceValue(currentPoint);
 
@@ -319,47 +375,86 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   assert(
     m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // The narrow band is the 6-connected set of voxels with an absolute distance value of at most
+  // 2 * m_DistanceImageSpacing that contains the first center. It does not depend on the order in
+  // which the voxels are visited, so we grow it front by front and process each front in parallel.
+  // Every voxel is evaluated at most once: the first thread that reaches it claims it.
+  const DistanceImageType::RegionType region = m_DistanceImageITK->GetLargestPossibleRegion();
+  std::vector<std::atomic<unsigned char>> isVisited(region.GetNumberOfPixels());
+  isVisited[m_DistanceImageITK->ComputeOffset(currentIndex)] = 1;
 
-  bool isInBounds = false;
-  while (!narrowbandPoints.empty())
-  {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
+  auto processFront = [this, &region, &isVisited](const BandType &front, std::size_t begin, std::size_t end, BandType &nextFront) {
+    DistanceImageType::PointType pointAsPoint;
+    PointType point;
 
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+    for (std::size_t pos = begin; pos < end; ++pos)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
+        for (int step = -1; step <= 1; step += 2)
+        {
+          DistanceImageType::IndexType neighbor = front[pos];
+          neighbor[dim] += step;
+
+          if (!region.IsInside(neighbor) || isVisited[m_DistanceImageITK->ComputeOffset(neighbor)].exchange(1))
+            continue;
+
+          // Transform the currently checked point from index-coordinates to world-coordinates
+          m_DistanceImageITK->TransformIndexToPhysicalPoint(neighbor, pointAsPoint);
+          point[0] = pointAsPoint[0];
+          point[1] = pointAsPoint[1];
+          point[2] = pointAsPoint[2];
+
+          // and check the distance
+          const double neighborDistance = this->CalculateDistanceValue(point);
+          if (std::fabs(neighborDistance) <= m_DistanceImageSpacing * 2)
+          {
+            m_DistanceImageITK->SetPixel(neighbor, neighborDistance);
+            nextFront.push_back(neighbor);
+          }
+        }
+      }
+    }
+  };
 
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
+  auto multiThreader = itk::MultiThreaderBase::New();
+  const std::size_t numberOfChunks = 4 * multiThreader->GetNumberOfWorkUnits();
 
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
+  BandType front(1, currentIndex);
+  while (!front.empty())
+  {
+    BandType nextFront;
 
-        // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
-        {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
-        }
+    if (front.size() < 2 * numberOfChunks)
+    {
+      processFront(front, 0, front.size(), nextFront);
+    }
+    else
+    {
+      // Each chunk of the front collects its part of the next front, so no locking is needed
+      const std::size_t chunkSize = (front.size() + numberOfChunks - 1) / numberOfChunks;
+      std::vector<BandType> chunkFronts(numberOfChunks);
+
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfChunks,
+        [&](itk::SizeValueType chunk) {
+          const std::size_t begin = chunk * chunkSize;
+          const std::size_t end = std::min(begin + chunkSize, front.size());
+          if (begin < end)
+            processFront(front, begin, end, chunkFronts[chunk]);
+        },
+        nullptr);
+
+      for (const auto &chunkFront : chunkFronts)
+      {
+        nextFront.insert(nextFront.end(), chunkFront.begin(), chunkFront.end());
       }
-      relativeNb++;
     }
+
+    front.swap(nextFront);
   }
 
   ImageIterator imgRegionIterator(m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
@@ -419,25 +514,219 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateSparseSolutionMatrix()
+{
+  m_UsedSupportRadius = m_CompactSupportRadius > 0 ? m_CompactSupportRadius : this->DetermineCompactSupportRadius();
+
+  const auto numberOfCenters = static_cast<unsigned int>(m_Centers.size());
+
+  // Bin the centers into cells of the size of the support radius. So all centers that interact with
+  // a point lie in the cell of the point or in one of its 26 neighbors.
+  m_CenterGrid.clear();
+  std::int64_t cell[3];
+  for (unsigned int i = 0; i < numberOfCenters; i++)
+  {
+    this->GetGridCell(m_Centers[i], cell);
+    m_CenterGrid[GetGridCellKey(cell[0], cell[1], cell[2])].push_back(i);
+  }
+
+  std::vector<Eigen::Triplet<double>> entries;
+  entries.reserve(numberOfCenters * 32);
+
+  for (unsigned int i = 0; i < numberOfCenters; i++)
+  {
+    this->GetGridCell(m_Centers[i], cell);
+
+    for (std::int64_t x = cell[0] - 1; x <= cell[0] + 1; ++x)
+    {
+      for (std::int64_t y = cell[1] - 1; y <= cell[1] + 1; ++y)
+      {
+        for (std::int64_t z = cell[2] - 1; z <= cell[2] + 1; ++z)
+        {
+          auto finding = m_CenterGrid.find(GetGridCellKey(x, y, z));
+          if (finding == m_CenterGrid.end())
+            continue;
+
+          for (auto j : finding->second)
+          {
+            // Only the lower triangle is read by the LDLT decomposition
+            if (j > i)
+              continue;
+
+            const double value = WendlandFunction((m_Centers[i] - m_Centers[j]).two_norm() / m_UsedSupportRadius);
+            if (value > 0)
+            {
+              entries.emplace_back(i, j, value);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  m_SolutionMatrix.resize(0, 0);
+  m_SparseSolutionMatrix.resize(numberOfCenters, numberOfCenters);
+  m_SparseSolutionMatrix.setFromTriplets(entries.begin(), entries.end());
+  m_Weights.resize(numberOfCenters);
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::DetermineCompactSupportRadius() const
+{
+  // The support has to bridge the gaps between the contours. So we determine for each contour point the
+  // distance to the nearest point of an other contour and use a robust maximum of these distances.
+  const double minimalRadius = 4 * m_DistanceImageSpacing;
+  const auto numberOfContourPoints = static_cast<unsigned int>(m_CenterContours.size());
+
+  if (numberOfContourPoints == 0)
+    return minimalRadius;
+
+  PointType minPoint = m_Centers[0];
+  PointType maxPoint = m_Centers[0];
+  for (unsigned int i = 1; i < numberOfContourPoints; i++)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minPoint[dim] = std::min(minPoint[dim], m_Centers[i][dim]);
+      maxPoint[dim] = std::max(maxPoint[dim], m_Centers[i][dim]);
+    }
+  }
+
+  // The points lie on surfaces, so cells of this size contain only a few points
+  const double diagonal = (maxPoint - minPoint).two_norm();
+  const double cellSize = std::max(std::max(m_DistanceImageSpacing, diagonal / std::sqrt(numberOfContourPoints)),
+                                   std::numeric_limits<double>::epsilon());
+  const auto maxRing = static_cast<std::int64_t>(std::ceil(diagonal / cellSize)) + 1;
+
+  CenterGridType grid;
+  for (unsigned int i = 0; i < numberOfContourPoints; i++)
+  {
+    grid[GetGridCellKey(static_cast<std::int64_t>(std::floor(m_Centers[i][0] / cellSize)),
+                        static_cast<std::int64_t>(std::floor(m_Centers[i][1] / cellSize)),
+                        static_cast<std::int64_t>(std::floor(m_Centers[i][2] / cellSize)))]
+      .push_back(i);
+  }
+
+  std::vector<double> gaps;
+  gaps.reserve(numberOfContourPoints);
+
+  for (unsigned int i = 0; i < numberOfContourPoints; i++)
+  {
+    const std::int64_t cell[3] = {static_cast<std::int64_t>(std::floor(m_Centers[i][0] / cellSize)),
+                                  static_cast<std::int64_t>(std::floor(m_Centers[i][1] / cellSize)),
+                                  static_cast<std::int64_t>(std::floor(m_Centers[i][2] / cellSize))};
+
+    double nearest = std::numeric_limits<double>::max();
+
+    // Search the cells in growing shells around the point. Points in shell n+1 are at least n cells away.
+    for (std::int64_t ring = 0; ring <= maxRing && nearest > (ring - 1) * cellSize; ++ring)
+    {
+      for (std::int64_t x = -ring; x <= ring; ++x)
+      {
+        for (std::int64_t y = -ring; y <= ring; ++y)
+        {
+          for (std::int64_t z = -ring; z <= ring; ++z)
+          {
+            if (std::max(std::max(std::abs(x), std::abs(y)), std::abs(z)) != ring)
+              continue;
+
+            auto finding = grid.find(GetGridCellKey(cell[0] + x, cell[1] + y, cell[2] + z));
+            if (finding == grid.end())
+              continue;
+
+            for (auto j : finding->second)
+            {
+              if (m_CenterContours[j] != m_CenterContours[i])
+              {
+                nearest = std::min(nearest, (m_Centers[i] - m_Centers[j]).two_norm());
+              }
+            }
+          }
+        }
+      }
+    }
+
+    if (nearest < std::numeric_limits<double>::max())
+      gaps.push_back(nearest);
+  }
+
+  if (gaps.empty())
+    return minimalRadius;
+
+  auto percentile = gaps.begin() + (gaps.size() * 9) / 10;
+  std::nth_element(gaps.begin(), percentile, gaps.end());
+
+  return std::max(1.5 * (*percentile), minimalRadius);
+}
+
+std::size_t mitk::CreateDistanceImageFromSurfaceFilter::GridCellHash::operator()(const GridCellType &cell) const
+{
+  // Collisions only cost a comparison, the map compares the complete cell coordinates
+  const auto hash = static_cast<std::uint64_t>(cell[0]) * 73856093 ^ static_cast<std::uint64_t>(cell[1]) * 19349663 ^
+                    static_cast<std::uint64_t>(cell[2]) * 83492791;
+  return static_cast<std::size_t>(hash);
+}
+
+mitk::CreateDistanceImageFromSurfaceFilter::GridCellType mitk::CreateDistanceImageFromSurfaceFilter::GetGridCellKey(
+  std::int64_t x, std::int64_t y, std::int64_t z)
+{
+  return {{x, y, z}};
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::GetGridCell(const PointType &p, std::int64_t cell[3]) const
+{
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    cell[dim] = static_cast<std::int64_t>(std::floor(p[dim] / m_UsedSupportRadius));
+  }
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateSparseDistanceValue(const PointType &p) const
 {
   double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
+  bool isSupported(false);
 
-  CenterList::iterator centerIter;
+  std::int64_t cell[3];
+  this->GetGridCell(p, cell);
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  for (std::int64_t x = cell[0] - 1; x <= cell[0] + 1; ++x)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    for (std::int64_t y = cell[1] - 1; y <= cell[1] + 1; ++y)
+    {
+      for (std::int64_t z = cell[2] - 1; z <= cell[2] + 1; ++z)
+      {
+        auto finding = m_CenterGrid.find(GetGridCellKey(x, y, z));
+        if (finding == m_CenterGrid.end())
+          continue;
+
+        for (auto j : finding->second)
+        {
+          const double norm = (p - m_Centers[j]).two_norm();
+          if (norm < m_UsedSupportRadius)
+          {
+            distanceValue += WendlandFunction(norm / m_UsedSupportRadius) * m_Weights[j];
+            isSupported = true;
+          }
+        }
+      }
+    }
   }
-  return distanceValue;
+
+  // Points that are not covered by any support are far away from the surface
+  return isSupported ? distanceValue : m_DistanceImageDefaultBufferValue;
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p) const
+{
+  if (m_InterpolationSolver == InterpolationSolver::CompactlySupported)
+    return this->CalculateSparseDistanceValue(p);
+
+  // Sum of the weighted distances to all centers (Phi(r) = r). The expression is evaluated lazily
+  // by Eigen in SIMD packets without any temporary arrays.
+  const auto squaredDistances = (m_CenterCoordinates.col(0).array() - p[0]).square() +
+                                (m_CenterCoordinates.col(1).array() - p[1]).square() +
+                                (m_CenterCoordinates.col(2).array() - p[2]).square();
+
+  return (squaredDistances.sqrt() * m_Weights.array()).sum();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
@@ -539,6 +828,21 @@ void mitk::CreateDistanceImageFromSurfaceFilter::SetReferenceImage(itk::ImageBas
   m_ReferenceImage = referenceImage;
 }
 
+void mitk::CreateDistanceImageFromSurfaceFilter::SetInterpolationSolver(InterpolationSolver solver)
+{
+  if (m_InterpolationSolver != solver)
+  {
+    m_InterpolationSolver = solver;
+    this->Modified();
+  }
+}
+
+mitk::CreateDistanceImageFromSurfaceFilter::InterpolationSolver mitk::CreateDistanceImageFromSurfaceFilter::
+  GetInterpolationSolver() const
+{
+  return m_InterpolationSolver;
+}
+
 void mitk::CreateDistanceImageFromSurfaceFilter::DetermineBounds(
   DistanceImageType::PointType &minPointInWorldCoordinates,
   DistanceImageType::PointType &maxPointInWorldCoordinates,
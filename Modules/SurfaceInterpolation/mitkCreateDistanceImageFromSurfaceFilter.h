@@ -24,6 +24,11 @@ found in the LICENSE file.
 #include "itkImageBase.h"
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
 
 namespace mitk
 {
@@ -52,6 +57,11 @@ namespace mitk
          with the marching cubes algorithm. (Within the  distance image the surface goes exactly where the pixelvalues
   are zero)
 
+         By default the weights of the radial basis functions Phi(r) = r are computed with a dense solver, which needs
+         O(N^2) memory and O(N^3) time for N contour points. For large sets of contours the solver can be switched to
+         compactly supported radial basis functions (see SetInterpolationSolver()), which results in a sparse equation
+         system and scales about linearly with the number of contour points.
+
          Note that the obtained distance image has always an isotropig spacing. The size (in this case volume) of the
   image can be
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
@@ -74,6 +84,16 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    /** Solvers for the weights of the radial basis functions.*/
+    enum class InterpolationSolver
+    {
+      /** Phi(r) = r between all points, solved by a dense LU decomposition.*/
+      Dense,
+      /** Wendland's C2 function Phi(r) = (1 - r/R)^4 * (4r/R + 1) with support radius R, solved by a sparse
+       * Cholesky (LDLT) decomposition. Only points closer than R interact with each other.*/
+      CompactlySupported
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -120,6 +140,19 @@ namespace mitk
 
     void SetReferenceImage(itk::ImageBase<3>::Pointer referenceImage);
 
+    /** Set the solver used for the interpolation. Default is InterpolationSolver::Dense.*/
+    void SetInterpolationSolver(InterpolationSolver solver);
+    InterpolationSolver GetInterpolationSolver() const;
+
+    /**
+      \brief Set the support radius (in mm) of the compactly supported radial basis functions.
+
+      The radius must be large enough to bridge the gaps between neighboring contours. If it is 0 (default), it is
+      derived from the distances between the points of different contours.
+    */
+    itkSetMacro(CompactSupportRadius, double);
+    itkGetConstMacro(CompactSupportRadius, double);
+
   protected:
     CreateDistanceImageFromSurfaceFilter();
     ~CreateDistanceImageFromSurfaceFilter() override;
@@ -127,9 +160,33 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    /** Integer coordinates of a cell of m_CenterGrid. Used as key, so cells are compared exactly.*/
+    typedef std::array<std::int64_t, 3> GridCellType;
+
+    struct GridCellHash
+    {
+      std::size_t operator()(const GridCellType &cell) const;
+    };
+
+    typedef std::unordered_map<GridCellType, std::vector<unsigned int>, GridCellHash> CenterGridType;
+
     void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
 
+    /** Evaluates the interpolated distance function. Thread safe once the weights are computed.*/
+    double CalculateDistanceValue(const PointType &p) const;
+
+    /** Creates the sparse equation system for the compactly supported radial basis functions
+     * (replaces the dense solution matrix).*/
+    void CreateSparseSolutionMatrix();
+    double CalculateSparseDistanceValue(const PointType &p) const;
+    double DetermineCompactSupportRadius() const;
+
+    /** Key of the cell of m_CenterGrid with the given cell coordinates.*/
+    static GridCellType GetGridCellKey(std::int64_t x, std::int64_t y, std::int64_t z);
+    void GetGridCell(const PointType &p, std::int64_t cell[3]) const;
+
+    /** Evaluates the distance function in a narrow band around the surface (band by band, each in parallel) and
+     * marks the rest of the image as inside or outside.*/
     void FillDistanceImage();
 
     /**
@@ -159,9 +216,22 @@ namespace mitk
     NormalList m_Normals;
 
     Eigen::MatrixXd m_SolutionMatrix;
+    Eigen::SparseMatrix<double> m_SparseSolutionMatrix;
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    /** Coordinates of m_Centers (one column per dimension) for the vectorized evaluation of the dense solution.*/
+    Eigen::Matrix<double, Eigen::Dynamic, 3> m_CenterCoordinates;
+
+    /** Index of the input contour of each (on surface) center. Used to determine the support radius.*/
+    std::vector<unsigned int> m_CenterContours;
+
+    InterpolationSolver m_InterpolationSolver;
+    double m_CompactSupportRadius;
+    /** Support radius used by the current interpolation and the centers binned into cells of this size.*/
+    double m_UsedSupportRadius;
+    CenterGridType m_CenterGrid;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
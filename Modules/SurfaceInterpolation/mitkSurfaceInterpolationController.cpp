@@ -675,6 +675,19 @@ void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int d
   m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
 }
 
+void mitk::SurfaceInterpolationController::SetUseSparseInterpolation(bool useSparseInterpolation)
+{
+  m_InterpolateSurfaceFilter->SetInterpolationSolver(useSparseInterpolation
+    ? CreateDistanceImageFromSurfaceFilter::InterpolationSolver::CompactlySupported
+    : CreateDistanceImageFromSurfaceFilter::InterpolationSolver::Dense);
+}
+
+bool mitk::SurfaceInterpolationController::GetUseSparseInterpolation() const
+{
+  return m_InterpolateSurfaceFilter->GetInterpolationSolver() ==
+         CreateDistanceImageFromSurfaceFilter::InterpolationSolver::CompactlySupported;
+}
+
 mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentation()
 {
   return m_SelectedSegmentation;
@@ -689,6 +702,11 @@ double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
   double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
+  if (this->GetUseSparseInterpolation())
+  {
+    // The sparse system stores only the entries of neighboring points (assuming about 100 within the support)
+    sizeOfPoints = numberOfPointsAfterReduction * 100 * (sizeof(double) + sizeof(int));
+  }
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   double percentage = sizeOfPoints / totalMem;
   return percentage;
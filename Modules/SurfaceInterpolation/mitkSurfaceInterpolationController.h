@@ -175,7 +175,7 @@ namespace mitk
     unsigned int GetNumberOfContours();
 
     /**
-     * @brief Performs the interpolation.
+     * @brief Performs the interpolation with the solver selected by SetUseSparseInterpolation().
      *
      */
     void Interpolate();
@@ -208,6 +208,15 @@ namespace mitk
      */
     void SetDistanceImageVolume(unsigned int distImageVolume);
 
+    /**
+     * Selects the solver of the interpolation. If true, compactly supported radial basis functions and a sparse
+     * solver are used, whose memory and time consumption grow about linearly with the number of contour points.
+     * Otherwise (default) the dense solver is used, which needs quadratic memory and cubic time.
+     * \sa CreateDistanceImageFromSurfaceFilter::SetInterpolationSolver()
+     */
+    void SetUseSparseInterpolation(bool useSparseInterpolation);
+    bool GetUseSparseInterpolation() const;
+
     /**
      * @brief Get the current selected segmentation for which the interpolation is performed
      * @return the current segmentation image